@@ -0,0 +1,181 @@
+#include <NGenConfig.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Bmi_Adapter.hpp"
+#include "Bmi_C_Adapter.hpp"
+#include "Bmi_Cpp_Adapter.hpp"
+#include "Bmi_Fortran_Adapter.hpp"
+#include "Bmi_Py_Adapter.hpp"
+
+#if NGEN_WITH_PYTHON
+#include "utilities/python/InterpreterUtil.hpp"
+#endif
+
+/*
+ * The overhead of calling through each kind of BMI adapter, using the test modules in extern/.
+ *
+ * The test modules do next to no work, so these time the adapters, and for Python the interpreter,
+ * rather than the models.
+ */
+
+namespace {
+
+using adapter_factory = std::shared_ptr<models::bmi::Bmi_Adapter> (*)();
+
+const std::string test_data_dir = NGEN_BENCH_TEST_DATA_DIR;
+
+std::shared_ptr<models::bmi::Bmi_Adapter> make_cpp_adapter()
+{
+    auto adapter = std::make_shared<models::bmi::Bmi_Cpp_Adapter>(
+        "test_bmi_cpp", NGEN_BENCH_BMI_CPP_LIB, test_data_dir + "bmi/test_bmi_cpp/test_bmi_cpp_config_0.txt",
+        true, "bmi_model_create", "bmi_model_destroy"
+    );
+    adapter->Initialize();
+    return adapter;
+}
+
+#if NGEN_WITH_BMI_C
+std::shared_ptr<models::bmi::Bmi_Adapter> make_c_adapter()
+{
+    auto adapter = std::make_shared<models::bmi::Bmi_C_Adapter>(
+        "test_bmi_c", NGEN_BENCH_BMI_C_LIB, test_data_dir + "bmi/test_bmi_c/test_bmi_c_config_0.txt",
+        true, "register_bmi"
+    );
+    adapter->Initialize();
+    return adapter;
+}
+#endif
+
+#if NGEN_WITH_BMI_FORTRAN
+std::shared_ptr<models::bmi::Bmi_Adapter> make_fortran_adapter()
+{
+    auto adapter = std::make_shared<models::bmi::Bmi_Fortran_Adapter>(
+        "test_bmi_fortran", NGEN_BENCH_BMI_FORTRAN_LIB,
+        test_data_dir + "bmi/test_bmi_fortran/test_bmi_fortran_config_0.txt", true, "register_bmi"
+    );
+    adapter->Initialize();
+    return adapter;
+}
+#endif
+
+#if NGEN_WITH_PYTHON
+std::shared_ptr<models::bmi::Bmi_Adapter> make_py_adapter()
+{
+    // Keep the interpreter for the life of the suite, so it is only started once
+    static std::shared_ptr<utils::ngenPy::InterpreterUtil> interpreter = [] {
+        auto instance = utils::ngenPy::InterpreterUtil::getInstance();
+        utils::ngenPy::InterpreterUtil::addToPyPath(NGEN_BENCH_EXTERN_DIR);
+        return instance;
+    }();
+
+    auto adapter = std::make_shared<models::bmi::Bmi_Py_Adapter>(
+        "test_bmi_py.bmi_model", test_data_dir + "bmi/test_bmi_python/test_bmi_python_config_0.yml",
+        "test_bmi_py.bmi_model", true
+    );
+    adapter->Initialize();
+    return adapter;
+}
+#endif
+
+} // namespace
+
+/**
+ * A call with no arguments and a scalar result
+ */
+static void BM_Bmi_GetCurrentTime(benchmark::State& state, adapter_factory make_adapter)
+{
+    auto adapter = make_adapter();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(adapter->GetCurrentTime());
+    }
+}
+
+/**
+ * Setting a scalar input, as done for each input of each module every time step
+ */
+static void BM_Bmi_SetValue(benchmark::State& state, adapter_factory make_adapter)
+{
+    auto adapter = make_adapter();
+    double value = 1.0;
+    for (auto _ : state) {
+        adapter->SetValue("INPUT_VAR_1", &value);
+    }
+}
+
+/**
+ * Getting a scalar output, as done for each output of each module every time step
+ */
+static void BM_Bmi_GetValue(benchmark::State& state, adapter_factory make_adapter)
+{
+    auto adapter = make_adapter();
+    double value = 0.0;
+    for (auto _ : state) {
+        adapter->GetValue("OUTPUT_VAR_1", &value);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+/**
+ * Advancing the model one time step
+ */
+static void BM_Bmi_Update(benchmark::State& state, adapter_factory make_adapter)
+{
+    auto adapter = make_adapter();
+    double value = 1.0;
+    adapter->SetValue("INPUT_VAR_1", &value);
+    for (auto _ : state) {
+        adapter->Update();
+    }
+}
+
+/**
+ * Constructing and initializing one adapter per catchment, as done at startup
+ *
+ * Every adapter is kept until all of the catchments have one, as the formulations keep theirs for
+ * the run, so anything held per adapter, such as open files, adds up as it would in a real domain.
+ */
+static void BM_Bmi_construct(benchmark::State& state, adapter_factory make_adapter)
+{
+    std::vector<std::shared_ptr<models::bmi::Bmi_Adapter>> adapters;
+    adapters.reserve(state.range(0));
+    for (auto _ : state) {
+        for (long i = 0; i < state.range(0); i++) {
+            adapters.push_back(make_adapter());
+        }
+
+        state.PauseTiming();
+        adapters.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define NGEN_BENCH_BMI_ADAPTER(language, make_adapter)                  \
+    BENCHMARK_CAPTURE(BM_Bmi_GetCurrentTime, language, make_adapter);   \
+    BENCHMARK_CAPTURE(BM_Bmi_SetValue, language, make_adapter);         \
+    BENCHMARK_CAPTURE(BM_Bmi_GetValue, language, make_adapter);         \
+    BENCHMARK_CAPTURE(BM_Bmi_Update, language, make_adapter)
+
+// Up to 100 thousand catchments, the scale of a large domain
+#define NGEN_BENCH_BMI_CONSTRUCT(language, make_adapter)                \
+    BENCHMARK_CAPTURE(BM_Bmi_construct, language, make_adapter)         \
+        ->RangeMultiplier(10)->Range(1000, 100000)->Unit(benchmark::kMillisecond)
+
+NGEN_BENCH_BMI_ADAPTER(cpp, make_cpp_adapter);
+NGEN_BENCH_BMI_CONSTRUCT(cpp, make_cpp_adapter);
+#if NGEN_WITH_BMI_C
+NGEN_BENCH_BMI_ADAPTER(c, make_c_adapter);
+NGEN_BENCH_BMI_CONSTRUCT(c, make_c_adapter);
+#endif
+#if NGEN_WITH_BMI_FORTRAN
+NGEN_BENCH_BMI_ADAPTER(fortran, make_fortran_adapter);
+NGEN_BENCH_BMI_CONSTRUCT(fortran, make_fortran_adapter);
+#endif
+#if NGEN_WITH_PYTHON
+NGEN_BENCH_BMI_ADAPTER(python, make_py_adapter);
+#endif
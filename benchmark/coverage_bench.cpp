@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include "grid_coverage.hpp"
+
+// Coverage of a grid by a catchment-like polygon, with the scanline engine and with an
+// intersection per cell of the polygon's envelope, as was done before it.
+
+namespace {
+
+using point_t   = boost::geometry::model::d2::point_xy<double>;
+using polygon_t = boost::geometry::model::polygon<point_t>;
+using box_t     = boost::geometry::model::box<point_t>;
+
+/**
+ * A wavy ring of the given number of vertices and a radius of 40 cells, on a 1 km grid
+ */
+polygon_t catchment(std::size_t vertices)
+{
+    polygon_t polygon;
+    for (std::size_t i = 0; i < vertices; i++) {
+        const double angle = -2 * M_PI * i / vertices;
+        const double radius = 40000 * (1 + 0.2 * std::sin(7 * angle));
+        polygon.outer().push_back({ 50000 + radius * std::cos(angle), 50000 + radius * std::sin(angle) });
+    }
+    polygon.outer().push_back(polygon.outer().front());
+    return polygon;
+}
+
+const ngen::coverage_grid grid{ 0, 0, 1000, 1000, 100, 100 };
+
+} // namespace
+
+static void BM_coverage_scanline(benchmark::State& state)
+{
+    const polygon_t polygon = catchment(state.range(0));
+    ngen::grid_coverage coverage{grid};
+    std::vector<ngen::cell_coverage> cells;
+    for (auto _ : state) {
+        coverage.add_polygon(polygon);
+        coverage.compute(cells);
+        benchmark::DoNotOptimize(cells.data());
+    }
+    state.counters["cells"] = static_cast<double>(cells.size());
+}
+BENCHMARK(BM_coverage_scanline)->Arg(100)->Arg(1000)->Arg(10000);
+
+static void BM_coverage_intersection(benchmark::State& state)
+{
+    const polygon_t polygon = catchment(state.range(0));
+    const auto envelope = boost::geometry::return_envelope<box_t>(polygon);
+    boost::geometry::model::multi_polygon<polygon_t> overlap;
+    for (auto _ : state) {
+        std::size_t cells = 0;
+        for (double y = std::floor(envelope.min_corner().y() / grid.dy) * grid.dy; y < envelope.max_corner().y(); y += grid.dy) {
+            for (double x = std::floor(envelope.min_corner().x() / grid.dx) * grid.dx; x < envelope.max_corner().x(); x += grid.dx) {
+                overlap.clear();
+                boost::geometry::intersection(box_t{ { x, y }, { x + grid.dx, y + grid.dy } }, polygon, overlap);
+                cells += boost::geometry::area(overlap) > 0;
+            }
+        }
+        benchmark::DoNotOptimize(cells);
+    }
+}
+BENCHMARK(BM_coverage_intersection)->Arg(100)->Arg(1000);
@@ -0,0 +1,204 @@
+#include <NGenConfig.h>
+
+#include <benchmark/benchmark.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AorcForcing.hpp"
+#include "CsvPerFeatureForcingProvider.hpp"
+#include "DataProviderSelectors.hpp"
+#include "thread_pool.hpp"
+
+#if NGEN_WITH_NETCDF
+#include "NetCDFPerFeatureDataProvider.hpp"
+#include "StreamHandler.hpp"
+#endif
+
+namespace {
+
+const std::string forcing_start = "2015-12-01 00:00:00";
+const std::string forcing_end = "2015-12-30 23:00:00";
+// Hourly records in the example forcing files
+const long forcing_steps = 719;
+
+const std::string csv_forcing_path =
+    std::string(NGEN_BENCH_DATA_DIR) + "forcing/cat-27_2015-12-01 00_00_00_2015-12-30 23_00_00.csv";
+
+#if NGEN_WITH_NETCDF
+const std::string netcdf_forcing_path =
+    std::string(NGEN_BENCH_DATA_DIR) + "forcing/cats-27_52_67-2015_12_01-2015_12_30.nc";
+#endif
+
+} // namespace
+
+/**
+ * Read a catchment's whole forcing file, as done once per catchment during initialization
+ */
+static void BM_CsvPerFeature_load(benchmark::State& state)
+{
+    for (auto _ : state) {
+        CsvPerFeatureForcingProvider provider(forcing_params(csv_forcing_path, "CsvPerFeature", forcing_start, forcing_end));
+        benchmark::DoNotOptimize(provider);
+    }
+}
+BENCHMARK(BM_CsvPerFeature_load)->Unit(benchmark::kMillisecond);
+
+/**
+ * Read the first days of a catchment's forcing file, for a simulation shorter than the file
+ */
+static void BM_CsvPerFeature_load_days(benchmark::State& state)
+{
+    forcing_params params(csv_forcing_path, "CsvPerFeature", forcing_start, forcing_end);
+    params.simulation_end_t = params.simulation_start_t + state.range(0) * 86400 - 3600;
+    for (auto _ : state) {
+        CsvPerFeatureForcingProvider provider(params);
+        benchmark::DoNotOptimize(provider);
+    }
+}
+BENCHMARK(BM_CsvPerFeature_load_days)->Arg(1)->Arg(7)->Unit(benchmark::kMillisecond);
+
+/**
+ * Read 256 catchments' forcing files on a pool of threads, as formulations are constructed
+ */
+static void BM_CsvPerFeature_load_concurrent(benchmark::State& state)
+{
+    const int files = 256;
+    ngen::thread_pool pool(state.range(0));
+    const forcing_params params(csv_forcing_path, "CsvPerFeature", forcing_start, forcing_end);
+
+    for (auto _ : state) {
+        std::vector<std::future<std::shared_ptr<CsvPerFeatureForcingProvider>>> providers;
+        providers.reserve(files);
+        for (int i = 0; i < files; i++) {
+            providers.push_back(pool.submit([&params]() {
+                return std::make_shared<CsvPerFeatureForcingProvider>(params);
+            }));
+        }
+        for (auto& provider : providers) {
+            benchmark::DoNotOptimize(provider.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * files);
+}
+BENCHMARK(BM_CsvPerFeature_load_concurrent)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Read one variable for consecutive hourly time steps, as a formulation does through the time loop
+ */
+static void BM_CsvPerFeature_get_value(benchmark::State& state)
+{
+    forcing_params params(csv_forcing_path, "CsvPerFeature", forcing_start, forcing_end);
+    CsvPerFeatureForcingProvider provider(params);
+
+    long step = 0;
+    for (auto _ : state) {
+        const time_t t = params.simulation_start_t + (step % forcing_steps) * 3600;
+        benchmark::DoNotOptimize(provider.get_value(
+            CatchmentAggrDataSelector("", CSDMS_STD_NAME_LIQUID_EQ_PRECIP_RATE, t, 3600, ""),
+            data_access::SUM
+        ));
+        step++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CsvPerFeature_get_value);
+
+/**
+ * Read one variable for a time step that must be converted to other units
+ */
+static void BM_CsvPerFeature_get_value_converted(benchmark::State& state)
+{
+    forcing_params params(csv_forcing_path, "CsvPerFeature", forcing_start, forcing_end);
+    CsvPerFeatureForcingProvider provider(params);
+
+    long step = 0;
+    for (auto _ : state) {
+        const time_t t = params.simulation_start_t + (step % forcing_steps) * 3600;
+        benchmark::DoNotOptimize(provider.get_value(
+            CatchmentAggrDataSelector("", CSDMS_STD_NAME_SURFACE_TEMP, t, 3600, "degC"),
+            data_access::MEAN
+        ));
+        step++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CsvPerFeature_get_value_converted);
+
+#if NGEN_WITH_NETCDF
+/**
+ * Read one catchment's variable for consecutive hourly time steps from a shared NetCDF file
+ */
+static void BM_NetCDFPerFeature_get_value(benchmark::State& state)
+{
+    forcing_params params(netcdf_forcing_path, "NetCDF", forcing_start, forcing_end);
+    data_access::NetCDFPerFeatureDataProvider provider(
+        netcdf_forcing_path, params.simulation_start_t, params.simulation_end_t, utils::getStdErr()
+    );
+
+    long step = 0;
+    for (auto _ : state) {
+        const time_t t = params.simulation_start_t + (step % forcing_steps) * 3600;
+        benchmark::DoNotOptimize(provider.get_value(
+            CatchmentAggrDataSelector("cat-27", CSDMS_STD_NAME_SURFACE_TEMP, t, 3600, "K"),
+            data_access::MEAN
+        ));
+        step++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NetCDFPerFeature_get_value);
+
+/**
+ * Read every catchment in the file for the same time step, as the catchments of a layer do in turn
+ */
+static void BM_NetCDFPerFeature_get_value_all_ids(benchmark::State& state)
+{
+    forcing_params params(netcdf_forcing_path, "NetCDF", forcing_start, forcing_end);
+    data_access::NetCDFPerFeatureDataProvider provider(
+        netcdf_forcing_path, params.simulation_start_t, params.simulation_end_t, utils::getStdErr()
+    );
+    const auto ids = provider.get_ids();
+
+    long step = 0;
+    for (auto _ : state) {
+        const time_t t = params.simulation_start_t + (step % forcing_steps) * 3600;
+        for (const auto& id : ids) {
+            benchmark::DoNotOptimize(provider.get_value(
+                CatchmentAggrDataSelector(id, CSDMS_STD_NAME_SURFACE_TEMP, t, 3600, "K"),
+                data_access::MEAN
+            ));
+        }
+        step++;
+    }
+    state.SetItemsProcessed(state.iterations() * ids.size());
+}
+BENCHMARK(BM_NetCDFPerFeature_get_value_all_ids);
+
+/**
+ * Read every catchment in the file for the same time step, as one batch
+ */
+static void BM_NetCDFPerFeature_get_batch_values(benchmark::State& state)
+{
+    forcing_params params(netcdf_forcing_path, "NetCDF", forcing_start, forcing_end);
+    data_access::NetCDFPerFeatureDataProvider provider(
+        netcdf_forcing_path, params.simulation_start_t, params.simulation_end_t, utils::getStdErr()
+    );
+    const auto batch = provider.get_batch(provider.get_ids());
+    std::vector<double> values(batch.ids.size());
+
+    long step = 0;
+    for (auto _ : state) {
+        const time_t t = params.simulation_start_t + (step % forcing_steps) * 3600;
+        provider.get_batch_values(
+            batch, CatchmentAggrDataSelector("", CSDMS_STD_NAME_SURFACE_TEMP, t, 3600, "K"), values, data_access::MEAN
+        );
+        benchmark::DoNotOptimize(values.data());
+        step++;
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_NetCDFPerFeature_get_batch_values);
+#endif // NGEN_WITH_NETCDF
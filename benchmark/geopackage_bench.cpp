@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include "geopackage.hpp"
+
+namespace {
+
+/**
+ * The hydrofabric to read: the one named by NGEN_BENCH_GEOPACKAGE if set, so that a full-size
+ * fabric can be measured, or else the small example fabric in data/
+ */
+const std::string& fabric_path()
+{
+    static const std::string path = [] {
+        const char* configured = std::getenv("NGEN_BENCH_GEOPACKAGE");
+        return configured != nullptr
+            ? std::string(configured)
+            : std::string(NGEN_BENCH_DATA_DIR) + "gauge_01073000/gauge_01073000.gpkg";
+    }();
+    return path;
+}
+
+} // namespace
+
+/**
+ * Read a hydrofabric layer, with its geometry decoded and reprojected if with_geometry is set
+ */
+static void BM_GeoPackage_read(benchmark::State& state, const std::string& layer, bool with_geometry)
+{
+    long features = 0;
+    for (auto _ : state) {
+        try {
+            auto collection = ngen::geopackage::read(fabric_path(), layer, {}, with_geometry);
+            features = collection->get_size();
+            benchmark::DoNotOptimize(collection);
+        }
+        catch (const std::exception& e) {
+            state.SkipWithError(e.what());
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * features);
+}
+BENCHMARK_CAPTURE(BM_GeoPackage_read, divides, std::string("divides"), true)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_GeoPackage_read, divides_attributes, std::string("divides"), false)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_GeoPackage_read, nexus, std::string("nexus"), true)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_GeoPackage_read, nexus_attributes, std::string("nexus"), false)->Unit(benchmark::kMillisecond);
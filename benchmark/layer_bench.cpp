@@ -0,0 +1,175 @@
+#include <NGenConfig.h>
+
+// Layers run over HY_Features_MPI in MPI builds, which needs a partitioned, multi-process run
+#if !NGEN_WITH_MPI
+
+#include <benchmark/benchmark.h>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <FeatureCollection.hpp>
+#include <features/Features.hpp>
+#include <JSONProperty.hpp>
+
+#include "HY_Features.hpp"
+#include "Layer.hpp"
+#include "Simulation_Time.hpp"
+#include "StreamHandler.hpp"
+#include "realizations/catchment/Formulation_Manager.hpp"
+
+namespace {
+
+std::string link_key = "toid";
+
+// Hourly steps in the example forcing file
+const long simulation_steps = 719;
+
+/**
+ * A realization giving every catchment the test C++ BMI module, driven by the example CSV forcing
+ */
+std::string realization_config(const std::string& output_root)
+{
+    const std::string data_dir = NGEN_BENCH_DATA_DIR;
+    const std::string test_data_dir = NGEN_BENCH_TEST_DATA_DIR;
+
+    std::stringstream config;
+    config << R"({
+        "global": {
+            "formulations": [{
+                "name": "bmi_c++",
+                "params": {
+                    "model_type_name": "test_bmi_cpp",
+                    "library_file": ")" << NGEN_BENCH_BMI_CPP_LIB << R"(",
+                    "init_config": ")" << test_data_dir << R"(bmi/test_bmi_cpp/test_bmi_cpp_config_0.txt",
+                    "main_output_variable": "OUTPUT_VAR_2",
+                    "variables_names_map": {
+                        "INPUT_VAR_2": "TMP_2maboveground",
+                        "INPUT_VAR_1": "precip_rate"
+                    },
+                    "create_function": "bmi_model_create",
+                    "destroy_function": "bmi_model_destroy",
+                    "uses_forcing_file": false
+                }
+            }],
+            "forcing": {
+                "path": ")" << data_dir << R"(forcing/cat-27_2015-12-01 00_00_00_2015-12-30 23_00_00.csv",
+                "provider": "CsvPerFeature"
+            }
+        },
+        "time": {
+            "start_time": "2015-12-01 00:00:00",
+            "end_time": "2015-12-30 23:00:00",
+            "output_interval": 3600
+        },
+        "output_root": ")" << output_root << R"("
+    })";
+    return config.str();
+}
+
+/**
+ * A surface layer of catchments, with everything it refers to, ready to run from the first time step
+ *
+ * Catchment cat-i drains to nex-i, and nex-i drains to cat-(i/2), so the network is a binary tree
+ * with nex-1 as its outlet.
+ */
+struct layer_run
+{
+    explicit layer_run(long catchments, const std::string& output_root)
+      : catchment_collection(std::make_shared<geojson::FeatureCollection>())
+      , fabric(std::make_shared<geojson::FeatureCollection>())
+    {
+        for (long i = 1; i <= catchments; i++) {
+            const std::string id = std::to_string(i);
+
+            geojson::PropertyMap catchment_properties{
+                {link_key, geojson::JSONProperty(link_key, "nex-" + id)},
+                {"areasqkm", geojson::JSONProperty("areasqkm", 10.0)}
+            };
+            auto catchment = std::make_shared<geojson::PointFeature>(
+                geojson::PointFeature(geojson::coordinate_t(0.0, 0.0), "cat-" + id, catchment_properties)
+            );
+            catchment_collection->add_feature(catchment);
+            fabric->add_feature(catchment);
+
+            geojson::PropertyMap nexus_properties{};
+            if (i > 1) {
+                nexus_properties.emplace(link_key, geojson::JSONProperty(link_key, "cat-" + std::to_string(i / 2)));
+            }
+            fabric->add_feature(std::make_shared<geojson::PointFeature>(
+                geojson::PointFeature(geojson::coordinate_t(0.0, 0.0), "nex-" + id, nexus_properties)
+            ));
+        }
+
+        std::stringstream config(realization_config(output_root));
+        manager = std::make_shared<realization::Formulation_Manager>(config);
+        manager->read(catchment_collection, utils::getStdOut());
+
+        features = std::make_unique<hy_features::HY_Features>(fabric, &link_key, manager);
+
+        std::vector<std::string> ids;
+        for (const std::string& id : features->catchments(0)) {
+            ids.push_back(id);
+        }
+        Simulation_Time simulation_time(*manager->Simulation_Time_Object, 3600);
+        layer = std::make_unique<ngen::Layer>(
+            manager->get_layer_metadata().get_layer(0), ids, simulation_time, *features, catchment_collection, 0
+        );
+    }
+
+    geojson::GeoJSON                                   catchment_collection;
+    geojson::GeoJSON                                   fabric;
+    std::shared_ptr<realization::Formulation_Manager>  manager;
+    std::unique_ptr<hy_features::HY_Features>          features;
+    std::unique_ptr<ngen::Layer>                       layer;
+};
+
+} // namespace
+
+/**
+ * Run time steps of a layer of BMI catchments: their forcing reads, model updates, output writes,
+ * and nexus contributions.
+ *
+ * Each iteration is one time step of every catchment. The layer is rebuilt, untimed, whenever it
+ * reaches the end of the forcing.
+ */
+static void BM_Layer_update_models(benchmark::State& state)
+{
+    char output_template[] = "/tmp/ngen_bench_XXXXXX";
+    if (mkdtemp(output_template) == nullptr) {
+        state.SkipWithError("Could not create an output directory");
+        return;
+    }
+    const std::string output_root = std::string(output_template) + "/";
+
+    std::unique_ptr<layer_run> run;
+    long step = simulation_steps;
+    for (auto _ : state) {
+        if (step == simulation_steps) {
+            state.PauseTiming();
+            run.reset();
+            run = std::make_unique<layer_run>(state.range(0), output_root);
+            step = 0;
+            state.ResumeTiming();
+        }
+        run->layer->update_models();
+        step++;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    run.reset();
+    for (long i = 1; i <= state.range(0); i++) {
+        std::remove((output_root + "cat-" + std::to_string(i) + ".csv").c_str());
+    }
+    rmdir(output_root.c_str());
+}
+// Each catchment keeps its output file open, so stay well within the open file limit
+BENCHMARK(BM_Layer_update_models)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond);
+
+#endif // !NGEN_WITH_MPI
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <vector>
+
+#include "mdarray.hpp"
+
+// Each pair of benchmarks does the same work over a catchment by time array, first value by value
+// through the mdarray iterator or index, then in bulk through a view.
+
+namespace {
+
+ngen::mdarray<double> catchment_by_time(const benchmark::State& state)
+{
+    const std::size_t shape[] = { static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)) };
+    ngen::mdarray<double> values{shape};
+    std::iota(values.data().begin(), values.data().end(), 0.0);
+    return values;
+}
+
+void catchment_by_time_args(benchmark::internal::Benchmark* b)
+{
+    b->Args({ 100, 720 })->Args({ 1000, 720 })->Args({ 10000, 720 });
+}
+
+} // namespace
+
+static void BM_mdarray_sum_iterator(benchmark::State& state)
+{
+    const ngen::mdarray<double> values = catchment_by_time(state);
+    for (auto _ : state) {
+        double total = 0;
+        for (auto it = values.begin(); it != values.end(); ++it) {
+            total += *it;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_mdarray_sum_iterator)->Apply(catchment_by_time_args);
+
+static void BM_mdarray_sum_view(benchmark::State& state)
+{
+    const ngen::mdarray<double> values = catchment_by_time(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ngen::sum(values.view()));
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_mdarray_sum_view)->Apply(catchment_by_time_args);
+
+/**
+ * Total of each catchment over time
+ */
+static void BM_mdarray_sum_time_index(benchmark::State& state)
+{
+    const ngen::mdarray<double> values = catchment_by_time(state);
+    const std::size_t catchments = state.range(0), times = state.range(1);
+    for (auto _ : state) {
+        std::vector<double> totals(catchments);
+        for (std::size_t c = 0; c < catchments; c++) {
+            for (std::size_t t = 0; t < times; t++) {
+                totals[c] += values.at({{ c, t }});
+            }
+        }
+        benchmark::DoNotOptimize(totals.data());
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_mdarray_sum_time_index)->Apply(catchment_by_time_args);
+
+static void BM_mdarray_sum_time_view(benchmark::State& state)
+{
+    const ngen::mdarray<double> values = catchment_by_time(state);
+    for (auto _ : state) {
+        ngen::mdarray<double> totals = ngen::sum(values.view(), 1);
+        benchmark::DoNotOptimize(totals.data().data());
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_mdarray_sum_time_view)->Apply(catchment_by_time_args);
+
+/**
+ * Convert every value in place, as for a linear units conversion
+ */
+static void BM_mdarray_scale_offset_index(benchmark::State& state)
+{
+    ngen::mdarray<double> values = catchment_by_time(state);
+    const std::size_t catchments = state.range(0), times = state.range(1);
+    for (auto _ : state) {
+        for (std::size_t t = 0; t < times; t++) {
+            for (std::size_t c = 0; c < catchments; c++) {
+                const std::size_t index[] = { c, t };
+                values.insert(index, values.at(index) * 1.0000001 - 0.0000001);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_mdarray_scale_offset_index)->Apply(catchment_by_time_args);
+
+static void BM_mdarray_scale_offset_view(benchmark::State& state)
+{
+    ngen::mdarray<double> values = catchment_by_time(state);
+    for (auto _ : state) {
+        ngen::scale_offset(values.view(), 1.0000001, -0.0000001);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_mdarray_scale_offset_view)->Apply(catchment_by_time_args);
+
+/**
+ * Accumulate one time step of every catchment into a running total, as for output aggregation
+ */
+static void BM_mdarray_accumulate_step_index(benchmark::State& state)
+{
+    const ngen::mdarray<double> values = catchment_by_time(state);
+    const std::size_t catchments = state.range(0), times = state.range(1);
+    std::vector<double> totals(catchments);
+    std::size_t t = 0;
+    for (auto _ : state) {
+        for (std::size_t c = 0; c < catchments; c++) {
+            totals[c] += 0.5 * values.at({{ c, t }});
+        }
+        benchmark::DoNotOptimize(totals.data());
+        t = (t + 1) % times;
+    }
+    state.SetItemsProcessed(state.iterations() * catchments);
+}
+BENCHMARK(BM_mdarray_accumulate_step_index)->Apply(catchment_by_time_args);
+
+static void BM_mdarray_accumulate_step_view(benchmark::State& state)
+{
+    const ngen::mdarray<double> values = catchment_by_time(state);
+    const std::size_t catchments = state.range(0), times = state.range(1);
+    ngen::mdarray<double> totals{{ catchments }};
+    std::size_t t = 0;
+    for (auto _ : state) {
+        ngen::axpy(0.5, values.view().slice(1, t), totals.view());
+        benchmark::DoNotOptimize(totals.data().data());
+        t = (t + 1) % times;
+    }
+    state.SetItemsProcessed(state.iterations() * catchments);
+}
+BENCHMARK(BM_mdarray_accumulate_step_view)->Apply(catchment_by_time_args);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "mdframe/mdframe.hpp"
+
+namespace {
+
+//! Peak resident set size of this process so far, in bytes
+double peak_resident_set_size()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    // Linux reports kilobytes
+    return usage.ru_maxrss * 1024.0;
+}
+
+} // namespace
+
+/**
+ * Write a catchment by time frame of two per-catchment outputs to CSV, as for model output.
+ *
+ * Peak RSS is for the whole process, so is only meaningful for the largest frame run so far;
+ * use --benchmark_filter to run a single size when comparing it between builds.
+ */
+static void BM_mdframe_to_csv(benchmark::State& state)
+{
+    const std::size_t catchments = state.range(0);
+    const std::size_t times = state.range(1);
+
+    ngen::mdframe frame;
+    frame.add_dimension("catchment", catchments)
+         .add_dimension("time", times);
+    frame.add_variable<int>("catchment_id", { "catchment" })
+         .add_variable<int>("step", { "time" })
+         .add_variable<double>("flow", { "catchment", "time" })
+         .add_variable<double>("storage", { "catchment", "time" });
+
+    for (std::size_t c = 0; c < catchments; c++) {
+        frame["catchment_id"].insert({{ c }}, static_cast<int>(c));
+        for (std::size_t t = 0; t < times; t++) {
+            frame["flow"].insert({{ c, t }}, 0.001 * c + 1e-5 * t);
+            frame["storage"].insert({{ c, t }}, 100.0 - 0.5 * t / (c + 1));
+        }
+    }
+    for (std::size_t t = 0; t < times; t++) {
+        frame["step"].insert({{ t }}, static_cast<int>(t));
+    }
+
+    const std::string path = "/tmp/ngen_bench_mdframe_" + std::to_string(getpid()) + ".csv";
+    for (auto _ : state) {
+        frame.to_csv(path);
+    }
+
+    std::ifstream written(path, std::ios::binary | std::ios::ate);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(written.tellg()));
+    state.SetItemsProcessed(state.iterations() * catchments * times);
+    state.counters["peak_rss_bytes"] = peak_resident_set_size();
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_mdframe_to_csv)
+    ->Args({ 100, 720 })
+    ->Args({ 1000, 720 })
+    ->Args({ 1000, 8760 })
+    ->Unit(benchmark::kMillisecond);
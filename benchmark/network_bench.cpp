@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <FeatureCollection.hpp>
+#include <features/Features.hpp>
+#include <JSONProperty.hpp>
+
+#include "network.hpp"
+
+namespace {
+
+std::string link_key = "toid";
+
+/**
+ * Build a dendritic fabric with the given number of vertices, half catchments and half nexuses.
+ *
+ * Catchment cat-i drains to nex-i, and nex-i drains to cat-(i/2), so the network is a binary tree
+ * with nex-1 as its outlet. Features are points, as the network does not look at geometry.
+ *
+ * The last fabric built is kept, so that each size is only built once however many times the
+ * benchmarks using it are run.
+ */
+geojson::GeoJSON synthetic_fabric(long vertices, bool linked)
+{
+    static std::pair<long, bool> built_for{0, false};
+    static geojson::GeoJSON fabric;
+    if (fabric != nullptr && built_for == std::make_pair(vertices, linked)) {
+        return fabric;
+    }
+    fabric = nullptr;
+
+    auto features = std::make_shared<geojson::FeatureCollection>();
+    const long catchments = vertices / 2;
+    for (long i = 1; i <= catchments; i++) {
+        const std::string id = std::to_string(i);
+
+        geojson::PropertyMap catchment_properties{
+            {link_key, geojson::JSONProperty(link_key, "nex-" + id)}
+        };
+        features->add_feature(std::make_shared<geojson::PointFeature>(
+            geojson::PointFeature(geojson::coordinate_t(0.0, 0.0), "cat-" + id, catchment_properties)
+        ));
+
+        geojson::PropertyMap nexus_properties{};
+        if (i > 1) {
+            nexus_properties.emplace(link_key, geojson::JSONProperty(link_key, "cat-" + std::to_string(i / 2)));
+        }
+        features->add_feature(std::make_shared<geojson::PointFeature>(
+            geojson::PointFeature(geojson::coordinate_t(0.0, 0.0), "nex-" + id, nexus_properties)
+        ));
+    }
+    if (linked) {
+        features->link_features_from_property(nullptr, &link_key);
+    }
+
+    fabric = features;
+    built_for = std::make_pair(vertices, linked);
+    return fabric;
+}
+
+} // namespace
+
+/**
+ * Construct a network from a fabric whose features have already been linked, as ngen does
+ */
+static void BM_Network_construct_linked(benchmark::State& state)
+{
+    geojson::GeoJSON fabric = synthetic_fabric(state.range(0), true);
+    for (auto _ : state) {
+        network::Network network(fabric);
+        benchmark::DoNotOptimize(network);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Network_construct_linked)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Construct a network from unlinked features, following their link properties
+ */
+static void BM_Network_construct_from_property(benchmark::State& state)
+{
+    geojson::GeoJSON fabric = synthetic_fabric(state.range(0), false);
+    for (auto _ : state) {
+        network::Network network(fabric, &link_key);
+        benchmark::DoNotOptimize(network);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Network_construct_from_property)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Visit every catchment, then every nexus, in topological order
+ */
+static void BM_Network_filter(benchmark::State& state)
+{
+    network::Network network(synthetic_fabric(state.range(0), true));
+    for (auto _ : state) {
+        long visited = 0;
+        for (const auto& id : network.filter("cat")) {
+            benchmark::DoNotOptimize(id);
+            visited++;
+        }
+        for (const auto& id : network.filter("nex")) {
+            benchmark::DoNotOptimize(id);
+            visited++;
+        }
+        benchmark::DoNotOptimize(visited);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Network_filter)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "HY_PointHydroNexus.hpp"
+
+/**
+ * One time step at a nexus: each contributing catchment adds its flow, then the receiving catchment takes all of it
+ */
+static void BM_PointHydroNexus_add_get(benchmark::State& state)
+{
+    const long contributors = state.range(0);
+    HY_PointHydroNexus::Catchments contributing;
+    for (long i = 0; i < contributors; i++) {
+        contributing.push_back("cat-" + std::to_string(i + 1));
+    }
+    HY_PointHydroNexus nexus("nex-0", {"cat-0"}, contributing);
+
+    long t = 0;
+    for (auto _ : state) {
+        for (const auto& id : contributing) {
+            nexus.add_upstream_flow(1.0, id, t);
+        }
+        benchmark::DoNotOptimize(nexus.get_downstream_flow("cat-0", t, 100.0));
+        t++;
+    }
+    state.SetItemsProcessed(state.iterations() * contributors);
+}
+BENCHMARK(BM_PointHydroNexus_add_get)->Arg(1)->Arg(2)->Arg(8)->Arg(64);
+
+/**
+ * Flow added for many time steps ahead of it being taken, as when a nexus's outflow is read late
+ */
+static void BM_PointHydroNexus_backlog(benchmark::State& state)
+{
+    const long steps = state.range(0);
+    for (auto _ : state) {
+        HY_PointHydroNexus nexus("nex-0", {"cat-0"}, {"cat-1", "cat-2"});
+        for (long t = 0; t < steps; t++) {
+            nexus.add_upstream_flow(1.0, "cat-1", t);
+            nexus.add_upstream_flow(2.0, "cat-2", t);
+        }
+        for (long t = 0; t < steps; t++) {
+            benchmark::DoNotOptimize(nexus.get_downstream_flow("cat-0", t, 100.0));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * steps);
+}
+BENCHMARK(BM_PointHydroNexus_backlog)->Arg(24)->Arg(720);
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "UnitsHelper.hpp"
+
+/**
+ * Convert a single value, as done for each scalar forcing or model variable each time step
+ */
+static void BM_UnitsHelper_convert_value(benchmark::State& state, const std::string& in_units, const std::string& out_units)
+{
+    double value = 1.0;
+    for (auto _ : state) {
+        value = UnitsHelper::get_converted_value(in_units, value, out_units);
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_UnitsHelper_convert_value, same_units, std::string("m"), std::string("m"));
+BENCHMARK_CAPTURE(BM_UnitsHelper_convert_value, length, std::string("mm"), std::string("m"));
+BENCHMARK_CAPTURE(BM_UnitsHelper_convert_value, rate, std::string("mm/h"), std::string("m s^-1"));
+BENCHMARK_CAPTURE(BM_UnitsHelper_convert_value, temperature, std::string("degC"), std::string("K"));
+
+/**
+ * Convert an array of values, as done for gridded or multi-element variables
+ */
+static void BM_UnitsHelper_convert_values(benchmark::State& state)
+{
+    const std::size_t count = static_cast<std::size_t>(state.range(0));
+    std::vector<double> in(count, 1.0), out(count);
+    for (auto _ : state) {
+        UnitsHelper::convert_values("mm/h", in.data(), "m s^-1", out.data(), count);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UnitsHelper_convert_values)->RangeMultiplier(16)->Range(16, 65536);
@@ -795,8 +795,10 @@ int read_init_config(const char* config_file, test_bmi_c_model* model)
     for (size_t i = 0; i < config_line_count; i++) {
         char *param_key, *param_value;
         char *ret = fgets(config_line, max_config_line_length + 1, fp);
-        if (ret == NULL)
+        if (ret == NULL) {
+            fclose(fp);
             return BMI_FAILURE;
+        }
 
         char* config_line_ptr = config_line;
         config_line_ptr = strsep(&config_line_ptr, "\n");
@@ -825,6 +827,7 @@ int read_init_config(const char* config_file, test_bmi_c_model* model)
             continue;
         }
     }
+    fclose(fp);
 
     if (is_epoch_start_time_set == FALSE) {
         printf("Config param 'epoch_start_time' not found in config file\n");
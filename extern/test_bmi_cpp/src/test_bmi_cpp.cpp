@@ -397,8 +397,10 @@ void TestBmiCpp::read_init_config(std::string config_file)
   for (size_t i = 0; i < config_line_count; i++) {
     char *param_key, *param_value;
     char* ret = fgets(config_line.data(), max_config_line_length + 1, fp);
-    if (ret == nullptr)
+    if (ret == nullptr) {
+        fclose(fp);
         throw std::runtime_error("Error or EOF when reading '" + config_file + "'");
+    }
 
     char* config_line_ptr = config_line.data();
     config_line_ptr = strsep(&config_line_ptr, "\n");
@@ -436,6 +438,7 @@ void TestBmiCpp::read_init_config(std::string config_file)
       this->use_model_params = true;
     }
   }
+  fclose(fp);
 
   if (is_epoch_start_time_set == FALSE) {
     throw std::runtime_error("Config param 'epoch_start_time' not found in config file" SOURCE_LOC);
@@ -1,7 +1,10 @@
 #ifndef NGEN_ABSTRACTCLIBBMIADAPTER_HPP
 #define NGEN_ABSTRACTCLIBBMIADAPTER_HPP
 
+#include <memory>
+
 #include "Bmi_Adapter.hpp"
+#include "SharedLibrary.hpp"
 
 namespace models {
     namespace bmi {
@@ -98,7 +101,7 @@ namespace models {
             }
 
             inline const void *get_dyn_lib_handle() {
-                return dyn_lib_handle;
+                return dyn_lib == nullptr ? nullptr : dyn_lib->get_handle();
             }
 
         private:
@@ -107,8 +110,8 @@ namespace models {
             std::string bmi_lib_file;
             /** Name of the function that registers BMI struct's function pointers to the right module functions. */
             const std::string bmi_registration_function;
-            /** Handle for dynamically loaded library file. */
-            void *dyn_lib_handle = nullptr;
+            /** Dynamically loaded library file, shared with other adapters for the same library. */
+            std::shared_ptr<SharedLibrary> dyn_lib = nullptr;
 
             /**
              * A non-virtual equivalent for the virtual @see Finalize.
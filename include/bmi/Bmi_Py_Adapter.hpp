@@ -46,7 +46,11 @@ namespace models {
             Bmi_Py_Adapter(Bmi_Py_Adapter&&) = delete;
 
             ~Bmi_Py_Adapter() override {
+                // Python objects are released here too, since the GIL may not be held on destruction
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 Finalize();
+                bmi_model.reset();
+                np = py::object();
             }
 
             /**
@@ -60,6 +64,7 @@ namespace models {
             template <typename T>
             void copy_to_array(const std::string& name, T *dest)
             {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 py::array_t<T> backing_array = bmi_model->attr("get_value_ptr")(name);
                 auto uncheck_proxy = backing_array.template unchecked<1>();
                 for (ssize_t i = 0; i < backing_array.size(); ++i) {
@@ -77,6 +82,7 @@ namespace models {
             template <typename T>
             std::vector<T> copy_to_vector(const std::string& name)
             {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 py::array_t<T> backing_array = bmi_model->attr("get_value_ptr")(name);
                 std::vector<T> dest(backing_array.size());
                 auto uncheck_proxy = backing_array.template unchecked<1>();
@@ -87,6 +93,7 @@ namespace models {
             }
 
             void Finalize() override {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 bmi_model->attr("finalize")();
             }
 
@@ -105,6 +112,7 @@ namespace models {
             std::vector<std::string> GetOutputVarNames() override;
 
             int GetGridEdgeCount(const int grid) override {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 return py::int_(bmi_model->attr("get_grid_edge_count")(grid));
             }
 
@@ -116,6 +124,7 @@ namespace models {
             }
 
             int GetGridFaceCount(const int grid) override {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 return py::int_(bmi_model->attr("get_grid_face_count")(grid));
             }
 
@@ -132,6 +141,7 @@ namespace models {
             }
 
             int GetGridNodeCount(const int grid) override {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 return py::int_(bmi_model->attr("get_grid_node_count")(grid));
             }
 
@@ -145,6 +155,7 @@ namespace models {
             }
 
             int GetGridRank(const int grid) override {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 return py::int_(bmi_model->attr("get_grid_rank")(grid));
             }
 
@@ -153,6 +164,7 @@ namespace models {
             }
 
             int GetGridSize(const int grid) override {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 return py::int_(bmi_model->attr("get_grid_size")(grid));
             }
 
@@ -161,6 +173,7 @@ namespace models {
             }
 
             std::string GetGridType(const int grid) override {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 return py::str(bmi_model->attr("get_grid_type")(grid));
             }
 
@@ -353,6 +366,7 @@ namespace models {
             void get_and_copy_grid_array(const char* grid_func_name, const int grid, T* dest, int dest_length,
                                          const char* np_dtype)
             {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 //This is required here because grid info can be a non dimensional `np.zeros( () )`
                 py::array_t<T> np_array;
                 if( dest_length == 0 ){
@@ -426,6 +440,7 @@ namespace models {
              *                       which there is not support for mapping to a native type in the framework.
              */
             void get_value_at_indices(const std::string& name, void *dest, int *inds, int count, bool is_all_indices) {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 std::string val_type = GetVarType(name);
                 size_t val_item_size = (size_t)GetVarItemsize(name);
                 std::vector<std::string> in_v = GetInputVarNames();
@@ -559,6 +574,7 @@ namespace models {
              */
             template <typename T>
             void set_value(const std::string &name, std::vector<T> src) {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 int nbytes = GetVarNbytes(name);
                 int itemSize = GetVarItemsize(name);
                 int length = nbytes / itemSize;
@@ -618,6 +634,7 @@ namespace models {
             void set_value_at_indices(const std::string &name, const int *inds, int count, void* cxx_array,
                                       const std::string &np_type)
             {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 py::array_t<int> index_array(py::buffer_info(inds, count));
                 py::array_t<T> src_array(py::buffer_info((T*)cxx_array, count));
                 bmi_model->attr("set_value_at_indices")(name, index_array, src_array);
@@ -662,6 +679,7 @@ namespace models {
             inline void construct_and_init_backing_model_for_py_adapter() {
                 if (model_initialized)
                     return;
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 try {
                     separate_package_and_simple_name();
                     std::vector<std::string> moduleComponents = {*bmi_type_py_module_name, *bmi_type_py_class_name};
@@ -768,6 +786,7 @@ namespace models {
              */
             template <typename T>
             void set_value(const std::string &name, T *src) {
+                utils::ngenPy::ConcurrentGilAcquire gil;
                 // Because all BMI arrays are flattened, we can just use the size/length in the buffer info
                 int length = GetVarNbytes(name) / GetVarItemsize(name);
                 py::array_t<T> src_array(py::buffer_info(src, length));
@@ -0,0 +1,95 @@
+#ifndef NGEN_SHAREDLIBRARY_HPP
+#define NGEN_SHAREDLIBRARY_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace models {
+    namespace bmi {
+
+        /**
+         * A dynamically loaded shared library, shared by every BMI adapter that uses it.
+         *
+         * Each catchment formulation backed by a C, Fortran, or C++ BMI module has its own adapter, but all of
+         * the adapters for a module use the same library. Rather than each adapter opening the library and
+         * looking up its symbols, the library is opened once, when the first adapter asks for it, and symbol
+         * addresses are looked up once and cached. The library is closed when the last adapter holding it is
+         * destroyed.
+         *
+         * Libraries are registered under the path they were requested by, so that later requests can skip
+         * resolving the path to a file. All functions are safe to call from several threads at once.
+         */
+        class SharedLibrary {
+
+        public:
+
+            /**
+             * Get the library loaded for a path, if any adapter is currently holding it.
+             *
+             * @param path The path the library was requested by.
+             * @return The library, or ``nullptr`` if it is not loaded.
+             */
+            static std::shared_ptr<SharedLibrary> find(const std::string &path);
+
+            /**
+             * Get the library for a path, loading it if it is not already loaded.
+             *
+             * @param path The path the library is requested by, under which it is registered.
+             * @param file The resolved path of the library file to load.
+             * @param error Set to the reason the library could not be loaded, if it could not be.
+             * @return The library, or ``nullptr`` if it could not be loaded.
+             */
+            static std::shared_ptr<SharedLibrary> open(const std::string &path, const std::string &file,
+                                                       std::string &error);
+
+            SharedLibrary(const SharedLibrary&) = delete;
+            SharedLibrary& operator=(const SharedLibrary&) = delete;
+
+            /**
+             * Close the library.
+             */
+            ~SharedLibrary();
+
+            /**
+             * Get the address of a symbol in the library.
+             *
+             * @param symbol_name The name of the symbol.
+             * @param error Set to the reason the symbol could not be found, if it was not, or cleared.
+             * @return The address of the symbol, which may be ``nullptr`` if the symbol could not be found or the
+             *         symbol's address is actually null.
+             */
+            void *symbol(const std::string &symbol_name, std::string &error);
+
+            /**
+             * @return The path of the loaded library file.
+             */
+            const std::string &get_file() const {
+                return file;
+            }
+
+            /**
+             * @return The handle to the library from ``dlopen``.
+             */
+            void *get_handle() const {
+                return handle;
+            }
+
+        private:
+
+            SharedLibrary(std::string file, void *handle) : file(std::move(file)), handle(handle) {}
+
+            /** Path of the loaded library file. */
+            const std::string file;
+            /** Handle for the dynamically loaded library file. */
+            void *const handle;
+            /** Addresses of the symbols found so far, by name. */
+            std::unordered_map<std::string, void *> symbols;
+            std::mutex symbols_mutex;
+        };
+
+    }
+}
+
+#endif //NGEN_SHAREDLIBRARY_HPP
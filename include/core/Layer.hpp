@@ -6,6 +6,8 @@
 #include "LayerData.hpp"
 #include "Simulation_Time.hpp"
 #include "State_Exception.hpp"
+#include "catchment_profile.hpp"
+#include "trace_recorder.hpp"
 
 #if NGEN_WITH_MPI
 #include "HY_Features_MPI.hpp"
@@ -37,7 +39,8 @@ namespace ngen
             processing_units(p_u),
             simulation_time(s_t),
             features(f),
-            catchment_data(cd),
+            catchment_areas(read_catchment_areas(p_u, cd)),
+            profile_rows(resolve_profile_rows(p_u)),
             output_time_index(idx)
         {
 
@@ -109,8 +112,10 @@ namespace ngen
             //std::cout<<"Output Time Index: "<<output_time_index<<std::endl;
             if(output_time_index%100 == 0) std::cout<<"Running timestep " << output_time_index <<std::endl;
             std::string current_timestamp = simulation_time.get_timestamp(output_time_index);
-            for(const auto& id : processing_units) 
+            trace::scoped_event batch_event("layer", "catchments", processing_units.size());
+            for(std::size_t unit = 0; unit < processing_units.size(); ++unit)
             {
+                const std::string& id = processing_units[unit];
                 int sub_time = output_time_index;
                 //std::cout<<"Running cat "<<id<<std::endl;
                 auto r = features.catchment_at(id);
@@ -118,6 +123,7 @@ namespace ngen
                 auto r_c = std::dynamic_pointer_cast<realization::Catchment_Formulation>(r);
                 double response(0.0);
                 try{
+                    NGEN_PROFILE_CATCHMENT(profile_rows[unit], profiling::catchment_profile::response);
                     response = r_c->get_response(output_time_index, simulation_time.get_output_interval_seconds());
                 }
                 catch(models::external::State_Exception& e){
@@ -127,18 +133,14 @@ namespace ngen
                              +" at feature id "+id;
                     throw models::external::State_Exception(msg);
                 }
-                std::string output = std::to_string(output_time_index)+","+current_timestamp+","+
-                                    r_c->get_output_line_for_timestep(output_time_index)+"\n";
-                r_c->write_output(output);
-                //TODO put this somewhere else.  For now, just trying to ensure we get m^3/s into nexus output
-                double area;
-                try{
-                    area = catchment_data->get_feature(id)->get_property("areasqkm").as_real_number();
-                }
-                catch(std::invalid_argument &e)
                 {
-                    area = catchment_data->get_feature(id)->get_property("area_sqkm").as_real_number();
+                    NGEN_PROFILE_CATCHMENT(profile_rows[unit], profiling::catchment_profile::write_output);
+                    std::string output = std::to_string(output_time_index)+","+current_timestamp+","+
+                                        r_c->get_output_line_for_timestep(output_time_index)+"\n";
+                    r_c->write_output(output);
                 }
+                //TODO put this somewhere else.  For now, just trying to ensure we get m^3/s into nexus output
+                double area = catchment_areas[unit];
                 double response_m_s = response * (area * 1000000);
                 //TODO put this somewhere else as well, for now, an implicit assumption is that a module's get_response returns
                 //m/timestep
@@ -171,6 +173,57 @@ namespace ngen
 
         protected:
 
+        /**
+         * @brief Look up the area of each processing unit in the hydrofabric
+         *
+         * The areas are copied out so the hydrofabric collection does not have to be kept for the whole run.
+         *
+         * @param ids The processing unit (catchment) ids
+         * @param catchment_data The hydrofabric catchment collection
+         * @return The area, in square kilometers, of each id in order
+         */
+        static std::vector<double> read_catchment_areas(const std::vector<std::string>& ids, const geojson::GeoJSON& catchment_data)
+        {
+            std::vector<double> areas;
+            areas.reserve(ids.size());
+            for(const auto& id : ids)
+            {
+                auto feature = catchment_data->get_feature(id);
+                if(feature == nullptr){
+                    throw std::runtime_error("Catchment "+id+" is not in the hydrofabric. "+SOURCE_LOC);
+                }
+                try{
+                    areas.push_back(feature->get_property("areasqkm").as_real_number());
+                }
+                catch(std::invalid_argument &e)
+                {
+                    areas.push_back(feature->get_property("area_sqkm").as_real_number());
+                }
+            }
+            return areas;
+        }
+
+        /**
+         * @brief Resolve the catchment profile row of each processing unit, when profiling
+         *
+         * @param ids The processing unit (catchment) ids
+         * @return The row of each id in order, or nothing when not profiling
+         */
+        static std::vector<std::size_t> resolve_profile_rows(const std::vector<std::string>& ids)
+        {
+            std::vector<std::size_t> rows;
+        #if NGEN_WITH_PROFILING
+            rows.reserve(ids.size());
+            for(const auto& id : ids)
+            {
+                rows.push_back(profiling::catchment_profile::instance().row(id));
+            }
+        #else
+            (void)ids;
+        #endif
+            return rows;
+        }
+
         const LayerDescription description;
         //TODO is this really required at the top level?
         //See "minimum" constructor above used for DomainLayer impl...
@@ -178,7 +231,10 @@ namespace ngen
         Simulation_Time simulation_time;
         feature_type& features;
         //TODO is this really required at the top level? or can this be moved to SurfaceLayer?
-        const geojson::GeoJSON catchment_data;
+        //Area of each processing unit, in the same order as processing_units
+        const std::vector<double> catchment_areas;
+        //Catchment profile row of each processing unit, in the same order as processing_units
+        const std::vector<std::size_t> profile_rows;
         long output_time_index;       
 
     };
@@ -38,6 +38,8 @@ struct forcing_params
   std::string end_time;
   std::string date_format =  "%Y-%m-%d %H:%M:%S";
   std::string provider;
+  std::string geometry_path; // catchment polygons, for providers that aggregate gridded data
+  bool lookahead = false; // generate the next time step's forcings while models run, for the Forcings Engine
   time_t simulation_start_t;
   time_t simulation_end_t;
   /*
@@ -0,0 +1,73 @@
+#ifndef NGEN_CSVFORCINGCONVERTER_HPP
+#define NGEN_CSVFORCINGCONVERTER_HPP
+
+#include <NGenConfig.h>
+
+#if NGEN_WITH_NETCDF
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace data_access {
+
+/**
+ * How a directory of CSV forcing files is converted to NetCDF
+ */
+struct CsvForcingConversion
+{
+    //! Number of threads parsing CSV files; if 0, uses the hardware concurrency
+    std::size_t threads = 0;
+
+    //! Regular expression matching forcing file names, with `{{id}}` in place of the feature id
+    std::string pattern = "{{id}}(_.*)?\\.csv";
+
+    //! Store values as double rather than float
+    bool double_precision = false;
+
+    //! Shuffle and deflate level, from 1 to 9, or 0 to leave variables uncompressed
+    int deflate_level = 0;
+
+    //! Number of catchments per chunk of each variable; if 0, as many as are converted at once
+    std::size_t chunk_catchments = 0;
+};
+
+/**
+ * What a CSV forcing conversion wrote
+ */
+struct CsvForcingConversionSummary
+{
+    std::size_t catchments = 0;
+    std::size_t variables = 0;
+    std::size_t steps = 0;
+};
+
+/**
+ * Convert a directory of per-feature CSV forcing files into a single NetCDF file.
+ *
+ * The file is in the layout @ref NetCDFPerFeatureDataProvider reads: `ids`, a catchment by time
+ * `Time` variable in seconds since the epoch, and one catchment by time variable per CSV column,
+ * with units from the header or the well-known field defaults. Every file must have the same
+ * columns and times as the first, by name.
+ *
+ * Files are parsed on a thread pool, one block of catchments ahead of the block being written,
+ * and the conversion stops at the first file that cannot be read.
+ *
+ * @param csv_directory Directory of the CSV forcing files
+ * @param output_path Path of the NetCDF file to write, which is replaced if it exists
+ * @param options How the files are found, read and stored
+ * @param progress Receives a line as each block of catchments is written
+ * @return The number of catchments, variables and time steps written
+ * @throws std::runtime_error If no files match, or a file cannot be read or differs from the first
+ */
+CsvForcingConversionSummary convert_csv_forcing(
+    const std::string& csv_directory,
+    const std::string& output_path,
+    const CsvForcingConversion& options,
+    std::ostream& progress
+);
+
+} // namespace data_access
+
+#endif // NGEN_WITH_NETCDF
+#endif // NGEN_CSVFORCINGCONVERTER_HPP
@@ -0,0 +1,71 @@
+#ifndef NGEN_CSVFORCINGREADER_HPP
+#define NGEN_CSVFORCINGREADER_HPP
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace data_access {
+
+/**
+ * The columns of a per-feature CSV forcing file, for the rows within a simulation window.
+ */
+struct CsvForcingTable
+{
+    //! Every cell of the header row, untrimmed, in file order
+    std::vector<std::string> header;
+
+    //! Index of the time column within @ref header
+    std::size_t time_column = 0;
+
+    //! Epoch time of each row kept
+    std::vector<time_t> times;
+
+    //! Values of each column for the rows kept, parallel to @ref header; the time column's is empty
+    std::vector<std::vector<double>> columns;
+
+    //! Number of data rows read, whether or not they were kept
+    std::size_t rows_read = 0;
+
+    //! Epoch times of the first and last data rows read, if any were
+    time_t first_time = 0;
+    time_t last_time = 0;
+};
+
+/**
+ * Split the header of a CSV forcing column into a variable name and units.
+ *
+ * Units may follow the name in brackets or parentheses, as in `T2D [K]` or `U2D(m s-1)`;
+ * otherwise they are left empty. Surrounding whitespace is removed from the name.
+ *
+ * @param header A header cell
+ * @param name Receives the variable name
+ * @param units Receives the units, or an empty string
+ */
+void parse_csv_forcing_column(const std::string& header, std::string& name, std::string& units);
+
+/**
+ * Read the rows of a CSV forcing file that fall within a simulation window.
+ *
+ * The file is memory mapped and parsed in place, straight into one vector per
+ * column, without splitting it into strings first. Rows are expected in time
+ * order: rows before @p start_time are passed over after reading only their
+ * time, and reading stops at the first row after @p end_time. The time column
+ * is the last one headed `time` or `Time`, or else the first column, and its
+ * values are in `%Y-%m-%d %H:%M:%S` form, in UTC.
+ *
+ * Nothing is shared between calls, so many files may be read concurrently,
+ * as formulations are constructed on a thread pool.
+ *
+ * @param path Path of the CSV file
+ * @param start_time Epoch time of the first row to keep
+ * @param end_time Epoch time of the last row to keep
+ * @return The header, and the times and values of the rows kept
+ * @throws std::runtime_error If the file cannot be read, is empty, or has a value that is not a
+ *                            number or a row with more cells than the header, within the window
+ */
+CsvForcingTable read_csv_forcing(const std::string& path, time_t start_time, time_t end_time);
+
+} // namespace data_access
+
+#endif // NGEN_CSVFORCINGREADER_HPP
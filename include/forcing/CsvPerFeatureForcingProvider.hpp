@@ -10,8 +10,7 @@
 #include <iostream>
 #include <unordered_map>
 #include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
-#include "CSV_Reader.h"
+#include "CsvForcingReader.hpp"
 #include <ctime>
 #include <time.h>
 #include <memory>
@@ -176,6 +175,31 @@ class CsvPerFeatureForcingProvider : public data_access::GenericDataProvider
         return std::vector<double>(1, get_value(selector, m));
     }
 
+    /**
+     * Get the value of a forcing property for an arbitrary time period, for each catchment of a batch, converting
+     * units if needed.
+     *
+     * The forcing is that of a single catchment, whatever the selector's id, as with @ref get_value, so the value is
+     * found and converted once, and given for each catchment of the batch.
+     *
+     * @param batch Catchments from @ref get_batch of this provider.
+     * @param selector The variable, time period, and output units of the values.
+     * @param values Where to write the value of each catchment of the batch, in its order.
+     * @param m methode to resample data if needed
+     * @throws std::invalid_argument If the size of @p values is not that of the batch.
+     * @throws std::out_of_range If data for the time period is not available.
+     */
+    void get_batch_values(const data_access::CatchmentBatch& batch, const CatchmentAggrDataSelector& selector, boost::span<double> values, data_access::ReSampleMethod m) override
+    {
+        if (values.size() != batch.ids.size()) {
+            throw std::invalid_argument("Got " + std::to_string(values.size()) + " values to write for a batch of "
+                                        + std::to_string(batch.ids.size()) + " catchments");
+        }
+        if (!values.empty()) {
+            std::fill(values.begin(), values.end(), get_value(selector, m));
+        }
+    }
+
 
     /**
      * Get whether a param's value is an aggregate sum over the entire time step.
@@ -286,108 +310,52 @@ class CsvPerFeatureForcingProvider : public data_access::GenericDataProvider
      */
     void read_csv(std::string file_name)
     {
-        int time_col_index = 0;
-        //std::map<std::string, int> col_indices;
-        std::vector<std::vector<double>*> local_valvec_index = {};
-
-        //Call CSVReader constuctor
-        CSVReader reader(file_name);
-
-        //Get the data from CSV File
-        std::vector<std::vector<std::string> > data_list = reader.getData();
+        data_access::CsvForcingTable table = data_access::read_csv_forcing(file_name, start_date_time_epoch, end_date_time_epoch);
 
         // Process the header (first) row..
-        int col_num = 0;
-        for (const auto& col_head : data_list[0]){
-            //std::cerr << s << std::endl;
+        for (std::size_t col_num = 0; col_num < table.header.size(); col_num++){
+            const auto& col_head = table.header[col_num];
             if(col_head == "Time" || col_head == "time"){
-                time_col_index = col_num;
-                local_valvec_index.push_back(nullptr); // make sure the column indices line up!
-            } else {
-                std::string var_name = col_head;
-                std::string units = "";
-
-                boost::trim(var_name); // remove leading/trailing ws
-                const auto var_name_close = var_name.back();
-                if (var_name_close == ']' || var_name_close == ')') {
-                    // found closing bracket/parenth
-
-                    const bool is_bracket = var_name_close == ']';
-                    const size_t var_name_open = is_bracket ? var_name.rfind('[') : var_name.rfind('(');
-                    if (var_name_open != std::string::npos) {
-                        // found matching opening bracket/parenth
-
-                        units = var_name.substr(var_name_open + 1);
-                        units.pop_back(); // remove closing bracket
-
-                        var_name = var_name.substr(0, var_name_open);
-                        boost::trim(var_name); // trim again in case of ws between name and units
-                    }
-                }
-
-                auto wkf = data_access::WellKnownFields.find(var_name);
-                if(wkf != data_access::WellKnownFields.end()){
-                    units = units.empty() ? std::get<1>(wkf->second) : units;
-                    available_forcings.push_back(var_name); // Allow lookup by non-canonical name
-                    available_forcings_units[var_name] = units; // Allow lookup of units by non-canonical name
-                    var_name = std::get<0>(wkf->second); // Use the CSDMS name from here on
-                }
-
-                forcing_vectors[var_name] = {};
-                local_valvec_index.push_back(&(forcing_vectors[var_name]));
-                available_forcings.push_back(var_name);
-                available_forcings_units[var_name] = units;
+                continue;
             }
-            col_num++;
-        }
 
-        time_t current_row_date_time_epoch;
-        //Iterate through CSV starting on the second row
-        int i = 1;
-        for (i = 1; i < data_list.size(); i++)
-        {
-            //Row vector
-            std::vector<std::string>& vec = data_list[i];
-
-            struct tm current_row_date_time_utc = tm();
-            std::string time_str = vec[time_col_index];
-            //TODO: Support more time string formats? This is basically ISO8601 but not complete, support TZ?
-            strptime(time_str.c_str(), "%Y-%m-%d %H:%M:%S", &current_row_date_time_utc);
-
-            //Convert current row date-time UTC to epoch time
-            current_row_date_time_epoch = timegm(&current_row_date_time_utc);
-
-            //TODO: I am not sure this is a concern of this object. If forcing is retrieved that doesn't cover the
-            //needed time period, isn't that the requester's concern? (Methods exist to check this...)
-            //Ensure that forcing data covers the entire model period. Otherwise, throw an error.
-            if (i == 1 && start_date_time_epoch < current_row_date_time_epoch)
-            {
-                struct tm start_date_tm;
-                gmtime_r(&start_date_time_epoch, &start_date_tm);
-                
-                char tm_buff[128];
-                strftime(tm_buff, 128, "%Y-%m-%d %H:%M:%S", &start_date_tm);
-                throw std::runtime_error("Error: Forcing data " + file_name + " begins after the model start time:" + std::string(tm_buff) + " < " + time_str);
-            }
+            std::string var_name;
+            std::string units;
+            data_access::parse_csv_forcing_column(col_head, var_name, units);
 
-            
-            if (start_date_time_epoch <= current_row_date_time_epoch && current_row_date_time_epoch <= end_date_time_epoch)
-            {
-                time_epoch_vector.push_back(current_row_date_time_epoch);
+            auto wkf = data_access::WellKnownFields.find(var_name);
+            if(wkf != data_access::WellKnownFields.end()){
+                units = units.empty() ? std::get<1>(wkf->second) : units;
+                available_forcings.push_back(var_name); // Allow lookup by non-canonical name
+                available_forcings_units[var_name] = units; // Allow lookup of units by non-canonical name
+                var_name = std::get<0>(wkf->second); // Use the CSDMS name from here on
+            }
 
-                int c = -1;
-                for (auto& s : vec){
-                    c++;
-                    if(c == time_col_index)
-                        continue;
-                    boost::algorithm::trim(s);
-                    local_valvec_index[c]->push_back(boost::lexical_cast<double>(s)); // This is supposed to update the vector in the map...
-                }
+            forcing_vectors[var_name] = std::move(table.columns[col_num]);
+            available_forcings.push_back(var_name);
+            available_forcings_units[var_name] = units;
+        }
 
-            }
+        time_epoch_vector = std::move(table.times);
 
+        //TODO: I am not sure this is a concern of this object. If forcing is retrieved that doesn't cover the
+        //needed time period, isn't that the requester's concern? (Methods exist to check this...)
+        //Ensure that forcing data covers the entire model period. Otherwise, throw an error.
+        if (table.rows_read > 0 && start_date_time_epoch < table.first_time)
+        {
+            struct tm start_date_tm;
+            gmtime_r(&start_date_time_epoch, &start_date_tm);
+            struct tm first_row_tm;
+            gmtime_r(&table.first_time, &first_row_tm);
+
+            char tm_buff[128];
+            strftime(tm_buff, 128, "%Y-%m-%d %H:%M:%S", &start_date_tm);
+            char first_row_buff[128];
+            strftime(first_row_buff, 128, "%Y-%m-%d %H:%M:%S", &first_row_tm);
+            throw std::runtime_error("Error: Forcing data " + file_name + " begins after the model start time:" + std::string(tm_buff) + " < " + std::string(first_row_buff));
         }
-        if (i <= 1 || current_row_date_time_epoch < end_date_time_epoch)
+
+        if (table.rows_read == 0 || table.last_time < end_date_time_epoch)
         {
             /// \todo TODO: Return appropriate error
             std::cout << "WARNING: Forcing data ends before the model end time." << std::endl;
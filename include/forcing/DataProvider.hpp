@@ -1,7 +1,11 @@
 #ifndef NGEN_DATAPROVIDER_HPP
 #define NGEN_DATAPROVIDER_HPP
 
+#include <cstddef>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <boost/core/span.hpp>
 
@@ -21,6 +25,29 @@ namespace data_access
             BACK_FILL
     };
 
+    /**
+     * Catchments for which data is accessed together, with @ref DataProvider::get_batch_values.
+     *
+     * A batch is made by the provider it is used with, with @ref DataProvider::get_batch, which may resolve the id
+     * of each catchment to its position in the provider's data once, rather than on every access.
+     */
+    struct CatchmentBatch
+    {
+        std::vector<std::string> ids;       //!< Ids of the catchments, in the order their values are given
+        std::vector<std::size_t> positions; //!< Provider-specific position of each catchment, if resolved
+    };
+
+    namespace detail
+    {
+        //! Whether a selector can be pointed at another catchment, with `set_id`
+        template <class Selector, class = void>
+        struct has_set_id : std::false_type {};
+
+        template <class Selector>
+        struct has_set_id<Selector, decltype(std::declval<Selector&>().set_id(std::declval<const std::string&>()), void())>
+            : std::true_type {};
+    }
+
     template <class DataType, class SelectionType> class DataProvider
     {
         /** This class provides a generic interface to data services
@@ -96,9 +123,65 @@ namespace data_access
          */
         virtual std::vector<data_type> get_values(const selection_type& selector, ReSampleMethod m=SUM) = 0;
 
+        /**
+         * Make a batch of catchments, to get values for together with @ref get_batch_values.
+         *
+         * The batch may only be used with this provider. By default, ids are not resolved, and the values of a batch
+         * are each got with @ref get_value.
+         *
+         * @param ids The ids of the catchments, in the order their values are to be given.
+         * @return The batch of catchments.
+         * @throws std::out_of_range If the provider resolves ids, and it has no data for one of them.
+         */
+        virtual CatchmentBatch get_batch(std::vector<std::string> ids) const
+        {
+            return CatchmentBatch{std::move(ids), {}};
+        }
+
+        /**
+         * Get the value of a forcing property for an arbitrary time period, for each catchment of a batch, converting
+         * units if needed.
+         *
+         * Each value is that of @ref get_value for the selector with its id set to that of the catchment; the id of
+         * the selector itself is not used. Providers should override this to share the work of the time period, the
+         * variable, and the unit conversion among the catchments. By default, this is only supported for selectors
+         * with a `set_id`.
+         *
+         * @param batch Catchments from @ref get_batch of this provider.
+         * @param selector The variable, time period, and output units of the values.
+         * @param values Where to write the value of each catchment of the batch, in its order.
+         * @param m How data is to be resampled if there is a mismatch in data alignment or repeat rate
+         * @throws std::invalid_argument If the size of @p values is not that of the batch.
+         * @throws std::out_of_range If data for the time period is not available.
+         * @throws std::logic_error If not overridden, and the selector has no `set_id`.
+         */
+        virtual void get_batch_values(const CatchmentBatch& batch, const selection_type& selector, boost::span<data_type> values, ReSampleMethod m=SUM)
+        {
+            if (values.size() != batch.ids.size()) {
+                throw std::invalid_argument("Got " + std::to_string(values.size()) + " values to write for a batch of "
+                                            + std::to_string(batch.ids.size()) + " catchments");
+            }
+
+            get_each_value(batch, selector, values, m, detail::has_set_id<selection_type>{});
+        }
+
         virtual bool is_property_sum_over_time_step(const std::string& name) const {return false; }
 
         private:
+
+        void get_each_value(const CatchmentBatch& batch, const selection_type& selector, boost::span<data_type> values, ReSampleMethod m, std::true_type)
+        {
+            selection_type each = selector;
+            for (std::size_t i = 0; i < batch.ids.size(); ++i) {
+                each.set_id(batch.ids[i]);
+                values[i] = get_value(each, m);
+            }
+        }
+
+        void get_each_value(const CatchmentBatch&, const selection_type&, boost::span<data_type>, ReSampleMethod, std::false_type)
+        {
+            throw std::logic_error("This data provider does not support getting values for a batch of catchments");
+        }
     };
 
 }
@@ -6,9 +6,14 @@
 
 #include <cmath>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -40,6 +45,111 @@ time_t parse_time(const std::string& time, const std::string& fmt = default_time
 //! then this function throws.
 void assert_forcings_engine_requirements();
 
+//! Copies of the outputs of a Forcings Engine instance after each of its latest time steps.
+//!
+//! Providers sharing an instance read their values from these copies, so the instance is
+//! advanced, and its outputs are read through Python, once per time step for all of them.
+//!
+//! With look-ahead enabled, once a time step is copied, the instance is advanced to the next
+//! one on a dedicated thread, so that generating forcings overlaps with the models' use of the
+//! current ones. That thread needs the GIL to call the instance, so it only makes progress while
+//! the reading thread gives the GIL up: while it waits for the time step, and in any scope where
+//! it releases the GIL itself with a @ref utils::ngenPy::GilRelease, as the time loop does around
+//! the layer updates of runs with no Python models. While the thread runs, it is counted in
+//! @ref utils::ngenPy::concurrentPythonThreads, so that @ref models::bmi::Bmi_Py_Adapter takes
+//! the GIL on each call.
+//!
+//! All calls into the instance are made on one thread at a time: other code calling the
+//! instance on the reading thread must first @ref settle the snapshots. Look-ahead must be
+//! disabled, e.g. by clearing @ref ForcingsEngineStorage, before the interpreter is finalized.
+struct ForcingsEngineSnapshots {
+    //! BMI adapter type used by the Python-based Forcings Engine.
+    using bmi_type = models::bmi::Bmi_Py_Adapter;
+
+    //! @param bmi Forcings Engine instance.
+    //! @param variables Output variables to copy, each an array of doubles.
+    ForcingsEngineSnapshots(std::shared_ptr<bmi_type> bmi, std::vector<std::string> variables);
+
+    ForcingsEngineSnapshots(const ForcingsEngineSnapshots&) = delete;
+    ForcingsEngineSnapshots& operator=(const ForcingsEngineSnapshots&) = delete;
+
+    ~ForcingsEngineSnapshots();
+
+    //! Get the values of a variable after a time step, advancing the instance to it if needed.
+    //! @param step Number of time steps since the start of the instance's time.
+    //! @param variable Index of the variable in those given on construction.
+    //! @throws std::out_of_range If the step is before the earliest time step kept.
+    boost::span<const double> values(std::size_t step, std::size_t variable);
+
+    //! Get the index of an output variable in those given on construction.
+    //! @throws std::out_of_range If the variable is not copied.
+    std::size_t variable_index(const std::string& name) const;
+
+    //! Keep at least the given number of the latest time steps.
+    void reserve(std::size_t steps);
+
+    //! Wait for the time step being advanced to on the look-ahead thread, if any, and keep it,
+    //! so that the instance can be called on this thread until values are next requested.
+    void settle();
+
+    //! Whether the time step being advanced to on the look-ahead thread is done, without waiting for it.
+    bool ahead_ready();
+
+    //! Advance the instance one time step ahead of the latest requested, on a dedicated thread.
+    //! @param last_step The last time step of the instance, which is never advanced past.
+    void enable_lookahead(std::size_t last_step);
+
+    //! Stop advancing the instance ahead, keeping any time step already advanced to.
+    //! @note This must be called from the thread that requests values.
+    void disable_lookahead();
+
+  private:
+    //! State of the time step being advanced to on the look-ahead thread
+    enum class ahead_state { idle, requested, ready };
+
+    void advance_(std::size_t step);
+
+    //! Copy the outputs of the instance's current time step; the GIL must be held.
+    void copy_(std::vector<double>& snapshot);
+
+    //! Keep a copy as the latest time step, leaving it the buffer of the earliest if that is dropped.
+    void keep_(std::vector<double>& snapshot);
+
+    //! Wait for the look-ahead thread to finish its time step, and keep it.
+    void take_ahead_();
+
+    void work_();
+
+    std::shared_ptr<bmi_type> bmi_;
+    std::chrono::seconds time_step_;
+
+    //! Copied output variables, and the offset of each in a snapshot
+    std::vector<std::string> variables_;
+    std::vector<std::size_t> offsets_;
+
+    //! Copies of every variable after each time step, from first_step_ on
+    std::deque<std::vector<double>> snapshots_;
+    std::size_t first_step_ = 0;
+    std::size_t capacity_ = 2;
+
+    //! Buffer for the next copy made on the reading thread
+    std::vector<double> spare_;
+
+    //! Look-ahead thread, and the time step it works on, copied into ahead_
+    bool lookahead_ = false;
+    bool ahead_pending_ = false;
+    std::size_t last_step_ = 0;
+    std::thread worker_;
+    std::mutex mutex_;
+    std::condition_variable requested_;
+    std::condition_variable ready_;
+    ahead_state ahead_state_ = ahead_state::idle;
+    bool stopping_ = false;
+    std::size_t ahead_step_ = 0;
+    std::vector<double> ahead_;
+    std::exception_ptr ahead_error_;
+};
+
 //! Storage for Forcings Engine-specific BMI instances.
 struct ForcingsEngineStorage {
     //! Key type for Forcings Engine storage, storing file paths to initialization files.
@@ -75,17 +185,45 @@ struct ForcingsEngineStorage {
         data_[key] = value;
     }
 
+    //! Get the output snapshots shared by the providers of a Forcings Engine instance.
+    //! @param key Initialization file path for Forcings Engine instance.
+    //! @return Shared pointer to the snapshots, or @c nullptr if they have not been created yet.
+    std::shared_ptr<ForcingsEngineSnapshots> get_snapshots(const key_type& key)
+    {
+        auto pos = snapshots_.find(key);
+        if (pos == snapshots_.end()) {
+          return nullptr;
+        }
+
+        return pos->second;
+    }
+
+    //! Associate output snapshots to a Forcings Engine instance's file path.
+    //! @param key Initialization file path for Forcings Engine instance.
+    //! @param value Shared pointer to the snapshots of the instance's outputs.
+    void set_snapshots(const key_type& key, std::shared_ptr<ForcingsEngineSnapshots> value)
+    {
+        snapshots_[key] = value;
+    }
+
     //! Clear all references to Forcings Engine instances.
     //! @note This will not necessarily destroy the Forcings Engine instances. Since they
     //!       are reference counted, it will only decrement their instance by one.
     void clear()
     {
+        for (auto& entry : snapshots_) {
+            entry.second->disable_lookahead();
+        }
+        snapshots_.clear();
         data_.clear();
     }
 
   private:
     //! Instance map of underlying BMI models.
     std::unordered_map<key_type, value_type> data_;
+
+    //! Output snapshots of each instance.
+    std::unordered_map<key_type, std::shared_ptr<ForcingsEngineSnapshots>> snapshots_;
 };
 
 } // namespace detail
@@ -175,6 +313,12 @@ struct ForcingsEngineDataProvider
         // Get a forcings engine instance if it exists for this initialization file
         bmi_ = storage_type::instances.get(init);
 
+        // Don't call the instance while it is advanced ahead for its other providers
+        auto snapshots = storage_type::instances.get_snapshots(init);
+        if (snapshots != nullptr) {
+            snapshots->settle();
+        }
+
         // If it doesn't exist, create it and assign it to the storage map
         if (bmi_ == nullptr) {
             // Outside of this branch, this->bmi_ != nullptr after this
@@ -14,13 +14,17 @@ struct ForcingsEngineLumpedDataProvider final :
 {
     using base_type = ForcingsEngineDataProvider<data_type, selection_type>;
 
-    ~ForcingsEngineLumpedDataProvider() override = default;
+    ~ForcingsEngineLumpedDataProvider() override;
 
+    //! @param window_seconds The longest period values are requested for at once. The time steps
+    //!        of such a period are kept until every provider of the instance has read them.
+    //!        Defaults to one time step.
     ForcingsEngineLumpedDataProvider(
         const std::string& init,
         std::size_t time_begin_seconds,
         std::size_t time_end_seconds,
-        const std::string& divide_id
+        const std::string& divide_id,
+        std::size_t window_seconds = 0
     );
 
     data_type get_value(
@@ -33,6 +37,24 @@ struct ForcingsEngineLumpedDataProvider final :
         data_access::ReSampleMethod m
     ) override;
 
+    //! Make a batch of catchments, with the index of each divide within the Forcings Engine.
+    //! @throws std::out_of_range If a divide is not in the Forcings Engine domain.
+    CatchmentBatch get_batch(std::vector<std::string> ids) const override;
+
+    //! Get the value of a variable for each divide of a batch, reading each time step's
+    //! snapshot once for all of them.
+    void get_batch_values(
+        const CatchmentBatch& batch,
+        const selection_type& selector,
+        boost::span<data_type> values,
+        data_access::ReSampleMethod m
+    ) override;
+
+    //! Advance the shared Forcings Engine instance a time step ahead of the values requested, on
+    //! a dedicated thread, or stop doing so. Looking ahead stops when this provider is destroyed.
+    //! @see detail::ForcingsEngineSnapshots::enable_lookahead
+    void lookahead(bool enabled);
+
     //! Get this provider's Divide ID.
     std::size_t divide() const noexcept;
 
@@ -40,8 +62,15 @@ struct ForcingsEngineLumpedDataProvider final :
     std::size_t divide_index() const noexcept;
 
   private:
+    //! Get this provider's value of a variable at the end of the time step ending at @p time.
+    data_type value_at_(clock_type::time_point time, std::size_t variable) const;
+
     std::size_t divide_id_;
     std::size_t divide_idx_;
+    bool lookahead_ = false;
+
+    //! Outputs of the Forcings Engine, shared with the other providers of the instance
+    std::shared_ptr<detail::ForcingsEngineSnapshots> snapshots_;
 };
 
 } // namespace data_access
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cmath>
 #include <cstdint>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -8,6 +10,7 @@
 #include <boost/geometry.hpp>
 
 #include <geojson/JSONGeometry.hpp>
+#include <utilities/grid_coverage.hpp>
 
 struct Cell {
     std::uint64_t x = 0;
@@ -133,7 +136,7 @@ struct GridDataSelector {
      * Boundary-based constructor
      *
      * Constructs a selector taking only the cells
-     * from @p grid that intersect @p polygon.
+     * from @p grid that @p polygon covers any part of.
      *
      * @param config Selector configuration options
      * @param grid Source grid specification
@@ -146,27 +149,22 @@ struct GridDataSelector {
     )
         : config_(std::move(config))
     {
-        const auto xmin = grid.extent.xmin();
-        const auto xmax = grid.extent.xmax();
-        const auto ymin = grid.extent.ymin();
-        const auto ymax = grid.extent.ymax();
-        const auto ydiff = static_cast<double>(grid.rows) / (ymax - ymin);
-        const auto xdiff = static_cast<double>(grid.columns) / (xmax - xmin);
-    
-        const auto bbox = BoundingBox{ boost::geometry::return_envelope<box_t>(polygon) };
-        for (double row = bbox.ymin(); row < bbox.ymax() - ydiff; row += ydiff) {
-            for (double col = bbox.xmin(); col < bbox.xmax() - xdiff; row += xdiff) {
-                const box_t cell_box = {
-                    /*min_corner=*/{ col, row },
-                    /*max_corner=*/{ col + xdiff, row + ydiff }
-                };
-
-                if (boost::geometry::intersects(cell_box, polygon)) {
-                    auto x = position_(col, xmin, xmax, grid.columns);
-                    auto y = position_(row, ymin, ymax, grid.rows);
-                    cells_.emplace_back(Cell{x, y, /*z=*/0UL, /*value=*/NAN});
-                }
-            }
+        ngen::grid_coverage coverage{{
+            /*xmin=*/grid.extent.xmin(),
+            /*ymin=*/grid.extent.ymin(),
+            /*dx=*/(grid.extent.xmax() - grid.extent.xmin()) / static_cast<double>(grid.columns),
+            /*dy=*/(grid.extent.ymax() - grid.extent.ymin()) / static_cast<double>(grid.rows),
+            /*columns=*/grid.columns,
+            /*rows=*/grid.rows
+        }};
+        coverage.add_polygon(polygon);
+
+        std::vector<ngen::cell_coverage> covered;
+        coverage.compute(covered);
+
+        cells_.reserve(covered.size());
+        for (const auto& cell : covered) {
+            cells_.emplace_back(Cell{/*x=*/cell.column, /*y=*/cell.row, /*z=*/0UL, /*value=*/NAN});
         }
     }
 
@@ -0,0 +1,158 @@
+#ifndef NGEN_NETCDF_GRIDDED_DATAPROVIDER_HPP
+#define NGEN_NETCDF_GRIDDED_DATAPROVIDER_HPP
+
+#include <NGenConfig.h>
+
+#if NGEN_WITH_NETCDF
+
+#include "GenericDataProvider.hpp"
+#include "DataProviderSelectors.hpp"
+#include "ZonalWeights.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <boost/compute/detail/lru_cache.hpp>
+
+#include <StreamHandler.hpp>
+
+namespace netCDF {
+    class NcVar;
+    class NcFile;
+}
+
+namespace data_access
+{
+    /**
+     * Provides catchment forcing from a gridded NetCDF file, such as AORC, without aggregating the
+     * grid to catchments ahead of time.
+     *
+     * The file holds a `time` coordinate with CF units such as `seconds since 1970-01-01 00:00:00`,
+     * x and y coordinates of the cell centers on a regular grid (named `x`/`y`, `lon`/`lat` or
+     * `longitude`/`latitude`), and variables over (time, y, x). The fraction of each cell covered by
+     * each catchment is computed once, at construction, and kept as a sparse matrix. For each time
+     * step of a variable, only the window of the grid that the catchments cover is read, and the
+     * means of every catchment are found together, with a single sparse matrix-vector product.
+     */
+    class NetCDFGriddedDataProvider : public GenericDataProvider
+    {
+        public:
+
+        //! How the values of a variable are stored, per the CF conventions
+        struct Packing
+        {
+            double scale_factor = 1.0;
+            double add_offset = 0.0;
+            std::vector<double> missing_values;
+        };
+
+        /**
+         * @brief Factory method that creates or returns an existing provider for the provided path.
+         * @param input_path The path to a gridded NetCDF forcing file.
+         * @param geometry_path The path to a GeoJSON file with the polygon of every catchment to provide forcing for.
+         * If a provider object for the given path already exists, this argument will be ignored.
+         * @param log_s An output log stream for messages from the underlying library. If a provider object for
+         * the given path already exists, this argument will be ignored.
+         */
+        static std::shared_ptr<NetCDFGriddedDataProvider> get_shared_provider(std::string input_path, std::string geometry_path, time_t sim_start, time_t sim_end, utils::StreamHandler log_s);
+
+        /**
+         * @brief Cleanup the shared providers cache, ensuring that the files get closed.
+         */
+        static void cleanup_shared_providers();
+
+        /**
+         * @param input_path The path to a gridded NetCDF forcing file.
+         * @param ids The id of each catchment
+         * @param catchments The boundary of each catchment, in the coordinates of the grid
+         */
+        NetCDFGriddedDataProvider(
+            std::string input_path,
+            std::vector<std::string> ids,
+            const std::vector<geojson::multipolygon_t>& catchments,
+            time_t sim_start,
+            time_t sim_end,
+            utils::StreamHandler log_s
+        );
+
+        ~NetCDFGriddedDataProvider();
+
+        void finalize() override;
+
+        /** Return the variables that are accessable by this data provider */
+        boost::span<const std::string> get_available_variable_names() const override;
+
+        /** return the ids of the catchments forcing is provided for */
+        const std::vector<std::string>& get_ids() const;
+
+        /** Return the first valid time for which data from the request variable  can be requested */
+        long get_data_start_time() const override;
+
+        /** Return the last valid time for which data from the requested variable can be requested */
+        long get_data_stop_time() const override;
+
+        long record_duration() const override;
+
+        /**
+         * Get the index of the data time step that contains the given point in time.
+         *
+         * @param epoch_time The point in time, as a seconds-based epoch time.
+         * @return The index of the forcing time step that contains the given point in time.
+         * @throws std::out_of_range If the given point is not in any time step.
+         */
+        size_t get_ts_index_for_time(const time_t &epoch_time) const override;
+
+        /**
+         * Get the mean of a forcing property over a catchment for an arbitrary time period, converting units if needed.
+         *
+         * @param selector Data required to establish what subset of the stored data should be accessed
+         * @param m How data is to be resampled if there is a mismatch in data alignment or repeat rate
+         * @return The value of the forcing property for the described time period, with units converted if needed.
+         * @throws std::out_of_range If data for the time period is not available, or the catchment is unknown.
+         */
+        double get_value(const CatchmentAggrDataSelector& selector, ReSampleMethod m) override;
+
+        std::vector<double> get_values(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m) override;
+
+        private:
+
+        /**
+         * Get the mean of a variable over every catchment for one time step, reading it if it is not cached
+         */
+        std::shared_ptr<std::vector<double>> get_catchment_means(const std::string& name, size_t time_index);
+
+        time_t sim_start_date_time_epoch;
+        time_t sim_end_date_time_epoch;
+
+        static std::mutex shared_providers_mutex;
+        static std::map<std::string, std::shared_ptr<NetCDFGriddedDataProvider>> shared_providers;
+
+        std::vector<std::string> variable_names;
+        std::vector<std::string> loc_ids;
+        std::map<std::string, std::size_t> id_pos;
+        std::vector<double> time_vals;
+        double start_time;                              // the begining of the first time for which data is stored
+        double stop_time;                               // the end of the last time for which data is stored
+        double time_stride;                             // the amount of time between stored time values
+        utils::StreamHandler log_stream;
+
+        std::shared_ptr<netCDF::NcFile> nc_file;
+
+        //! Weight of each cell of the window read, by catchment
+        ZonalWeights weights;
+
+        //! Window of the file's (y, x) grid covering every catchment
+        std::vector<size_t> window_start = { 0, 0 };
+        std::vector<size_t> window_count = { 0, 0 };
+
+        std::map<std::string, netCDF::NcVar> ncvar_cache;
+        std::map<std::string, std::string> units_cache;
+        std::map<std::string, Packing> packing_cache;
+        boost::compute::detail::lru_cache<std::string, std::shared_ptr<std::vector<double>>> value_cache;
+    };
+}
+
+#endif // NGEN_WITH_NETCDF
+#endif // NGEN_NETCDF_GRIDDED_DATAPROVIDER_HPP
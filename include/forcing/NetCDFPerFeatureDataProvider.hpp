@@ -110,6 +110,31 @@ namespace data_access
 
         virtual std::vector<double> get_values(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m) override;
 
+        /**
+         * Make a batch of catchments, with the position of each in the file's ids.
+         *
+         * @param ids The ids of the catchments, in the order their values are to be given.
+         * @return The batch of catchments.
+         * @throws std::out_of_range If one of the ids is not in the file.
+         */
+        CatchmentBatch get_batch(std::vector<std::string> ids) const override;
+
+        /**
+         * Get the value of a forcing property for an arbitrary time period, for each catchment of a batch, converting
+         * units if needed.
+         *
+         * Each time step of the period is read once for all of the catchments, from the same cached slices as
+         * @ref get_value, and the values are converted together.
+         *
+         * @param batch Catchments from @ref get_batch of this provider.
+         * @param selector The variable, time period, and output units of the values.
+         * @param values Where to write the value of each catchment of the batch, in its order.
+         * @param m How data is to be resampled if there is a mismatch in data alignment or repeat rate
+         * @throws std::invalid_argument If the size of @p values is not that of the batch.
+         * @throws std::out_of_range If data for the time period is not available.
+         */
+        void get_batch_values(const CatchmentBatch& batch, const CatchmentAggrDataSelector& selector, boost::span<double> values, ReSampleMethod m) override;
+
         private:
 
         time_t sim_start_date_time_epoch;
@@ -142,6 +167,11 @@ namespace data_access
 
         const std::string& get_ncvar_units(const std::string& name);
 
+        /**
+         * Get the values of a variable for all catchments at a cache slice of time steps, reading it if not cached.
+         */
+        std::shared_ptr<std::vector<double>> get_cache_slice(const netCDF::NcVar& ncvar, size_t cache_t_idx);
+
     };
 }
 
@@ -0,0 +1,119 @@
+#ifndef NGEN_ZONALWEIGHTS_HPP
+#define NGEN_ZONALWEIGHTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/core/span.hpp>
+
+#include "GridDataSelector.hpp"
+
+namespace data_access {
+
+/**
+ * Weights of the grid cells within each of a set of zones, such as catchments.
+ *
+ * Weights are stored zone by zone in compressed sparse row form, so the means of a gridded
+ * variable over every zone are found with a single sparse matrix-vector product.
+ */
+class ZonalWeights
+{
+  public:
+    //! Index of a cell within a grid, or within the window of a grid that is read
+    using cell_index = std::uint32_t;
+
+    /**
+     * Begin the next zone; cells added from here on belong to it
+     */
+    void add_zone()
+    {
+        offsets_.push_back(cells_.size());
+    }
+
+    /**
+     * Add a cell to the last zone begun
+     *
+     * @param cell Index of the cell
+     * @param weight Weight of the cell, such as the fraction of its area within the zone
+     */
+    void add_cell(cell_index cell, double weight)
+    {
+        cells_.push_back(cell);
+        weights_.push_back(weight);
+        offsets_.back() = cells_.size();
+    }
+
+    /**
+     * @return Number of zones
+     */
+    std::size_t zones() const noexcept
+    {
+        return offsets_.size() - 1;
+    }
+
+    /**
+     * @return Number of cell weights over every zone
+     */
+    std::size_t size() const noexcept
+    {
+        return cells_.size();
+    }
+
+    boost::span<const cell_index> cells(std::size_t zone) const noexcept
+    {
+        return { cells_.data() + offsets_[zone], offsets_[zone + 1] - offsets_[zone] };
+    }
+
+    boost::span<const double> weights(std::size_t zone) const noexcept
+    {
+        return { weights_.data() + offsets_[zone], offsets_[zone + 1] - offsets_[zone] };
+    }
+
+    /**
+     * Replace the index of every cell, as when only a window of the grid is read
+     *
+     * @param remap Callable taking a cell index and returning its new index
+     */
+    template<typename F>
+    void remap_cells(F&& remap)
+    {
+        for (auto& cell : cells_) {
+            cell = remap(cell);
+        }
+    }
+
+    /**
+     * Compute the weighted mean of a grid over every zone.
+     *
+     * Cells whose value is NaN, as missing values are read, are left out of the means of their
+     * zones, and a zone with no other cells has a mean of NaN.
+     *
+     * @param grid Value of every cell, by cell index
+     * @param means Receives the mean of each zone
+     */
+    void apply(boost::span<const double> grid, boost::span<double> means) const;
+
+  private:
+    std::vector<std::size_t> offsets_ = { 0 };
+    std::vector<cell_index> cells_;
+    std::vector<double> weights_;
+};
+
+/**
+ * Compute the fraction of each grid cell covered by each of a set of zones.
+ *
+ * Coverage is exact, and coordinates are taken as planar in the coordinate system of the grid.
+ * Cells are indexed by `column + row * grid.columns`, with row 0 at the minimum y of the grid,
+ * as in @ref GridDataSelector. Parts of a zone outside the grid are ignored.
+ *
+ * @param grid Grid specification
+ * @param zones Boundary of each zone
+ * @return Weights with a zone for each of @p zones, in order
+ * @throws std::invalid_argument If the grid has more cells than @ref ZonalWeights::cell_index can index
+ */
+ZonalWeights compute_zonal_weights(const GridSpecification& grid, const std::vector<geojson::multipolygon_t>& zones);
+
+} // namespace data_access
+
+#endif // NGEN_ZONALWEIGHTS_HPP
@@ -4,7 +4,9 @@
 #include <features/Features.hpp>
 #include <FeatureCollection.hpp>
 #include <JSONGeometry.hpp>
+#include <FeatureStreamReader.hpp>
 
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <ostream>
@@ -13,6 +15,7 @@
 #include <algorithm>
 
 #include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser/error.hpp>
 
 namespace geojson {
     /**
@@ -224,74 +227,50 @@ namespace geojson {
         throw std::invalid_argument("tree");
     }
 
-    static Feature build_feature(boost::property_tree::ptree &tree) {
-        bool has_geometry_collection = false;
-        bool has_geometry = false;
-
-        geometry geometry_object;
-        std::vector<geometry> geometry_collection;
-        FeatureType type = FeatureType::None;
-        std::string id = "";
-        std::vector<double> bounding_box;
-        PropertyMap properties;
-        PropertyMap foreign_members;
-
-        for (auto& child : tree) {
-            if (child.first == "geometry") {
-                const std::string& geometry_type = child.second.get<std::string>("type");
-                geometry_object = build_geometry(child.second);
-                has_geometry = true;
-
-                if (geometry_type == "Point") {
-                    type = FeatureType::Point;
-                }
-                else if (geometry_type == "LineString") {
-                    type = FeatureType::LineString;
-                }
-                else if (geometry_type == "Polygon") {
-                    type = FeatureType::Polygon;
-                }
-                else if (geometry_type == "MultiPoint") {
-                    type = FeatureType::MultiPoint;
-                }
-                else if (geometry_type == "MultiLineString") {
-                    type = FeatureType::MultiLineString;
-                }
-                else if (geometry_type == "MultiPolygon") {
-                    type = FeatureType::MultiPolygon;
-                }
-            }
-            else if (child.first == "geometries") {
-                // Since the feature can have a number of different types of geometries and the
-                // type of the feature comes from the geometry, we simply set this as a collection
-                type = FeatureType::GeometryCollection;
-                has_geometry_collection = true;
-
-                // Loop through the underlying collection of geometric json definitions and use
-                // those to create geometric objects
-                for (auto &geom : child.second) {
-                    geometry_collection.push_back(build_geometry(geom.second));
-                }
-            }
-            else if (child.first == "id") {
-                id = std::move(child.second.data());
-            }
-            else if (child.first == "bbox") {
-                for (auto &value : tree.get_child("bbox")) {
-                    bounding_box.push_back(std::stod(value.second.data()));
-                }
-            }
-            else if (child.first == "properties") {
-                for (auto& property : child.second) {
-                    properties.emplace(property.first, JSONProperty(property.first, property.second));
-                }
-            }
-            else {
-                foreign_members.emplace(child.first, JSONProperty(child.first, child.second));
-            }
+    /**
+     * @brief Get the feature type matching the name of a GeoJSON geometry type
+     *
+     * @param geometry_type GeoJSON geometry "type" member, such as "Polygon"
+     * @return The corresponding FeatureType, or FeatureType::None if it isn't recognized
+     */
+    static FeatureType feature_type(const std::string& geometry_type) {
+        if (geometry_type == "Point") {
+            return FeatureType::Point;
+        }
+        else if (geometry_type == "LineString") {
+            return FeatureType::LineString;
+        }
+        else if (geometry_type == "Polygon") {
+            return FeatureType::Polygon;
+        }
+        else if (geometry_type == "MultiPoint") {
+            return FeatureType::MultiPoint;
+        }
+        else if (geometry_type == "MultiLineString") {
+            return FeatureType::MultiLineString;
+        }
+        else if (geometry_type == "MultiPolygon") {
+            return FeatureType::MultiPolygon;
         }
 
-        
+        return FeatureType::None;
+    }
+
+    /**
+     * @brief Build a feature of the given type from its already parsed members
+     *
+     * If @p type is a single geometry type, @p geometry_object must hold that geometry;
+     * otherwise a CollectionFeature is built from @p geometry_collection (which may be empty).
+     */
+    static Feature build_feature(
+        FeatureType type,
+        geometry geometry_object,
+        std::vector<geometry> geometry_collection,
+        std::string id,
+        PropertyMap properties,
+        std::vector<double> bounding_box,
+        PropertyMap foreign_members
+    ) {
         switch (type) {
             case FeatureType::Point:
                 return std::make_shared<PointFeature>(PointFeature(
@@ -366,6 +345,61 @@ namespace geojson {
         }
     }
 
+    static Feature build_feature(boost::property_tree::ptree &tree) {
+        geometry geometry_object;
+        std::vector<geometry> geometry_collection;
+        FeatureType type = FeatureType::None;
+        std::string id = "";
+        std::vector<double> bounding_box;
+        PropertyMap properties;
+        PropertyMap foreign_members;
+
+        for (auto& child : tree) {
+            if (child.first == "geometry") {
+                const std::string& geometry_type = child.second.get<std::string>("type");
+                geometry_object = build_geometry(child.second);
+                type = feature_type(geometry_type);
+            }
+            else if (child.first == "geometries") {
+                // Since the feature can have a number of different types of geometries and the
+                // type of the feature comes from the geometry, we simply set this as a collection
+                type = FeatureType::GeometryCollection;
+
+                // Loop through the underlying collection of geometric json definitions and use
+                // those to create geometric objects
+                for (auto &geom : child.second) {
+                    geometry_collection.push_back(build_geometry(geom.second));
+                }
+            }
+            else if (child.first == "id") {
+                id = std::move(child.second.data());
+            }
+            else if (child.first == "bbox") {
+                for (auto &value : tree.get_child("bbox")) {
+                    bounding_box.push_back(std::stod(value.second.data()));
+                }
+            }
+            else if (child.first == "properties") {
+                for (auto& property : child.second) {
+                    properties.emplace(property.first, JSONProperty(property.first, property.second));
+                }
+            }
+            else {
+                foreign_members.emplace(child.first, JSONProperty(child.first, child.second));
+            }
+        }
+
+        return build_feature(
+            type,
+            std::move(geometry_object),
+            std::move(geometry_collection),
+            std::move(id),
+            std::move(properties),
+            std::move(bounding_box),
+            std::move(foreign_members)
+        );
+    }
+
     /**
      * @brief helper function to build a GeoJSON FeatureCollection from a property tree
      * @param tree boost::property_tree::ptree holding the parsed GeoJSON
@@ -441,16 +475,26 @@ namespace geojson {
         return collection;
     }
 
-    static GeoJSON read(const std::string &file_path, const std::vector<std::string> &ids = {}) {
-        boost::property_tree::ptree tree;
-        boost::property_tree::json_parser::read_json(file_path, tree);
-        return build_collection(tree, ids);
+    /**
+     * @brief Read a GeoJSON FeatureCollection from a file
+     *
+     * The file is streamed rather than parsed into a property tree first; see read_stream.
+     *
+     * @param file_path Path to the GeoJSON file
+     * @param ids optional subset of string feature ids, only features with these ids will be in the collection
+     * @param with_geometry if false, feature geometries are skipped and every feature has a null geometry
+     */
+    static GeoJSON read(const std::string &file_path, const std::vector<std::string> &ids = {}, bool with_geometry = true) {
+        std::ifstream input(file_path);
+        if (!input) {
+            throw boost::property_tree::json_parser::json_parser_error("cannot open file", file_path, 0);
+        }
+
+        return read_stream(input, ids, with_geometry);
     }
 
-    static GeoJSON read(std::stringstream &data, const std::vector<std::string> &ids = {}) {
-        boost::property_tree::ptree tree;
-        boost::property_tree::json_parser::read_json(data, tree);
-        return build_collection(tree, ids);
+    static GeoJSON read(std::stringstream &data, const std::vector<std::string> &ids = {}, bool with_geometry = true) {
+        return read_stream(data, ids, with_geometry);
     }
 
 
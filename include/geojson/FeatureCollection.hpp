@@ -50,6 +50,7 @@ namespace geojson {
              */
             FeatureCollection(const FeatureCollection &feature_collection) {
                 bounding_box = feature_collection.get_bounding_box();
+                property_table = feature_collection.property_table;
                 for (Feature feature : feature_collection) {
                     features.push_back(feature);
                 }
@@ -193,6 +194,29 @@ namespace geojson {
 
             int link_features_from_attribute(std::string* from_attribute = nullptr, std::string* to_attribute = nullptr);
 
+            /**
+             * Move the properties of every feature into a columnar PropertyTable
+             *
+             * Each feature keeps a row of the table and serves get_property from
+             * it, so the per-feature property maps are released. Features whose
+             * properties are already held in a table (e.g. features shared with
+             * another collection) are left in it.
+             *
+             * @param table Optional, a table that some features were already moved to while
+             *              the collection was being read; a new table is created if not given
+             */
+            void store_properties_in_columns(std::shared_ptr<PropertyTable> table = nullptr);
+
+            /**
+             * The columnar PropertyTable of this collection
+             *
+             * Scans over a single property can read its column directly, using
+             * each feature's `get_property_row()`.
+             *
+             * @return The table, or nullptr if store_properties_in_columns has not been called
+             */
+            const PropertyTable* get_property_table() const;
+
             /* Untested, excluded for now in favor of filter constructor above.
             template<typename C>
             void filter(C& ids)
@@ -221,6 +245,7 @@ namespace geojson {
             std::vector<double> bounding_box;
             std::map<std::string, Feature> feature_by_id;
             std::map<std::string, JSONProperty> foreign_members;
+            std::shared_ptr<PropertyTable> property_table;
     };
 }
 
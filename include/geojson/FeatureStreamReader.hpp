@@ -0,0 +1,40 @@
+#ifndef GEOJSON_FEATURE_STREAM_READER_H
+#define GEOJSON_FEATURE_STREAM_READER_H
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace geojson {
+    class FeatureCollection;
+
+    /**
+     * @brief Build a FeatureCollection by streaming GeoJSON text.
+     *
+     * Unlike reading the whole document into a boost::property_tree first, the
+     * input is consumed incrementally and features are built as soon as each
+     * one has been parsed. Only the members of the feature currently being
+     * read are held in memory, so peak memory is proportional to the resulting
+     * collection rather than to the input document.
+     *
+     * Feature members are interpreted exactly as build_collection would
+     * interpret them, so both paths produce equivalent collections.
+     *
+     * @param input Stream containing a GeoJSON FeatureCollection
+     * @param ids Optional subset of feature ids; features with other ids are
+     *            skipped while streaming and never built
+     * @param with_geometry If false, geometry members are skipped without being
+     *                      parsed and features are built with a null geometry
+     *                      (an empty geometry collection)
+     * @return The collection of (selected) features
+     * @throws boost::property_tree::json_parser::json_parser_error if the input is not valid JSON
+     */
+    std::shared_ptr<FeatureCollection> read_stream(
+        std::istream& input,
+        const std::vector<std::string>& ids = {},
+        bool with_geometry = true
+    );
+}
+
+#endif // GEOJSON_FEATURE_STREAM_READER_H
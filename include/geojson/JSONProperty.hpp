@@ -388,6 +388,40 @@ namespace geojson {
                 }
             }
 
+            /**
+             * @brief Move construct a JSONProperty, taking over the nested storage of the original
+             *
+             * @param original
+             */
+            JSONProperty(JSONProperty &&original) noexcept
+                : key(std::move(original.key)),
+                  type(original.type),
+                  values(std::move(original.values)),
+                  value_list(std::move(original.value_list)),
+                  data(std::move(original.data))
+            {
+                bind_data();
+            }
+
+            JSONProperty& operator=(const JSONProperty &original) {
+                if (this != &original) {
+                    *this = JSONProperty(original);
+                }
+                return *this;
+            }
+
+            JSONProperty& operator=(JSONProperty &&original) noexcept {
+                if (this != &original) {
+                    key = std::move(original.key);
+                    type = original.type;
+                    values = std::move(original.values);
+                    value_list = std::move(original.value_list);
+                    data = std::move(original.data);
+                    bind_data();
+                }
+                return *this;
+            }
+
             /**
              * @brief Copy construct a JSONProperty, but use a new key value for the property
              * 
@@ -429,6 +463,20 @@ namespace geojson {
                 data = Object( &values );
             }
 
+            /**
+             * Create a JSONProperty that takes over a nested map of properties
+             *
+             * @param value_key: The name of the key that stores this value
+             * @param value: A map of nested properties that will be moved into this property
+             */
+            JSONProperty(std::string value_key, PropertyMap &&value)
+                : key(std::move(value_key)),
+                    type(PropertyType::Object),
+                    values(std::move(value))
+            {
+                data = Object( &values );
+            }
+
             /**
              * @brief Pretty print the property to standard out stream.
              * 
@@ -588,6 +636,18 @@ namespace geojson {
                 return not this->operator==(other);
             }
         private:
+            /**
+             * @brief Point the List or Object held in data at this property's own storage
+             */
+            void bind_data() {
+                if (type == PropertyType::List) {
+                    data = List( &value_list );
+                }
+                else if (type == PropertyType::Object) {
+                    data = Object( &values );
+                }
+            }
+
             std::string key;
             PropertyType type;
             PropertyMap values;
@@ -0,0 +1,166 @@
+#ifndef GEOJSON_PROPERTY_TABLE_H
+#define GEOJSON_PROPERTY_TABLE_H
+
+#include "JSONProperty.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace geojson {
+    /**
+     * A single named attribute of a PropertyTable, stored as one typed array
+     *
+     * The column takes the type of the first scalar value stored in it. Rows
+     * whose value has a different type, or that hold a list or object, are
+     * kept as whole JSONProperty values in a sparse overflow map, so that no
+     * value changes type when it is read back.
+     */
+    class PropertyColumn {
+        public:
+            /**
+             * @param column_type The type of values held in the typed array
+             */
+            explicit PropertyColumn(PropertyType column_type) : column_type(column_type) {}
+
+            /**
+             * The type of the values held in the typed array
+             */
+            PropertyType get_type() const {
+                return column_type;
+            }
+
+            /**
+             * Whether the given row has a value in this column
+             */
+            bool has(std::size_t row) const {
+                return row < state.size() && state[row] != missing;
+            }
+
+            /**
+             * Whether the given row has a value of the column type, readable through the typed accessors
+             */
+            bool is_typed(std::size_t row) const {
+                return row < state.size() && state[row] == typed;
+            }
+
+            long natural(std::size_t row) const {
+                return naturals[row];
+            }
+
+            double real(std::size_t row) const {
+                return reals[row];
+            }
+
+            bool boolean(std::size_t row) const {
+                return booleans[row] != 0;
+            }
+
+            const std::string& string(std::size_t row) const {
+                return strings[row];
+            }
+
+            /**
+             * Read a row as a property
+             *
+             * @param key The key to give the returned property
+             * @param row The row to read
+             * @throw std::invalid_argument if the row has no value in this column
+             */
+            JSONProperty get(const std::string& key, std::size_t row) const;
+
+            /**
+             * Store a value in a row, replacing any value already there
+             */
+            void set(std::size_t row, const JSONProperty& value);
+
+            /**
+             * Release any capacity reserved beyond the rows stored so far
+             */
+            void shrink_to_fit();
+
+        private:
+            static constexpr std::uint8_t missing = 0;
+            static constexpr std::uint8_t typed = 1;
+            static constexpr std::uint8_t overflow = 2;
+
+            void resize(std::size_t rows);
+
+            PropertyType column_type;
+            std::vector<std::uint8_t> state;
+            std::vector<long> naturals;
+            std::vector<double> reals;
+            std::vector<std::uint8_t> booleans;
+            std::vector<std::string> strings;
+            std::unordered_map<std::size_t, JSONProperty> overflow_values;
+    };
+
+    /**
+     * Feature properties stored by column rather than by feature
+     *
+     * Each row holds the properties of one feature and each property name is
+     * a PropertyColumn. Features hold a row index into the table and read
+     * their properties through it, which avoids a map and a JSONProperty
+     * allocation per property per feature and keeps scans over a single
+     * attribute contiguous in memory.
+     */
+    class PropertyTable {
+        public:
+            /**
+             * Append a row
+             *
+             * @param properties The values of the new row
+             * @return The index of the new row
+             */
+            std::size_t add_row(const PropertyMap& properties);
+
+            /**
+             * The number of rows in the table
+             */
+            std::size_t size() const {
+                return rows;
+            }
+
+            /**
+             * Whether a row has a value for the given property
+             */
+            bool has(std::size_t row, const std::string& key) const;
+
+            /**
+             * Read a property of a row
+             *
+             * @throw std::invalid_argument if the row has no value for the key
+             */
+            JSONProperty get(std::size_t row, const std::string& key) const;
+
+            /**
+             * The names of all the properties a row has a value for, in sorted order
+             */
+            std::vector<std::string> keys(std::size_t row) const;
+
+            /**
+             * Copy all of the properties of a row into a PropertyMap
+             */
+            PropertyMap properties(std::size_t row) const;
+
+            /**
+             * Find the column for a property name
+             *
+             * @return The column, or nullptr if no row has ever had the property
+             */
+            const PropertyColumn* column(const std::string& key) const;
+
+            /**
+             * Release any capacity reserved beyond the rows stored so far
+             */
+            void shrink_to_fit();
+
+        private:
+            std::map<std::string, PropertyColumn> columns;
+            std::size_t rows = 0;
+    };
+}
+
+#endif // GEOJSON_PROPERTY_TABLE_H
@@ -3,6 +3,7 @@
 
 #include "JSONGeometry.hpp"
 #include "JSONProperty.hpp"
+#include "PropertyTable.hpp"
 #include "FeatureVisitor.hpp"
 
 #include <memory>
@@ -97,7 +98,9 @@ namespace geojson {
              */
             FeatureBase(const FeatureBase &feature) {
                 this->id = feature.get_id();
-                this->properties = feature.get_properties();
+                this->properties = feature.properties;
+                this->property_table = feature.property_table;
+                this->property_row = feature.property_row;
                 
                 for(std::string key : feature.keys()) {
                     this->set(key, feature.get(key));
@@ -210,6 +213,10 @@ namespace geojson {
              * @return The property identified by the key
              */
             virtual JSONProperty get_property(const std::string& key) const {
+                if (property_table) {
+                    return property_table->get(property_row, key);
+                }
+
                 if (properties.find(key) == properties.end()) {
                     std::string error_message = "JSON Property '" + key + "' not found."; 
                     throw std::invalid_argument(error_message);
@@ -340,6 +347,10 @@ namespace geojson {
              * @returns A list of all the names of the properties for this feature
              */
             virtual std::vector<std::string> property_keys() const {
+                if (property_table) {
+                    return property_table->keys(property_row);
+                }
+
                 std::vector<std::string> property_keys;
 
                 for (auto& pair : properties) {
@@ -350,15 +361,11 @@ namespace geojson {
             }
 
             virtual bool has_property(std::string property_name) const {
-                std::vector<std::string> all_properties = this->property_keys();
-
-                for (auto name : all_properties) {
-                    if (property_name == name) {
-                        return true;
-                    }
+                if (property_table) {
+                    return property_table->has(property_row, property_name);
                 }
 
-                return false;
+                return properties.find(property_name) != properties.end();
             }
 
             /**
@@ -384,20 +391,77 @@ namespace geojson {
                 return bounding_box;
             }
 
-            const PropertyMap& get_properties() const {
+            /**
+             * Get a copy of the full map of properties
+             *
+             * Properties held in a PropertyTable are read from their row; the
+             * feature keeps reading them through the table.
+             *
+             * @return A mapping between property names and their values
+             */
+            PropertyMap get_properties() const {
+                if (property_table) {
+                    return property_table->properties(property_row);
+                }
+
                 return properties;
             }
 
+            /**
+             * Get the full, modifiable map of properties
+             *
+             * If the properties are held in a PropertyTable, they are copied back
+             * into this feature, which owns them from then on.
+             *
+             * @return A mapping between property names and their values
+             */
             PropertyMap& get_properties() {
+                detach_properties();
                 return properties;
             }
 
+            /**
+             * Move this feature's properties into a row of a shared PropertyTable
+             *
+             * Properties are afterwards read through the table; features whose
+             * properties are already held in a table are moved to the new one.
+             *
+             * @param table The table to hold the properties
+             */
+            void move_properties_to(const std::shared_ptr<PropertyTable>& table) {
+                if (property_table == table) {
+                    return;
+                }
+
+                detach_properties();
+                property_row = table->add_row(properties);
+                property_table = table;
+                PropertyMap().swap(properties);
+            }
+
+            /**
+             * The PropertyTable holding this feature's properties, if any
+             */
+            const PropertyTable* get_property_table() const {
+                return property_table.get();
+            }
+
+            /**
+             * The row of the PropertyTable holding this feature's properties
+             */
+            std::size_t get_property_row() const {
+                return property_row;
+            }
+
             std::string get_id() const {
                 return id;
             }
 
             std::string get_id(std::string alt_id) const {
                 std::string tmp = id;
+                if (not has_property(alt_id)) {
+                    return tmp;
+                }
                 try{
                     tmp = get_property(alt_id).as_string();
                     //if the property exists, but its value is NaN/null
@@ -637,6 +701,13 @@ namespace geojson {
             }
 
         protected:
+            void detach_properties() {
+                if (property_table) {
+                    properties = property_table->properties(property_row);
+                    property_table.reset();
+                }
+            }
+
             virtual void break_links() {
                 // Go through all of the originators and remove the reference to this feature
                 for (auto originator : this->origination) {
@@ -711,6 +782,8 @@ namespace geojson {
             std::vector<::geojson::geometry> geometry_collection;
 
             PropertyMap properties;
+            std::shared_ptr<PropertyTable> property_table;
+            std::size_t property_row = 0;
             std::vector<double> bounding_box;
             PropertyMap foreign_members;
             std::string id;
@@ -21,6 +21,21 @@ geojson::geometry build_geometry(
     std::vector<double>& bounding_box
 );
 
+/**
+ * Build a geometry object from a GeoPackage WKB blob.
+ *
+ * This overload does not touch the SQLite connection, so it may be
+ * called concurrently from multiple threads.
+ *
+ * @param[in] geometry_blob GPKG WKB bytes
+ * @param[out] bounding_box Bounding box of the geometry to output
+ * @return geojson::geometry GPKG WKB converted and projected to a boost geometry model
+ */
+geojson::geometry build_geometry(
+    const boost::span<const uint8_t> geometry_blob,
+    std::vector<double>& bounding_box
+);
+
 /**
  * Build properties from GeoPackage table columns.
  * 
@@ -46,18 +61,54 @@ geojson::Feature build_feature(
     const std::string& geom_col
 );
 
+/**
+ * Build a feature from an already fetched ID, properties, and GPKG WKB blob
+ *
+ * This overload does not touch the SQLite connection, so it may be
+ * called concurrently from multiple threads.
+ *
+ * @param[in] id Feature ID
+ * @param[in] properties Feature properties
+ * @param[in] geometry_blob GPKG WKB bytes of the feature geometry
+ * @return geojson::Feature Feature containing geometry and properties
+ */
+geojson::Feature build_feature(
+    std::string id,
+    geojson::PropertyMap properties,
+    const boost::span<const uint8_t> geometry_blob
+);
+
+/**
+ * Build an attribute-only feature from a GPKG table row
+ *
+ * The geometry column is not read; the returned feature holds a null
+ * geometry (an empty geometry collection) and no bounding box.
+ *
+ * @param[in] row SQLite iterator at the row to build a feature from
+ * @param[in] id_col Name of the column containing the feature ID
+ * @return geojson::Feature Feature containing only properties from the given row
+ */
+geojson::Feature build_attribute_feature(
+    const ngen::sqlite::database::iterator& row,
+    const std::string& id_col
+);
+
 /**
  * Build a feature collection from a GPKG layer
  *
  * @param[in] gpkg_path Path to GPKG file
  * @param[in] layer Layer name within GPKG file to create a collection from
  * @param[in] ids optional subset of feature IDs to capture (if empty, the entire layer is converted)
+ * @param[in] with_geometry if false, only attribute columns are selected and no
+ *                          WKB decoding or projection is performed; features
+ *                          are built with a null geometry and no bounding box
  * @return std::shared_ptr<geojson::FeatureCollection> 
  */
 std::shared_ptr<geojson::FeatureCollection> read(
     const std::string& gpkg_path,
     const std::string& layer,
-    const std::vector<std::string>& ids
+    const std::vector<std::string>& ids,
+    bool with_geometry = true
 );
 
 } // namespace geopackage
@@ -171,6 +171,18 @@ class database
         return query(statement, binds);
     }
 
+    //! Execute a statement that does not return rows
+    //! @param statement SQL statement, i.e. CREATE TEMP TABLE ...
+    void execute(const std::string& statement);
+
+    //! Execute a single-parameter statement once for each value
+    //!
+    //! The statement is prepared once, and re-bound and re-stepped
+    //! for each value, within a single transaction.
+    //! @param statement SQL statement with one parameter, i.e. INSERT INTO t VALUES (?)
+    //! @param values text values to bind to the statement's parameter
+    void execute_many(const std::string& statement, const boost::span<const std::string> values);
+
   private:
     sqlite_t conn_ = nullptr;
 };
@@ -1,7 +1,9 @@
 #ifndef NGEN_GEOPACKAGE_PROJ_HPP
 #define NGEN_GEOPACKAGE_PROJ_HPP
 
+#include <boost/variant.hpp>
 #include <boost/geometry/srs/projection.hpp>
+#include <boost/geometry/srs/transformation.hpp>
 #include <unordered_map>
 
 namespace ngen {
@@ -21,6 +23,18 @@ struct epsg
 
     static srs_type get(uint32_t srid);
 
+    /**
+     * Get the transformation from an SRID to WGS84.
+     *
+     * Transformations are constructed once per SRID and cached for the
+     * lifetime of the process. This function is thread-safe, and the
+     * returned transformation may be used concurrently.
+     *
+     * @param srid Source SRID
+     * @return const bg::srs::transformation<>& transformation from srid to EPSG:4326
+     */
+    static const bg::srs::transformation<>& to_wgs84(uint32_t srid);
+
   private:
     using def_type = std::unordered_map<int, srs_type>;
     static const def_type defs_;
@@ -0,0 +1,92 @@
+#ifndef NGEN_HYDROFABRIC_FORMAT_H
+#define NGEN_HYDROFABRIC_FORMAT_H
+
+#include <cstdint>
+
+#include <boost/endian/arithmetic.hpp>
+
+namespace ngen {
+namespace hydrofabric {
+namespace format {
+
+// Layout of a compiled hydrofabric
+//
+// All integers are stored little-endian in unaligned types, so records
+// can be read in place from a memory mapping on any platform. The file
+// is a header followed by four tables, in this order:
+//
+//   strings     string_count + 1 offsets (relative to the end of the
+//               offsets), followed by the concatenated string bytes.
+//               Every ID and property key and string value is interned.
+//   features    nexus_count nexus records, then catchment_count
+//               catchment records.
+//   properties  Property records. The properties and foreign members of
+//               a feature, and the children of a list or object, are
+//               each contiguous.
+//   links       Feature indices; the destinations of each feature.
+
+using u8  = boost::endian::little_uint8_t;
+using u32 = boost::endian::little_uint32_t;
+using u64 = boost::endian::little_uint64_t;
+
+constexpr char magic[8] = {'N', 'G', 'E', 'N', 'F', 'A', 'B', '\0'};
+
+struct header
+{
+    char magic[8];
+    u32  version;
+    u32  nexus_count;
+    u32  catchment_count;
+    u32  string_count;
+    u32  property_count;
+    u32  link_count;
+    u64  strings_offset;
+    u64  features_offset;
+    u64  properties_offset;
+    u64  links_offset;
+    u64  file_size;
+};
+
+struct range
+{
+    u32 first;
+    u32 count;
+};
+
+struct feature
+{
+    u32   id;
+    range properties;
+    range members;
+    range destinations;
+};
+
+//! geojson::PropertyType, stored as a fixed-size integer
+enum class property_type : std::uint8_t
+{
+    natural = 0,
+    real    = 1,
+    string  = 2,
+    boolean = 3,
+    list    = 4,
+    object  = 5
+};
+
+struct property
+{
+    u32   key;
+    u8    type;
+    //! Natural: two's complement value; Real: IEEE 754 bits; Boolean: 0 or 1; String: string index
+    u64   value;
+    //! List and Object only
+    range children;
+};
+
+static_assert(sizeof(header) == 72, "compiled hydrofabric header must be unpadded");
+static_assert(sizeof(feature) == 28, "compiled hydrofabric feature records must be unpadded");
+static_assert(sizeof(property) == 21, "compiled hydrofabric property records must be unpadded");
+
+} // namespace format
+} // namespace hydrofabric
+} // namespace ngen
+#endif // NGEN_HYDROFABRIC_FORMAT_H
@@ -0,0 +1,75 @@
+#ifndef NGEN_HYDROFABRIC_H
+#define NGEN_HYDROFABRIC_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FeatureCollection.hpp"
+
+namespace ngen {
+namespace hydrofabric {
+
+//! File extension identifying a compiled hydrofabric
+constexpr const char* compiled_extension = ".ngenfab";
+
+//! Version of the compiled hydrofabric format written by compile()
+constexpr std::uint32_t compiled_version = 1;
+
+/**
+ * The nexus and catchment collections of a hydrofabric
+ */
+struct collections
+{
+    std::shared_ptr<geojson::FeatureCollection> nexuses;
+    std::shared_ptr<geojson::FeatureCollection> catchments;
+};
+
+/**
+ * Check whether a path names a compiled hydrofabric
+ *
+ * @param[in] path Path to a hydrofabric file
+ * @return true if @p path has the compiled hydrofabric extension
+ */
+bool is_compiled(const std::string& path);
+
+/**
+ * Write a compiled hydrofabric.
+ *
+ * The collections are combined and linked through their `toid` property
+ * exactly as ngen does at startup, and the resulting topology is stored
+ * as feature indices alongside every feature's ID, properties, and
+ * foreign members. Feature geometry is not stored.
+ *
+ * Linking is done in place, so the features of @p fabric are left linked
+ * to their destinations.
+ *
+ * @param[in] fabric Nexus and catchment collections read from a hydrofabric
+ * @param[in] path Path of the compiled hydrofabric to write
+ */
+void compile(const collections& fabric, const std::string& path);
+
+/**
+ * Load a compiled hydrofabric.
+ *
+ * The file is memory mapped and features are built directly from its
+ * records, without any text parsing. Features are returned already linked
+ * to their destinations, so `link_features_from_property` does not need
+ * to be called on them. As with the GeoJSON and GeoPackage readers, the
+ * features hold a null geometry (an empty geometry collection).
+ *
+ * @param[in] path Path to a compiled hydrofabric
+ * @param[in] catchment_ids optional subset of catchment IDs to load (if empty, all catchments are loaded)
+ * @param[in] nexus_ids optional subset of nexus IDs to load (if empty, all nexuses are loaded)
+ * @return collections The nexus and catchment collections
+ */
+collections load(
+    const std::string& path,
+    const std::vector<std::string>& catchment_ids = {},
+    const std::vector<std::string>& nexus_ids = {}
+);
+
+} // namespace hydrofabric
+} // namespace ngen
+#endif // NGEN_HYDROFABRIC_H
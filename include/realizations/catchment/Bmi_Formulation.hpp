@@ -1,6 +1,8 @@
 #ifndef NGEN_BMI_FORMULATION_HPP
 #define NGEN_BMI_FORMULATION_HPP
 
+#include <NGenConfig.h>
+
 #include <iomanip>
 #include <string>
 #include <utility>
@@ -8,6 +10,7 @@
 #include <memory>
 #include "Catchment_Formulation.hpp"
 #include "GenericDataProvider.hpp"
+#include "catchment_profile.hpp"
 
 // Define the configuration parameter names used in the realization/formulation config JSON file
 // First the required:
@@ -63,6 +66,9 @@ namespace realization {
         {
             // Do this here, as this function also handles initializing the output string stream for formatting.
             set_output_precision(9);
+            #if NGEN_WITH_PROFILING
+            profile_row = ngen::profiling::catchment_profile::instance().row(get_id());
+            #endif
         };
 
 
@@ -230,6 +236,8 @@ namespace realization {
 
         /** Object to help with converting numeric output values to text. */
         std::shared_ptr<std::ostringstream> output_text_stream;
+        /** The row of this formulation's catchment in the catchment profile, when profiling. */
+        std::size_t profile_row = 0;
 
         int get_output_precision() {
             return output_precision;
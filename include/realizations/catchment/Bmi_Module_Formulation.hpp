@@ -7,6 +7,7 @@
 #include "Bmi_Adapter.hpp"
 #include <DataProvider.hpp>
 #include "bmi_utilities.hpp"
+#include "profiling.hpp"
 
 using data_access::MEAN;
 using data_access::SUM;
@@ -381,11 +382,52 @@ namespace realization {
          */
         void set_model_inputs_prior_to_update(const double &model_init_time, time_step_t t_delta);
 
+        /**
+         * An input variable set directly from an output variable of another model, rather than through a provider.
+         */
+        struct Direct_Input {
+            /** The model with the output variable. */
+            std::shared_ptr<models::bmi::Bmi_Adapter> source;
+            /** The BMI name of the output variable. */
+            std::string source_var_name;
+            /** Whether output values are converted, as ``offset + scale * value``, before being set. */
+            bool convert = false;
+            double scale = 1.0;
+            double offset = 0.0;
+            /** Reused storage for converted values. */
+            std::vector<double> buffer;
+        };
+
+        /**
+         * Bind a BMI input variable directly to the BMI output variable of another model, if they are compatible.
+         *
+         * Once bound, the input is set before each update from the output, read in place with ``GetValuePtr``, instead
+         * of being requested from its provider.  The variables are compatible when they have the same number of items,
+         * and either the same type and units, or both are doubles with units that have a linear conversion.
+         *
+         * @param input_var_name The BMI name of this model's input variable.
+         * @param source The model with the output variable.
+         * @param source_var_name The BMI name of the output variable.
+         * @return Whether the input was bound; if not, it is still set from its provider.
+         */
+        bool bind_direct_input(const std::string &input_var_name, std::shared_ptr<models::bmi::Bmi_Adapter> source,
+                               const std::string &source_var_name);
+
+        /**
+         * Set a BMI input variable from the output variable it is bound to.
+         *
+         * @param input_var_name The BMI name of this model's input variable.
+         * @param direct The binding of the input variable.
+         */
+        void set_direct_input(const std::string &input_var_name, Direct_Input &direct);
+
         /** The delta of the last model update execution (typically, this is time step size). */
         time_step_t last_model_response_delta = 0;
         /** The epoch time of the model at the beginning of its last update. */
         time_t last_model_response_start_time = 0;
         std::map<std::string, std::shared_ptr<data_access::GenericDataProvider>> input_forcing_providers;
+        /** Input variables bound to other models' outputs by @ref bind_direct_input, keyed by BMI name. */
+        std::map<std::string, Direct_Input> direct_inputs;
 
         // Access for multi-BMI
         friend class Bmi_Multi_Formulation;
@@ -488,7 +530,10 @@ namespace realization {
 
         // Do this next, since after checking whether other input variables are present in the properties, we can
         // now construct the adapter and init the model
-        set_bmi_model(construct_model(properties));
+        {
+            ngen::profiling::scoped_timer initialize_timer("bmi_initialize");
+            set_bmi_model(construct_model(properties));
+        }
 
         // Output variable subset and order, if present
         auto out_var_it = properties.find(BMI_REALIZATION_CFG_PARAM_OPT__OUT_VARS);
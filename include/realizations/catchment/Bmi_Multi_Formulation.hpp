@@ -581,6 +581,9 @@ namespace realization {
          * time step), then a deferred provider gets registered with the nested module and has a reference added to
          * the @ref deferredProviders member.  This function goes through all such the deferred providers, ensures there
          * is something available that can serve as the backing wrapped provider, and associates them.
+         *
+         * Once all providers are associated, it also binds inputs directly to other modules' outputs where possible,
+         * via @ref init_direct_couplings.
          */
         inline void init_deferred_associations() {
             for (int d = 0; d < deferredProviders.size(); ++d) {
@@ -615,8 +618,20 @@ namespace realization {
                     throw realization::ConfigurationException(msg);
                 }
             }
+
+            init_direct_couplings();
         }
 
+        /**
+         * Bind nested module inputs directly to the outputs of the earlier nested modules that provide them.
+         *
+         * For each input of a nested module whose provider is another nested module, try to bind the input to that
+         * module's output with @ref Bmi_Module_Formulation::bind_direct_input, so it is then set from the output in
+         * place, rather than through the provider, unit conversion, and type conversion on every time step.  Inputs
+         * provided through deferred providers, which may give default values instead, keep their providers.
+         */
+        void init_direct_couplings();
+
         /**
          * Initialize a nested formulation from the given properties and update multi formulation metadata.
          *
@@ -764,6 +779,8 @@ namespace realization {
         /** The nested BMI modules composing this multi-module formulation, in their order of execution. */
         std::vector<nested_module_ptr> modules;
         std::vector<std::string> module_types;
+        /** The catchment profile column of each nested module, in the order of @ref modules, when profiling. */
+        std::vector<std::size_t> module_profile_columns;
         /**
          * Per-module maps (ordered as in @ref modules) of configuration-mapped names to BMI variable names.
          */
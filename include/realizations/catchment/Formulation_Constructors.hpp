@@ -6,6 +6,7 @@
 #include "Formulation.hpp"
 #include <JSONProperty.hpp>
 #include <exception>
+#include "profiling.hpp"
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/optional.hpp>
@@ -17,6 +18,10 @@
 #include "NullForcingProvider.hpp"
 #if NGEN_WITH_NETCDF
     #include "NetCDFPerFeatureDataProvider.hpp"
+    #include "NetCDFGriddedDataProvider.hpp"
+#endif
+#if NGEN_WITH_PYTHON
+    #include "ForcingsEngineLumpedDataProvider.hpp"
 #endif
 
 namespace realization {
@@ -44,6 +49,7 @@ namespace realization {
     ) {
         constructor formulation_constructor = formulations.at(formulation_type);
         std::shared_ptr<data_access::GenericDataProvider> fp;
+        ngen::profiling::scoped_timer provider_timer("forcing_provider");
         if (forcing_config.provider == "CsvPerFeature" || forcing_config.provider == ""){
             fp = std::make_shared<CsvPerFeatureForcingProvider>(forcing_config);
         }
@@ -51,6 +57,16 @@ namespace realization {
         else if (forcing_config.provider == "NetCDF"){
             fp = data_access::NetCDFPerFeatureDataProvider::get_shared_provider(forcing_config.path, forcing_config.simulation_start_t, forcing_config.simulation_end_t, output_stream);
         }
+        else if (forcing_config.provider == "NetCDFGridded"){
+            fp = data_access::NetCDFGriddedDataProvider::get_shared_provider(forcing_config.path, forcing_config.geometry_path, forcing_config.simulation_start_t, forcing_config.simulation_end_t, output_stream);
+        }
+#endif
+#if NGEN_WITH_PYTHON
+        else if (forcing_config.provider == "ForcingsEngineLumpedDataProvider"){
+            auto engine = std::make_shared<data_access::ForcingsEngineLumpedDataProvider>(forcing_config.path, forcing_config.simulation_start_t, forcing_config.simulation_end_t, identifier);
+            engine->lookahead(forcing_config.lookahead);
+            fp = engine;
+        }
 #endif
         else if (forcing_config.provider == "NullForcingProvider"){
             fp = std::make_shared<NullForcingProvider>();
@@ -61,6 +77,7 @@ namespace realization {
                     "\", formulation_type: \"" + formulation_type +
                     "\", provider: \"" + forcing_config.provider + "\"");
         }
+        provider_timer.stop();
         return formulation_constructor(identifier, fp, output_stream);
     }
 
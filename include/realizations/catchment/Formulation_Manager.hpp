@@ -14,6 +14,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 #include <string>
+#include <algorithm>
+#include <chrono>
+#include <atomic>
+#include <future>
+#include <unordered_set>
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -25,6 +30,10 @@
 #include "realizations/config/routing.hpp"
 #include "realizations/config/config.hpp"
 #include "realizations/config/layer.hpp"
+#include "realizations/config/trace.hpp"
+#include "thread_pool.hpp"
+#include "FilePatternIndex.hpp"
+#include "profiling.hpp"
 
 namespace realization {
 
@@ -100,6 +109,7 @@ namespace realization {
                             double c_value = UnitsHelper::get_converted_value(layer_desc.time_step_units,layer_desc.time_step,"s");
                             // make a new simulation time object with a different output interval
                             Simulation_Time sim_time(*Simulation_Time_Object, c_value);
+                            using_python_models = using_python_models || uses_python(layer.formulation.formulation);
                             domain_formulations.emplace(
                                 layer_desc.id,
                                 construct_formulation_from_config(simulation_time_config,
@@ -137,13 +147,20 @@ namespace realization {
 
                 /**
                  * Read catchment configurations from configuration file
-                 */      
+                 *
+                 * Every catchment is first matched to its configuration, then all of the formulations
+                 * are constructed together, so that construction can be spread over several threads.
+                 */
+                std::vector<formulation_builder> builders;
+                std::unordered_set<std::string> configured_ids;
+
+                ngen::profiling::scoped_timer match_timer("match_catchments");
                 auto possible_catchment_configs = tree.get_child_optional("catchments");
 
                 if (possible_catchment_configs) {
                     for (std::pair<std::string, boost::property_tree::ptree> catchment_config : *possible_catchment_configs) {
-                      int catchment_index = fabric->find(catchment_config.first);
-                      if( catchment_index == -1 )
+                      geojson::Feature catchment_feature = fabric->get_feature(catchment_config.first);
+                      if( catchment_feature == nullptr || catchment_feature->get_id() != catchment_config.first )
                       {
                           #ifndef NGEN_QUIET
                           std::cerr<<"WARNING Formulation_Manager::read: Cannot create formulation for catchment "
@@ -157,31 +174,55 @@ namespace realization {
                       if(!catchment_formulation.has_formulation()){
                         throw std::runtime_error("ERROR: No formulations defined for "+catchment_config.first+".");
                       }
-                      // Parse catchment-specific model_params
-                      auto catchment_feature = fabric->get_feature(catchment_index);
-                      catchment_formulation.formulation.link_external(catchment_feature);
-                      this->add_formulation(
-                        this->construct_formulation_from_config(
-                            simulation_time_config,
-                            catchment_config.first,
-                            catchment_formulation,
-                            output_stream
-                        )
-                      );
-                        //  break; //only construct one for now FIXME
-                       // } //end for formulaitons
-                      }//end for catchments
-
-
+                      configured_ids.insert(catchment_config.first);
+                      index_forcing_files(catchment_formulation.forcing.parameters);
+
+                      const bool thread_safe = constructs_concurrently(catchment_formulation);
+                      using_python_models = using_python_models || uses_python(catchment_formulation.formulation);
+                      builders.push_back({
+                        [this, &simulation_time_config, &output_stream, identifier = catchment_config.first,
+                         catchment_feature, catchment_formulation = std::move(catchment_formulation)]() mutable {
+                          // Parse catchment-specific model_params
+                          catchment_formulation.formulation.link_external(catchment_feature);
+                          return this->construct_formulation_from_config(
+                              simulation_time_config,
+                              identifier,
+                              catchment_formulation,
+                              output_stream
+                          );
+                        },
+                        thread_safe
+                      });
+                    }//end for catchments
                 }//end if possible_catchment_configs
 
+                const bool global_thread_safe = constructs_concurrently(global_config);
+                bool global_prepared = false;
                 for (geojson::Feature location : *fabric) {
-                    if (not this->contains(location->get_id())) {
-                        std::shared_ptr<Catchment_Formulation> missing_formulation = this->construct_missing_formulation(
-                          location, output_stream, simulation_time_config);
-                        this->add_formulation(missing_formulation);
+                    if (configured_ids.insert(location->get_id()).second && not this->contains(location->get_id())) {
+                        if (!global_prepared) {
+                            // Parse the global formulation once for all of the catchments that use it
+                            global_formulation = config::FormulationTemplate(global_config.formulation);
+                            index_forcing_files(global_config.forcing.parameters);
+                            using_python_models = using_python_models || uses_python(global_config.formulation);
+                            global_prepared = true;
+                        }
+                        builders.push_back({
+                          [this, &simulation_time_config, &output_stream, location]() mutable {
+                            return this->construct_missing_formulation(location, output_stream, simulation_time_config);
+                          },
+                          global_thread_safe
+                        });
                     }
                 }
+
+                match_timer.stop();
+
+                ngen::profiling::scoped_timer construct_timer("construct");
+                for (auto& formulation : construct_formulations(builders)) {
+                    this->add_formulation(formulation);
+                }
+                forcing_file_indexes.clear();
             }
 
             void add_formulation(std::shared_ptr<Catchment_Formulation> formulation) {
@@ -234,6 +275,13 @@ namespace realization {
                 return this->using_routing;
             }
 
+            /**
+             * @return Whether any catchment or layer formulation runs a Python BMI module in process
+             */
+            bool get_using_python_models() const {
+                return this->using_python_models;
+            }
+
             /**
              * @return routing t_route_config_file_with_path
              */
@@ -271,6 +319,7 @@ namespace realization {
 
 #if NGEN_WITH_NETCDF
                 data_access::NetCDFPerFeatureDataProvider::cleanup_shared_providers();
+                data_access::NetCDFGriddedDataProvider::cleanup_shared_providers();
 #endif
             }
 
@@ -320,6 +369,19 @@ namespace realization {
                 return "./";
             }
 
+            /**
+             * @brief Get the timeline trace settings, from the optional `trace` object of the realization config
+             *
+             * @return The settings, or none if the run is not to be traced
+             */
+            boost::optional<config::Trace> get_trace_config() const {
+                const auto trace = this->tree.get_child_optional("trace");
+                if (!trace) {
+                    return boost::none;
+                }
+                return config::Trace(*trace);
+            }
+
             /**
              * @brief return the layer storage used for formulations
              * @return a reference to the LayerStorageObject
@@ -328,6 +390,170 @@ namespace realization {
 
 
         protected:
+            /**
+             * A deferred construction of a single catchment formulation
+             */
+            struct formulation_builder {
+                std::function<std::shared_ptr<Catchment_Formulation>()> build;
+                //! Whether this formulation may be constructed at the same time as others
+                bool thread_safe;
+            };
+
+            /**
+             * Whether a formulation runs a Python BMI module, itself or nested in a multi-BMI formulation
+             */
+            static bool uses_python(const realization::config::Formulation& formulation) {
+                if (formulation.type == "bmi_python") {
+                    return true;
+                }
+
+                for (const auto& nested : formulation.nested) {
+                    if (uses_python(nested)) {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * Whether a forcing configuration uses a provider that calls into Python, i.e. the Forcings Engine
+             */
+            static bool uses_python(const realization::config::Forcing& forcing) {
+                return forcing.has_key("provider")
+                    && forcing.parameters.at("provider").as_string() == "ForcingsEngineLumpedDataProvider";
+            }
+
+            /**
+             * Whether a formulation can be constructed concurrently with other formulations
+             *
+             * C, C++, and Fortran BMI modules are each constructed with their own model instance and
+             * forcing provider, so they can be built in parallel. Python modules need the interpreter
+             * and must be built on the main thread, as must any multi-BMI formulation nesting one, and
+             * any formulation forced by the Forcings Engine.
+             *
+             * @param config The catchment configuration
+             * @return Whether the formulation may be built on a worker thread
+             */
+            static bool constructs_concurrently(const realization::config::Config& config) {
+                return !uses_python(config.formulation) && !uses_python(config.forcing);
+            }
+
+            /**
+             * The number of threads to construct formulations with
+             *
+             * Taken from the optional `init_threads` key of the realization config. By default,
+             * formulations are built serially: nodes are often shared, or already filled with MPI
+             * ranks, so using more cores is left for the run to ask for.
+             */
+            std::size_t get_init_threads() const {
+                const auto init_threads = this->tree.get_optional<std::size_t>("init_threads");
+                if (init_threads != boost::none) {
+                    return std::max<std::size_t>(*init_threads, 1);
+                }
+
+                return 1;
+            }
+
+            /**
+             * Run a set of formulation builders
+             *
+             * Thread-safe builders are run on a thread pool while the rest run in order on the calling
+             * thread. Results are returned in the order of @p builders. Once any builder throws, builders
+             * not yet started are skipped, and the exception of the first builder in order to have thrown
+             * is rethrown.
+             *
+             * @param builders The formulations to construct
+             * @return The constructed formulations, in the same order as @p builders
+             */
+            std::vector<std::shared_ptr<Catchment_Formulation>> construct_formulations(std::vector<formulation_builder>& builders) {
+                const auto time_start = std::chrono::steady_clock::now();
+
+                std::size_t concurrent = 0;
+                for (const auto& builder : builders) {
+                    concurrent += builder.thread_safe ? 1 : 0;
+                }
+                const std::size_t threads = concurrent > 1 ? std::min(get_init_threads(), concurrent) : 1;
+
+                std::vector<std::future<std::shared_ptr<Catchment_Formulation>>> results;
+                results.reserve(builders.size());
+                // Declared before the pool, which runs or skips every queued builder before it is freed
+                std::atomic<bool> cancelled{false};
+                {
+                    std::unique_ptr<ngen::thread_pool> pool;
+                    if (threads > 1) {
+                        pool = std::make_unique<ngen::thread_pool>(threads);
+                        for (auto& builder : builders) {
+                            if (builder.thread_safe) {
+                                // Nest the stages timed while building under the stage that called this
+                                results.push_back(pool->submit(
+                                    [&parent = ngen::profiling::current(), &cancelled, build = std::move(builder.build)]() -> std::shared_ptr<Catchment_Formulation> {
+                                        if (cancelled) {
+                                            return nullptr;
+                                        }
+
+                                        ngen::profiling::adopted_scope scope(parent);
+                                        try {
+                                            return build();
+                                        }
+                                        catch (...) {
+                                            cancelled = true;
+                                            throw;
+                                        }
+                                    }
+                                ));
+                            }
+                            else {
+                                results.emplace_back();
+                            }
+                        }
+                    }
+                    else {
+                        results.resize(builders.size());
+                    }
+
+                    // Builders left for this thread are run while the pool works through the others
+                    for (std::size_t i = 0; i < builders.size() && !cancelled; i++) {
+                        if (results[i].valid()) {
+                            continue;
+                        }
+
+                        std::promise<std::shared_ptr<Catchment_Formulation>> result;
+                        results[i] = result.get_future();
+                        try {
+                            result.set_value(builders[i].build());
+                        }
+                        catch (...) {
+                            if (pool == nullptr) {
+                                throw;
+                            }
+                            // Let the pool skip what is left, then rethrow in order below
+                            result.set_exception(std::current_exception());
+                            cancelled = true;
+                            break;
+                        }
+                    }
+                }
+
+                std::vector<std::shared_ptr<Catchment_Formulation>> constructed;
+                constructed.reserve(results.size());
+                for (auto& result : results) {
+                    // Builders skipped after a failure leave no result, or a null one, but the failure
+                    // is always among the results and is rethrown before they are returned
+                    if (result.valid()) {
+                        constructed.push_back(result.get());
+                    }
+                }
+
+                #ifndef NGEN_QUIET
+                const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_start;
+                std::cout << "Constructed " << constructed.size() << " formulations in " << elapsed.count()
+                          << " seconds using " << threads << (threads == 1 ? " thread" : " threads") << std::endl;
+                #endif
+
+                return constructed;
+            }
+
             std::shared_ptr<Catchment_Formulation> construct_formulation_from_config(
                 simulation_time_params &simulation_time_config,
                 std::string identifier,
@@ -373,23 +599,10 @@ namespace realization {
 
             std::shared_ptr<Catchment_Formulation> construct_missing_formulation(geojson::Feature& feature, utils::StreamHandler output_stream, simulation_time_params &simulation_time_config){
                 const std::string identifier = feature->get_id();
-  
+
                 forcing_params forcing_config = this->get_forcing_params(global_config.forcing.parameters, identifier, simulation_time_config);
-                std::shared_ptr<Catchment_Formulation> missing_formulation = construct_formulation(global_config.formulation.type, identifier, forcing_config, output_stream);
-                // Need to work with a copy, since it is altered in-place
-                realization::config::Config global_copy = global_config;
-                Catchment_Formulation::config_pattern_substitution(global_copy.formulation.parameters,
-                                                                   BMI_REALIZATION_CFG_PARAM_REQ__INIT_CONFIG, "{{id}}",
-                                                                   identifier);
-                //Some helpful debugging prints, commented out, but left for later
-                //because they will eventually be used by someone, someday, looking at configurations
-                //being turned into concrecte formulations...
-                // geojson::JSONProperty::print_property(global_config.formulation.parameters.at("modules"));
-
-                //Make a copy of the global configuration so parameters don't clash when linking to external data
-                auto formulation =  realization::config::Formulation(global_config.formulation);
-                formulation.link_external(feature);
-                missing_formulation->create_formulation(formulation.parameters);
+                std::shared_ptr<Catchment_Formulation> missing_formulation = construct_formulation(global_formulation.get_type(), identifier, forcing_config, output_stream);
+                missing_formulation->create_formulation(global_formulation.instantiate(feature));
 
                 return missing_formulation;
             }
@@ -403,13 +616,24 @@ namespace realization {
                 if(forcing_prop_map.count("provider") != 0){
                     provider = forcing_prop_map.at("provider").as_string();
                 }
+                std::string geometry_path;
+                if(forcing_prop_map.count("geometry_path") != 0){
+                    geometry_path = forcing_prop_map.at("geometry_path").as_string();
+                }
+                bool lookahead = false;
+                if(forcing_prop_map.count("lookahead") != 0){
+                    lookahead = forcing_prop_map.at("lookahead").as_boolean();
+                }
                 if (forcing_prop_map.count("file_pattern") == 0) {
-                    return forcing_params(
+                    forcing_params params(
                         path,
                         provider,
                         simulation_time_config.start_time,
                         simulation_time_config.end_time
                     );
+                    params.geometry_path = geometry_path;
+                    params.lookahead = lookahead;
+                    return params;
                 }
 
                 if (path.empty()) {
@@ -422,118 +646,72 @@ namespace realization {
                     path += "/";
                 }
 
-                std::string filepattern = forcing_prop_map.at("file_pattern").as_string();
-
-                int id_index = filepattern.find("{{id}}");
-
-                // If an index for '{{id}}' was found, we can count on that being where the id for this realization can be found.
+                // If the pattern contains '{{id}}', we can count on that being where the id for this realization can be found.
                 //     For instance, if we have a pattern of '.*{{id}}_14_15.csv' and this is named 'cat-87',
                 //     this will match on 'stuff_example_cat-87_14_15.csv'
-                if (id_index != std::string::npos) {
-                    filepattern = filepattern.replace(id_index, sizeof("{{id}}") - 1, identifier);
-                }
-
-                // Create a regular expression used to identify proper file names
-                std::regex pattern(filepattern);
-
-                // A stream providing the functions necessary for evaluating a directory:
-                //    https://www.gnu.org/software/libc/manual/html_node/Opening-a-Directory.html#Opening-a-Directory
-                DIR *directory = nullptr;
-
-                // structure representing the member of a directory: https://www.gnu.org/software/libc/manual/html_node/Directory-Entries.html
-                struct dirent *entry = nullptr;
-
-                // Attempt to open the directory for evaluation
-                directory = opendir(path.c_str());
-                // Allow for a few retries in certain failure situations
-                size_t attemptCount = 0;
-                std::string errMsg;
-                while (directory == nullptr && attemptCount++ < 5) {
-                    // For several error codes, we should break immediately and not retry
-                    if (errno == ENOENT) {
-                        errMsg = "No such file or directory.";
-                        break;
-                    }
-                    if (errno == ENXIO) {
-                        errMsg = "No such device or address.";
-                        break;
-                    }
-                    if (errno == EACCES) {
-                        errMsg = "Permission denied.";
-                        break;
-                    }
-                    if (errno == EPERM) {
-                        errMsg = "Operation not permitted.";
-                        break;
-                    }
-                    if (errno == ENOTDIR) {
-                        errMsg = "File at provided path is not a directory.";
-                        break;
-                    }
-                    if (errno == EMFILE) {
-                        errMsg = "The current process has too many open files.";
-                        break;
-                    }
-                    if (errno == ENFILE) {
-                        errMsg = "The system has too many open files.";
-                        break;
-                    }
-                    sleep(2);
-                    directory = opendir(path.c_str());
-                    errMsg = "Received system error number " + std::to_string(errno);
-                }
-
-                // If the directory could be found and opened, we can go ahead and iterate
-                if (directory != nullptr) {
-                    bool match;
-                    while ((entry = readdir(directory))) {
-                        match = std::regex_match(entry->d_name, pattern);
-                        if( match ) {
-                            // If the entry is a regular file or symlink AND the name matches the pattern, 
-                            //    we can consider this ready to be interpretted as valid forcing data (even if it isn't)
-                            #ifdef _DIRENT_HAVE_D_TYPE
-                            if ( entry->d_type == DT_REG or entry->d_type == DT_LNK ) {
-                                return forcing_params(
-                                    path + entry->d_name,
-                                    provider,
-                                    simulation_time_config.start_time,
-                                    simulation_time_config.end_time
-                                );
-                            }
-                            else if ( entry->d_type == DT_UNKNOWN )
-                            #endif
-                            {
-                                //dirent is not guaranteed to provide propoer file type identification in d_type
-                                //so if a system returns unknown or it isn't supported, need to use stat to determine if it is a file
-                                struct stat st;
-                                if( stat((path+entry->d_name).c_str(), &st) != 0) {
-                                    throw std::runtime_error("Could not stat file "+path+entry->d_name);
-                                }
-                                if( S_ISREG(st.st_mode) ) {
-                                    //Sinde we used stat and not lstat, we get the result of the target of links as well
-                                    //so this covers both cases we are interested in.
-                                    return forcing_params(
-                                        path + entry->d_name,
-                                        provider,
-                                        simulation_time_config.start_time,
-                                        simulation_time_config.end_time
-                                    );
-                                }
-                                throw std::runtime_error("Forcing data is path "+path+entry->d_name+" is not a file");
-                            }
-                        } //no match found, try next entry
-                    } // end while iter dir
-                } //end if directory
-                else {
-                    // The directory wasn't found or otherwise couldn't be opened; forcing data cannot be retrieved
-                    throw std::runtime_error("Error opening forcing data dir '" + path + "' after " + std::to_string(attemptCount) + " attempts: " + errMsg);
-                }
+                std::string forcing_file = get_forcing_file_index(path, forcing_prop_map.at("file_pattern").as_string())->find(identifier);
 
-                closedir(directory);
+                if (!forcing_file.empty()) {
+                    forcing_params params(
+                        forcing_file,
+                        provider,
+                        simulation_time_config.start_time,
+                        simulation_time_config.end_time
+                    );
+                    params.geometry_path = geometry_path;
+                    params.lookahead = lookahead;
+                    return params;
+                }
 
                 throw std::runtime_error("Forcing data could not be found for '" + identifier + "'");
             }
 
+            /**
+             * Read the directory of a forcing configuration that uses `file_pattern` ahead of the formulations
+             * that need it, so that each catchment finds its forcing file with a lookup rather than a full
+             * scan of the directory.
+             *
+             * Configurations without a pattern, or without the path the pattern applies to, are left for
+             * get_forcing_params to handle and report.
+             *
+             * @param forcing_prop_map The forcing configuration
+             */
+            void index_forcing_files(const geojson::PropertyMap &forcing_prop_map) {
+                if (forcing_prop_map.count("file_pattern") == 0 || forcing_prop_map.count("path") == 0) {
+                    return;
+                }
+
+                std::string path = forcing_prop_map.at("path").as_string();
+                if (path.empty()) {
+                    return;
+                }
+                if (path.back() != '/') {
+                    path += "/";
+                }
+
+                const std::string filepattern = forcing_prop_map.at("file_pattern").as_string();
+                const std::string key = path + '\n' + filepattern;
+                if (forcing_file_indexes.count(key) == 0) {
+                    ngen::profiling::scoped_timer index_timer("forcing_index");
+                    forcing_file_indexes.emplace(key, std::make_shared<utils::FilePatternIndex>(path, filepattern));
+                }
+            }
+
+            /**
+             * Get the index of a forcing directory for a file pattern
+             *
+             * Indexes read by index_forcing_files are shared; any other directory is read for this call alone.
+             * The set of shared indexes is only changed outside of formulation construction, so this is safe
+             * to call from several threads at once.
+             */
+            std::shared_ptr<const utils::FilePatternIndex> get_forcing_file_index(const std::string &path, const std::string &filepattern) const {
+                const auto index = forcing_file_indexes.find(path + '\n' + filepattern);
+                if (index != forcing_file_indexes.end()) {
+                    return index->second;
+                }
+                return std::make_shared<utils::FilePatternIndex>(path, filepattern);
+            }
+
             /**
              * @brief Parse a `model_params` property tree and replace external parameters
              *        with values from a catchment's properties
@@ -662,6 +840,9 @@ namespace realization {
 
             realization::config::Config global_config;
 
+            //The global formulation, prepared for the catchments without a configuration of their own
+            realization::config::FormulationTemplate global_formulation;
+
             std::map<std::string, std::shared_ptr<Catchment_Formulation>> formulations;
 
             //Store global layer formulation pointers
@@ -671,7 +852,12 @@ namespace realization {
 
             bool using_routing = false;
 
+            bool using_python_models = false;
+
             ngen::LayerDataStorage layer_storage;
+
+            //Forcing directories read while formulations are constructed, keyed by path and file pattern
+            std::map<std::string, std::shared_ptr<const utils::FilePatternIndex>> forcing_file_indexes;
     };
 }
 #endif // NGEN_FORMULATION_MANAGER_H
@@ -3,9 +3,14 @@
 
 #include <NGenConfig.h>
 #include <boost/property_tree/ptree.hpp>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "JSONProperty.hpp"
+#include "features/FeatureBase.hpp"
 
 #if NGEN_WITH_MPI
 #include <mpi.h>
@@ -72,76 +77,192 @@ namespace realization{
 
     /**
      * @brief Link formulation parameters to hydrofabric data held in feature
-     * 
+     *
+     * The parameters are built by a @ref FormulationTemplate of this formulation, and the
+     * nested formulations of a bmi_multi take the linked parameters of their modules.
+     *
      * @param feature Hydrofabric feature with properties to assign to formulation
      *                model params
      */
-    void link_external(geojson::Feature feature){
+    void link_external(geojson::Feature feature);
+  };
+
+  /**
+   * @brief A Formulation prepared once for instantiation over many catchments
+   *
+   * Every catchment without its own configuration shares the global Formulation, differing only
+   * in the model parameters linked to its hydrofabric attributes. The template resolves which
+   * parameters are linked, and to which attributes, when it is created, and shares the parameters
+   * that are the same for every catchment. Instantiating it for a feature builds the catchment's
+   * parameters in a single pass. Formulation::link_external links a formulation through a template of
+   * its own, so the two always agree.
+   */
+  class FormulationTemplate{
+    public:
+
+    /**
+     * @brief Construct an empty template, with an "" type and no parameters
+     */
+    FormulationTemplate() = default;
+
+    /**
+     * @brief Construct a template from a formulation
+     *
+     * @param formulation formulation to instantiate
+     * @throws std::logic_error if a model parameter names a source other than `hydrofabric`
+     */
+    explicit FormulationTemplate(const Formulation& formulation)
+        : type(formulation.type)
+    {
+        geojson::PropertyMap shared = formulation.parameters;
 
         if(type == "bmi_multi"){
-            std::vector<geojson::JSONProperty> tmp;
-            for(auto& n : nested){
-                //Iterate and link any nested modules with this feature
-                if(n.parameters.count("model_params")){
-                    n.link_external(feature);
+            for(const auto& n : formulation.nested){
+                nested.emplace_back(n);
+                // Formulation::link_external leaves nested formulations without model params as they are
+                if(n.parameters.count("model_params") == 0){
+                    nested.back().links_external = false;
                 }
-                //Need a temporary map to hold the updated formulation properties in
-                geojson::PropertyMap map = {};
-                map.emplace("name", geojson::JSONProperty("name", n.type));
-                map.emplace("params", geojson::JSONProperty("", n.parameters));
-                tmp.push_back(geojson::JSONProperty("", map));
+                links_external = links_external || nested.back().links_external;
+                modules.push_back(nested.back().module(nullptr));
             }
-            //Reset the bmi_multi modules with the now linked module definitions
-            parameters.at("modules") = geojson::JSONProperty("modules", tmp);
-            return;
+            // The modules are always rebuilt from the nested formulations, even when none are linked
+            shared.at("modules") = geojson::JSONProperty("modules", modules);
         }
-        //Short circut
-        if(parameters.count("model_params") < 1 ) return;
-        //Have some model params, check to see if any should be linked to the hyrdofabric feature
-        geojson::PropertyMap attr = parameters.at("model_params").get_values();
-        for (decltype(auto) param : attr) {
-            // Check for type to short-circuit. If param.second is not an object, `.has_key()` will throw
-            if (param.second.get_type() != geojson::PropertyType::Object || !param.second.has_key("source")) {
-                attr.emplace(param.first, param.second);
-                continue;
+        else if(shared.count("model_params") > 0){
+            model_params = shared.at("model_params").get_values();
+            for(const auto& param : model_params){
+                if(param.second.get_type() != geojson::PropertyType::Object || !param.second.has_key("source")){
+                    continue;
+                }
+
+                const std::string param_source_name = param.second.at("source").as_string();
+                if(param_source_name != "hydrofabric"){
+                    // TODO: temporary until the logic for alternative sources is designed
+                    throw std::logic_error("ERROR: 'model_params' source `" + param_source_name + "` not currently supported. Only `hydrofabric` is supported.");
+                }
+
+                // Property name in the feature properties is either the value of key "from",
+                // or has the same name as the expected model parameter key
+                linked_params.push_back({
+                    param.first,
+                    param.second.has_key("from") ? param.second.at("from").as_string() : param.first
+                });
             }
-        
-            decltype(auto) param_source = param.second.at("source");
-            decltype(auto) param_source_name = param_source.as_string();
-            if (param_source_name != "hydrofabric") {
-                // TODO: temporary until the logic for alternative sources is designed
-                throw std::logic_error("ERROR: 'model_params' source `" + param_source_name + "` not currently supported. Only `hydrofabric` is supported.");
+            links_external = !linked_params.empty();
+        }
+
+        parameters = std::make_shared<const geojson::PropertyMap>(std::move(shared));
+    }
+
+    /**
+     * @brief The type of the formulation
+     */
+    const std::string& get_type() const {
+        return type;
+    }
+
+    /**
+     * @brief Build the formulation parameters for a hydrofabric feature
+     *
+     * @param feature Hydrofabric feature with properties to assign to formulation model params
+     * @return The parameters, with model params linked to the feature
+     */
+    geojson::PropertyMap instantiate(const geojson::Feature& feature) const {
+        if(!links_external){
+            return *parameters;
+        }
+
+        // Copy everything but the value that is rebuilt for this feature
+        const std::string rebuilt = type == "bmi_multi" ? "modules" : "model_params";
+        geojson::PropertyMap properties;
+        for(const auto& parameter : *parameters){
+            if(parameter.first != rebuilt){
+                properties.emplace_hint(properties.end(), parameter.first, parameter.second);
             }
+        }
 
-            // Property name in the feature properties is either
-            // the value of key "from", or has the same name as
-            // the expected model parameter key
-            decltype(auto) param_name = param.second.has_key("from")
-                ? param.second.at("from").as_string()
-                : param.first;
-
-            if (feature->has_property(param_name)) {
-                auto catchment_attribute = feature->get_property(param_name);
-
-                // Use param.first in the `.emplace` calls instead of param_name since
-                // the expected name is given by the key of the model_params values.
-                switch (catchment_attribute.get_type()) {
-                    case geojson::PropertyType::List:
-                    case geojson::PropertyType::Object:
-                        // TODO: Should list/object values be passed to model parameters?
-                        //       Typically, feature properties *should* be scalars.
-                        std::cerr << "WARNING: property type " << static_cast<int>(catchment_attribute.get_type()) << " not allowed as model parameter. "
-                                    << "Must be one of: Natural (int), Real (double), Boolean, or String" << '\n';
-                        break;
-                    default:
-                        attr.at(param.first) = geojson::JSONProperty(param.first, catchment_attribute);
+        if(type == "bmi_multi"){
+            std::vector<geojson::JSONProperty> linked_modules;
+            linked_modules.reserve(nested.size());
+            for(std::size_t i = 0; i < nested.size(); ++i){
+                if(nested[i].links_external){
+                    linked_modules.push_back(nested[i].module(&feature));
+                }
+                else{
+                    linked_modules.push_back(modules[i]);
                 }
             }
+            properties.emplace("modules", geojson::JSONProperty("modules", std::move(linked_modules)));
+            return properties;
+        }
+
+        geojson::PropertyMap attr = model_params;
+        for(const auto& link : linked_params){
+            if(!feature->has_property(link.attribute)){
+                continue;
+            }
+
+            auto catchment_attribute = feature->get_property(link.attribute);
+            switch (catchment_attribute.get_type()) {
+                case geojson::PropertyType::List:
+                case geojson::PropertyType::Object:
+                    // TODO: Should list/object values be passed to model parameters?
+                    //       Typically, feature properties *should* be scalars.
+                    std::cerr << "WARNING: property type " << static_cast<int>(catchment_attribute.get_type()) << " not allowed as model parameter. "
+                                << "Must be one of: Natural (int), Real (double), Boolean, or String" << '\n';
+                    break;
+                default:
+                    attr.at(link.name) = geojson::JSONProperty(link.name, catchment_attribute);
+            }
         }
-        parameters.at("model_params") = geojson::JSONProperty("model_params", attr);
+        properties.emplace("model_params", geojson::JSONProperty("model_params", std::move(attr)));
+        return properties;
+    }
+
+    private:
+
+    //! A model parameter taking its value from a hydrofabric attribute
+    struct linked_param{
+        std::string name;
+        std::string attribute;
+    };
+
+    std::string type;
+    //Parameters shared by every instantiation
+    std::shared_ptr<const geojson::PropertyMap> parameters = std::make_shared<const geojson::PropertyMap>();
+    //Whether any parameter depends on the feature
+    bool links_external = false;
+    geojson::PropertyMap model_params;
+    std::vector<linked_param> linked_params;
+    std::vector<FormulationTemplate> nested;
+    //Module definitions of the nested formulations, as they are before linking
+    std::vector<geojson::JSONProperty> modules;
+
+    /**
+     * @brief Build the module definition of this formulation, as a nested formulation of a bmi_multi
+     *
+     * @param feature Feature to link the parameters to, or nullptr to leave them unlinked
+     */
+    geojson::JSONProperty module(const geojson::Feature* feature) const {
+        geojson::PropertyMap map = {};
+        map.emplace("name", geojson::JSONProperty("name", type));
+        map.emplace("params", geojson::JSONProperty("", feature == nullptr ? geojson::PropertyMap(*parameters) : instantiate(*feature)));
+        return geojson::JSONProperty("", std::move(map));
     }
   };
 
+  inline void Formulation::link_external(geojson::Feature feature){
+    parameters = FormulationTemplate(*this).instantiate(feature);
+
+    if(type == "bmi_multi"){
+        const std::vector<geojson::JSONProperty> modules = parameters.at("modules").as_list();
+        for(std::size_t i = 0; i < nested.size(); ++i){
+            nested[i].parameters = modules[i].at("params").get_values();
+        }
+    }
+  }
+
   }//end namespace config
 }//end namespace realization
 #endif //NGEN_REALIZATION_CONFIG_FORMULATION_H
@@ -0,0 +1,46 @@
+#ifndef NGEN_REALIZATION_CONFIG_TRACE_H
+#define NGEN_REALIZATION_CONFIG_TRACE_H
+
+#include <limits>
+#include <string>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace realization{
+  namespace config{
+
+    /**
+     * @brief Timeline trace settings, from the optional `trace` object of the realization config
+     *
+     * @code{.json}
+     * "trace": {
+     *     "path": "ngen_trace.json",
+     *     "start_step": 100,
+     *     "end_step": 200,
+     *     "buffer_events": 1000000
+     * }
+     * @endcode
+     *
+     * All keys are optional. A relative path is taken from the output root. Time steps from
+     * start_step up to, but not including, end_step are traced; by default, the whole run.
+     */
+    struct Trace{
+        std::string path = "ngen_trace.json";
+        long start_step = 0;
+        long end_step = std::numeric_limits<long>::max();
+        //Number of events kept per thread, beyond which the oldest are dropped
+        std::size_t buffer_events = 1000000;
+
+        Trace() = default;
+
+        Trace(const boost::property_tree::ptree& tree){
+            path = tree.get("path", path);
+            start_step = tree.get("start_step", start_step);
+            end_step = tree.get("end_step", end_step);
+            buffer_events = tree.get("buffer_events", buffer_events);
+        }
+    };
+
+  }//end namespace config
+}//end namespace realization
+#endif //NGEN_REALIZATION_CONFIG_TRACE_H
@@ -0,0 +1,272 @@
+#ifndef NGEN_FILE_PATTERN_INDEX_HPP
+#define NGEN_FILE_PATTERN_INDEX_HPP
+
+#include <cerrno>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/algorithm/string/replace.hpp>
+
+namespace utils {
+
+    /**
+     * Index of the files in a directory whose names follow a pattern containing an `{{id}}` placeholder.
+     *
+     * A name matches for an id when it fully matches the pattern, read as a regular expression, with the
+     * first `{{id}}` replaced by the id. Looking each id up by matching every name in the directory
+     * against its own regular expression is quadratic in the number of ids, so the directory is read and
+     * indexed once, on construction: each name is matched against the pattern with `{{id}}` replaced by a
+     * capture group, and indexed by the id it captures. A lookup is then a hash lookup, and the index is
+     * only read afterwards, so lookups may be made from several threads at once.
+     *
+     * Where the rest of the pattern does not pin down where the id sits in a name (e.g. `.*{{id}}.*\.csv`),
+     * the captured id may not be the one looked up. An id with no file in the index is therefore matched
+     * in full against the names of the directory, so results are the same as a full scan up to the order
+     * in which the directory happens to list its files.
+     */
+    class FilePatternIndex {
+    public:
+
+        /**
+         * Read and index a directory.
+         *
+         * @param directory Path to the directory, ending with a '/'
+         * @param pattern The file name pattern, a regular expression that may contain `{{id}}`
+         * @throws std::runtime_error if the directory cannot be opened after a few retries
+         * @throws std::regex_error if the pattern is not a valid regular expression
+         */
+        FilePatternIndex(std::string directory, std::string pattern)
+            : directory(std::move(directory)), pattern(std::move(pattern))
+        {
+            read_directory();
+
+            const std::size_t id_index = this->pattern.find(placeholder);
+            has_id = id_index != std::string::npos;
+            const std::regex name_pattern(has_id ? boost::algorithm::replace_first_copy(this->pattern, placeholder, "(.+?)") : this->pattern);
+            const std::size_t id_group = has_id ? 1 + capture_groups(this->pattern.substr(0, id_index)) : 0;
+
+            std::smatch match;
+            for (std::size_t i = 0; i < entries.size(); i++) {
+                if (!std::regex_match(entries[i].name, match, name_pattern)) {
+                    continue;
+                }
+                if (has_id) {
+                    index[match[id_group].str()].push_back(i);
+                }
+                else {
+                    matching.push_back(i);
+                }
+            }
+        }
+
+        FilePatternIndex(const FilePatternIndex&) = delete;
+        FilePatternIndex& operator=(const FilePatternIndex&) = delete;
+
+        /**
+         * Find the file matching the pattern for an id.
+         *
+         * @param id The id to substitute into the pattern
+         * @return The path (directory and file name) of the first matching regular file or link, or an
+         *         empty string if there is none
+         * @throws std::runtime_error if a matching entry of unknown type turns out not to be a regular file
+         */
+        std::string find(const std::string& id) const {
+            if (!has_id) {
+                // The pattern does not depend on the id, so every id resolves to the same file
+                return first_accepted(matching);
+            }
+
+            const auto candidates = index.find(id);
+            if (candidates != index.end()) {
+                std::string path = first_accepted(candidates->second);
+                if (!path.empty()) {
+                    return path;
+                }
+            }
+
+            return full_match(id);
+        }
+
+    private:
+
+        struct entry_t {
+            std::string name;
+            unsigned char type;
+        };
+
+        void read_directory() {
+            // A stream providing the functions necessary for evaluating a directory:
+            //    https://www.gnu.org/software/libc/manual/html_node/Opening-a-Directory.html#Opening-a-Directory
+            DIR *dir = opendir(directory.c_str());
+            // Allow for a few retries in certain failure situations
+            size_t attemptCount = 0;
+            std::string errMsg;
+            while (dir == nullptr && attemptCount++ < 5) {
+                // For several error codes, we should break immediately and not retry
+                if (errno == ENOENT) {
+                    errMsg = "No such file or directory.";
+                    break;
+                }
+                if (errno == ENXIO) {
+                    errMsg = "No such device or address.";
+                    break;
+                }
+                if (errno == EACCES) {
+                    errMsg = "Permission denied.";
+                    break;
+                }
+                if (errno == EPERM) {
+                    errMsg = "Operation not permitted.";
+                    break;
+                }
+                if (errno == ENOTDIR) {
+                    errMsg = "File at provided path is not a directory.";
+                    break;
+                }
+                if (errno == EMFILE) {
+                    errMsg = "The current process has too many open files.";
+                    break;
+                }
+                if (errno == ENFILE) {
+                    errMsg = "The system has too many open files.";
+                    break;
+                }
+                sleep(2);
+                dir = opendir(directory.c_str());
+                errMsg = "Received system error number " + std::to_string(errno);
+            }
+
+            if (dir == nullptr) {
+                // The directory wasn't found or otherwise couldn't be opened; forcing data cannot be retrieved
+                throw std::runtime_error("Error opening forcing data dir '" + directory + "' after " + std::to_string(attemptCount) + " attempts: " + errMsg);
+            }
+
+            // structure representing the member of a directory: https://www.gnu.org/software/libc/manual/html_node/Directory-Entries.html
+            struct dirent *entry = nullptr;
+            while ((entry = readdir(dir))) {
+                #ifdef _DIRENT_HAVE_D_TYPE
+                entries.push_back({entry->d_name, entry->d_type});
+                #else
+                entries.push_back({entry->d_name, DT_UNKNOWN});
+                #endif
+            }
+
+            closedir(dir);
+        }
+
+        /**
+         * Count the capturing groups opened in a part of a regular expression
+         */
+        static std::size_t capture_groups(const std::string& expression) {
+            std::size_t groups = 0;
+            bool bracket = false;
+            for (std::size_t i = 0; i < expression.size(); i++) {
+                if (expression[i] == '\\') {
+                    i++;
+                }
+                else if (bracket) {
+                    bracket = expression[i] != ']';
+                }
+                else if (expression[i] == '[') {
+                    bracket = true;
+                    // A ']' first in a bracket expression is one of its characters
+                    if (i + 1 < expression.size() && expression[i + 1] == '^') {
+                        i++;
+                    }
+                    if (i + 1 < expression.size() && expression[i + 1] == ']') {
+                        i++;
+                    }
+                }
+                else if (expression[i] == '(' && (i + 1 == expression.size() || expression[i + 1] != '?')) {
+                    groups++;
+                }
+            }
+            return groups;
+        }
+
+        /**
+         * The path of an entry whose name matches, or an empty string if it is not a file
+         */
+        std::string accept(std::size_t i) const {
+            const entry_t& entry = entries[i];
+            // If the entry is a regular file or symlink AND the name matches the pattern,
+            //    we can consider this ready to be interpretted as valid forcing data (even if it isn't)
+            if (entry.type == DT_REG || entry.type == DT_LNK) {
+                return directory + entry.name;
+            }
+            if (entry.type != DT_UNKNOWN) {
+                return "";
+            }
+
+            //dirent is not guaranteed to provide propoer file type identification in d_type
+            //so if a system returns unknown or it isn't supported, need to use stat to determine if it is a file
+            struct stat st;
+            if (stat((directory + entry.name).c_str(), &st) != 0) {
+                throw std::runtime_error("Could not stat file " + directory + entry.name);
+            }
+            if (S_ISREG(st.st_mode)) {
+                //Since we used stat and not lstat, we get the result of the target of links as well
+                //so this covers both cases we are interested in.
+                return directory + entry.name;
+            }
+            throw std::runtime_error("Forcing data is path " + directory + entry.name + " is not a file");
+        }
+
+        std::string first_accepted(const std::vector<std::size_t>& candidates) const {
+            for (std::size_t i : candidates) {
+                std::string path = accept(i);
+                if (!path.empty()) {
+                    return path;
+                }
+            }
+            return "";
+        }
+
+        /**
+         * Match every name against the pattern for an id, for ids the index does not resolve
+         */
+        std::string full_match(const std::string& id) const {
+            std::string filepattern = pattern;
+            filepattern.replace(filepattern.find(placeholder), placeholder.size(), id);
+            const std::regex name_pattern(filepattern);
+
+            // An id without special characters matches only itself, so names without it are skipped
+            const bool literal = id.find_first_of("\\^$.|?*+()[]{}") == std::string::npos;
+            for (std::size_t i = 0; i < entries.size(); i++) {
+                if (literal && entries[i].name.find(id) == std::string::npos) {
+                    continue;
+                }
+                if (std::regex_match(entries[i].name, name_pattern)) {
+                    std::string path = accept(i);
+                    if (!path.empty()) {
+                        return path;
+                    }
+                }
+            }
+            return "";
+        }
+
+        const std::string placeholder = "{{id}}";
+
+        std::string directory;
+        std::string pattern;
+        bool has_id = false;
+        std::vector<entry_t> entries;
+
+        //! Entries matching the pattern, by the id each captures, in directory order
+        std::unordered_map<std::string, std::vector<std::size_t>> index;
+
+        //! Entries matching a pattern without `{{id}}`, in directory order
+        std::vector<std::size_t> matching;
+    };
+
+}
+
+#endif // NGEN_FILE_PATTERN_INDEX_HPP
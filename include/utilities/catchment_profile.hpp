@@ -0,0 +1,289 @@
+#ifndef NGEN_UTILITIES_CATCHMENT_PROFILE_HPP
+#define NGEN_UTILITIES_CATCHMENT_PROFILE_HPP
+
+#include <NGenConfig.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * Time a section of a catchment's work until the end of the enclosing scope.
+ *
+ * Takes the catchment's row and the section's column, resolved ahead of the time
+ * loop with catchment_profile::row and catchment_profile::column. Expands to
+ * nothing unless built with NGEN_WITH_PROFILING, so neither the timing nor the
+ * evaluation of its arguments costs anything otherwise.
+ */
+#if NGEN_WITH_PROFILING
+#define NGEN_PROFILE_CONCAT_(a, b) a##b
+#define NGEN_PROFILE_CONCAT(a, b) NGEN_PROFILE_CONCAT_(a, b)
+#define NGEN_PROFILE_CATCHMENT(row, column) \
+    ::ngen::profiling::catchment_section NGEN_PROFILE_CONCAT(ngen_profile_section_, __LINE__)(row, column)
+#else
+#define NGEN_PROFILE_CATCHMENT(row, column) ((void)0)
+#endif
+
+namespace ngen {
+namespace profiling {
+
+/**
+ * Read the processor's cycle counter, or a nanosecond clock on processors without one
+ */
+inline std::uint64_t read_cycle_counter() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+#endif
+}
+
+/**
+ * Cycles spent in each section of each catchment's work during the time loop.
+ *
+ * Rows are catchments and columns are sections: the fixed columns below, plus one
+ * for each kind of nested module of a multi-module formulation. Sections may
+ * overlap; a nested module's time is also part of its catchment's response.
+ *
+ * Rows and columns are resolved by name once, e.g. as formulations and layers are
+ * built, which may be done from several threads at once. Recording uses only
+ * their indices, is not synchronized, and must be done from the thread running
+ * the time loop, once no more rows or columns are being added.
+ */
+class catchment_profile
+{
+  public:
+    //! The columns every profile has
+    enum : std::size_t
+    {
+        //! Catchment_Formulation::get_response, as called by its layer
+        response     = 0,
+        //! Setting a BMI module's inputs before an update
+        set_inputs   = 1,
+        //! Formatting and writing a catchment's output line
+        write_output = 2
+    };
+
+    catchment_profile()
+      : columns_{ "response", "set_inputs", "write_output" }
+      , start_cycles_(read_cycle_counter())
+      , start_time_(std::chrono::steady_clock::now())
+    {}
+
+    //! The profile of this process's time loop
+    static catchment_profile& instance()
+    {
+        static catchment_profile profile;
+        return profile;
+    }
+
+    /**
+     * Get the column for a section, adding it the first time it is named
+     */
+    std::size_t column(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(names_mutex_);
+        for (std::size_t i = 0; i < columns_.size(); i++) {
+            if (columns_[i] == name) {
+                return i;
+            }
+        }
+        columns_.push_back(name);
+        return columns_.size() - 1;
+    }
+
+    const std::vector<std::string>& columns() const
+    {
+        return columns_;
+    }
+
+    bool empty() const
+    {
+        return rows_.empty();
+    }
+
+    /**
+     * Get the row for a catchment, adding it the first time it is named
+     */
+    std::size_t row(const std::string& catchment)
+    {
+        std::lock_guard<std::mutex> lock(names_mutex_);
+        auto found = index_.find(catchment);
+        if (found == index_.end()) {
+            found = index_.emplace(catchment, rows_.size()).first;
+            rows_.emplace_back();
+            rows_.back().id = catchment;
+        }
+        return found->second;
+    }
+
+    void record(std::size_t row, std::size_t column, std::uint64_t cycles)
+    {
+        catchment_row& counters = rows_[row];
+        if (counters.cycles.size() <= column) {
+            counters.cycles.resize(column + 1, 0);
+            counters.calls.resize(column + 1, 0);
+        }
+        counters.cycles[column] += cycles;
+        counters.calls[column]++;
+    }
+
+    void record(const std::string& catchment, std::size_t column, std::uint64_t cycles)
+    {
+        record(row(catchment), column, cycles);
+    }
+
+    /**
+     * Cycles counted per second, measured over the life of the profile
+     */
+    double cycles_per_second() const
+    {
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time_;
+        const double cycles = static_cast<double>(read_cycle_counter() - start_cycles_);
+        return elapsed.count() > 0 && cycles > 0 ? cycles / elapsed.count() : 1e9;
+    }
+
+    /**
+     * Write one line per catchment, with the seconds spent in and calls made to each section
+     */
+    void write_csv(std::ostream& out) const
+    {
+        const double seconds_per_cycle = 1.0 / cycles_per_second();
+
+        out << "catchment";
+        for (const auto& name : columns_) {
+            out << ',' << name << "_seconds," << name << "_calls";
+        }
+        out << '\n' << std::setprecision(9);
+
+        for (const auto& counters : rows_) {
+            out << counters.id;
+            for (std::size_t i = 0; i < columns_.size(); i++) {
+                if (i < counters.cycles.size()) {
+                    out << ',' << counters.cycles[i] * seconds_per_cycle << ',' << counters.calls[i];
+                }
+                else {
+                    out << ",0,0";
+                }
+            }
+            out << '\n';
+        }
+    }
+
+    /**
+     * Summarize the time spent in each section, and in the catchments with the slowest responses
+     *
+     * @param out The stream to write to
+     * @param top The number of slowest catchments to list
+     */
+    void summarize(std::ostream& out, std::size_t top = 10) const
+    {
+        const double seconds_per_cycle = 1.0 / cycles_per_second();
+
+        std::vector<std::uint64_t> totals(columns_.size(), 0);
+        std::vector<std::pair<std::uint64_t, const std::string*>> responses;
+        responses.reserve(rows_.size());
+        for (const auto& counters : rows_) {
+            for (std::size_t i = 0; i < counters.cycles.size(); i++) {
+                totals[i] += counters.cycles[i];
+            }
+            responses.emplace_back(counters.cycles.empty() ? 0 : counters.cycles[response], &counters.id);
+        }
+        std::sort(responses.begin(), responses.end(), [](const auto& a, const auto& b) {
+            return a.first > b.first;
+        });
+
+        const auto percentile = [&](double p) {
+            if (responses.empty()) {
+                return 0.0;
+            }
+            // Responses are sorted slowest first
+            const std::size_t rank = static_cast<std::size_t>((1.0 - p) * (responses.size() - 1) + 0.5);
+            return responses[rank].first * seconds_per_cycle;
+        };
+
+        out << "NGen catchment runtime (" << rows_.size() << " catchments):"
+            << "\n\tseconds by section:";
+        for (std::size_t i = 0; i < columns_.size(); i++) {
+            out << "\n\t\t" << columns_[i] << ": " << totals[i] * seconds_per_cycle;
+        }
+        out << "\n\tresponse seconds per catchment:"
+            << "\n\t\tp50: " << percentile(0.5)
+            << "\n\t\tp90: " << percentile(0.9)
+            << "\n\t\tp99: " << percentile(0.99)
+            << "\n\t\tmax: " << percentile(1.0)
+            << "\n\tslowest catchments:";
+        const double total = totals[response] > 0 ? static_cast<double>(totals[response]) : 1.0;
+        for (std::size_t i = 0; i < std::min(top, responses.size()); i++) {
+            out << "\n\t\t" << *responses[i].second << ": " << responses[i].first * seconds_per_cycle
+                << " (" << std::fixed << std::setprecision(1) << 100.0 * responses[i].first / total << "%)"
+                << std::defaultfloat << std::setprecision(6);
+        }
+        out << std::endl;
+    }
+
+  private:
+    struct catchment_row
+    {
+        std::string                id;
+        std::vector<std::uint64_t> cycles;
+        std::vector<std::uint64_t> calls;
+    };
+
+    std::vector<std::string>                     columns_;
+    std::vector<catchment_row>                   rows_;
+    std::unordered_map<std::string, std::size_t> index_;
+    std::mutex                                   names_mutex_;
+    std::uint64_t                                start_cycles_;
+    std::chrono::steady_clock::time_point        start_time_;
+};
+
+/**
+ * Records the cycles spent in a section of a catchment's work while in scope.
+ *
+ * Use through NGEN_PROFILE_CATCHMENT, so that it is compiled out when profiling is disabled.
+ */
+class catchment_section
+{
+  public:
+    catchment_section(std::size_t row, std::size_t column)
+      : row_(row)
+      , column_(column)
+      , start_(read_cycle_counter())
+    {}
+
+    catchment_section(const catchment_section&)            = delete;
+    catchment_section& operator=(const catchment_section&) = delete;
+
+    ~catchment_section()
+    {
+        catchment_profile::instance().record(row_, column_, read_cycle_counter() - start_);
+    }
+
+  private:
+    std::size_t   row_;
+    std::size_t   column_;
+    std::uint64_t start_;
+};
+
+} // namespace profiling
+} // namespace ngen
+
+#endif // NGEN_UTILITIES_CATCHMENT_PROFILE_HPP
@@ -0,0 +1,306 @@
+#ifndef NGEN_UTILITIES_GRID_COVERAGE_HPP
+#define NGEN_UTILITIES_GRID_COVERAGE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <boost/geometry/core/access.hpp>
+
+namespace ngen {
+
+/**
+ * A regular grid of rectangular cells, with row 0 at the minimum y
+ */
+struct coverage_grid
+{
+    double xmin;
+    double ymin;
+
+    //! Width and height of each cell
+    double dx;
+    double dy;
+
+    std::size_t columns;
+    std::size_t rows;
+};
+
+/**
+ * The fraction of one grid cell's area covered by a polygon
+ */
+struct cell_coverage
+{
+    std::size_t column;
+    std::size_t row;
+    double fraction;
+};
+
+/**
+ * Exact coverage of the cells of a grid by polygons, computed in time proportional to the
+ * number of vertices plus the number of cells covered.
+ *
+ * By Green's theorem, the area of a polygon within the strip of grid column c and below the top
+ * of row r is a sum over its boundary edges of the integral of min(y - y(r), cell height) along
+ * x, within the strip. So each edge is walked through the cells it crosses, and each piece of it
+ * within a cell adds its exact trapezoid to that cell and its width to every cell below. The
+ * latter are kept as one running total per column, summed from the top of the column down, so
+ * cells fully inside the polygon are covered without ever being tested.
+ *
+ * Rings may be wound either way and left open or closed; holes are told apart from outer rings
+ * by how they are added. Coordinates are taken as planar, in the units of the grid, and parts
+ * of a polygon outside the grid are ignored. An instance keeps its buffers between polygons, so
+ * reusing one for many polygons avoids reallocating them, but it may not be shared by threads.
+ */
+class grid_coverage
+{
+  public:
+    explicit grid_coverage(const coverage_grid& grid)
+      : grid_(grid)
+    {}
+
+    /**
+     * Add a ring of a polygon
+     *
+     * @param ring Range of Boost.Geometry points
+     * @param hole Whether the ring is a hole in its polygon, rather than its outer ring
+     */
+    template<typename Ring>
+    void add_ring(const Ring& ring, bool hole = false)
+    {
+        const std::size_t n = ring.size();
+        if (n < 3) {
+            return;
+        }
+
+        vertices_.clear();
+        vertices_.reserve(n);
+        for (const auto& point : ring) {
+            vertices_.push_back({
+                (boost::geometry::get<0>(point) - grid_.xmin) / grid_.dx,
+                (boost::geometry::get<1>(point) - grid_.ymin) / grid_.dy
+            });
+        }
+
+        // Orient the ring so that its own area is added, or taken away for a hole
+        double winding = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            const auto& a = vertices_[i];
+            const auto& b = vertices_[(i + 1) % n];
+            winding += (b.u - a.u) * (b.v + a.v);
+        }
+        if (winding == 0) {
+            return;
+        }
+        const double sign = (winding > 0) == !hole ? 1.0 : -1.0;
+
+        for (std::size_t i = 0; i < n; i++) {
+            const auto& a = vertices_[i];
+            const auto& b = vertices_[(i + 1) % n];
+            add_edge_(a.u, a.v, b.u, b.v, sign);
+        }
+    }
+
+    /**
+     * Add a Boost.Geometry polygon, with its holes
+     */
+    template<typename Polygon>
+    void add_polygon(const Polygon& polygon)
+    {
+        add_ring(polygon.outer());
+        for (const auto& inner : polygon.inners()) {
+            add_ring(inner, true);
+        }
+    }
+
+    /**
+     * Add every polygon of a Boost.Geometry multipolygon
+     */
+    template<typename MultiPolygon>
+    void add_multipolygon(const MultiPolygon& multipolygon)
+    {
+        for (const auto& polygon : multipolygon) {
+            add_polygon(polygon);
+        }
+    }
+
+    /**
+     * Find the coverage of every cell by the rings added since the last call, and clear them.
+     *
+     * Overlapping polygons are counted once for each, up to full coverage of a cell.
+     *
+     * @param cells Receives the cells with any coverage, ordered by row and then column
+     */
+    void compute(std::vector<cell_coverage>& cells)
+    {
+        cells.clear();
+        by_column_.clear();
+
+        std::sort(pieces_.begin(), pieces_.end(), [](const piece& a, const piece& b) {
+            return a.column < b.column || (a.column == b.column && a.row > b.row);
+        });
+
+        for (std::size_t i = 0; i < pieces_.size();) {
+            const std::size_t column = pieces_[i].column;
+            double below = 0;
+
+            while (i < pieces_.size() && pieces_[i].column == column) {
+                const std::size_t row = pieces_[i].row;
+                double area = 0;
+                for (; i < pieces_.size() && pieces_[i].column == column && pieces_[i].row == row; i++) {
+                    area += pieces_[i].area;
+                    below += pieces_[i].below;
+                }
+                emit_(column, row, area + below);
+
+                // Rows down to the next piece in the column are covered only by the running total
+                const std::size_t next = i < pieces_.size() && pieces_[i].column == column ? pieces_[i].row + 1 : 0;
+                if (std::abs(below) > tolerance_) {
+                    for (std::size_t r = row; r-- > next;) {
+                        emit_(column, r, below);
+                    }
+                }
+            }
+        }
+
+        pieces_.clear();
+        if (by_column_.empty()) {
+            return;
+        }
+
+        // Reorder by row with a counting sort, which keeps the columns of each row in order
+        std::size_t row_first = by_column_.front().row, row_last = row_first;
+        for (const auto& cell : by_column_) {
+            row_first = std::min(row_first, cell.row);
+            row_last  = std::max(row_last, cell.row);
+        }
+
+        row_offsets_.assign(row_last - row_first + 2, 0);
+        for (const auto& cell : by_column_) {
+            row_offsets_[cell.row - row_first + 1]++;
+        }
+        for (std::size_t r = 1; r < row_offsets_.size(); r++) {
+            row_offsets_[r] += row_offsets_[r - 1];
+        }
+
+        cells.resize(by_column_.size());
+        for (const auto& cell : by_column_) {
+            cells[row_offsets_[cell.row - row_first]++] = cell;
+        }
+    }
+
+  private:
+    struct vertex
+    {
+        double u;
+        double v;
+    };
+
+    //! Contribution of one piece of an edge within a column
+    struct piece
+    {
+        std::size_t column;
+        std::size_t row;
+
+        //! Area added to this row's cell
+        double area;
+
+        //! Area added to this row's cell and every cell below it
+        double below;
+    };
+
+    //! Coverage below which a cell is taken to be untouched, allowing for rounding
+    static constexpr double tolerance_ = 1e-10;
+
+    void emit_(std::size_t column, std::size_t row, double fraction)
+    {
+        if (fraction > tolerance_) {
+            by_column_.push_back({ column, row, std::min(fraction, 1.0) });
+        }
+    }
+
+    /**
+     * Split an edge, in grid units, into its pieces within each cell
+     */
+    void add_edge_(double u0, double v0, double u1, double v1, double sign)
+    {
+        const double du = u1 - u0;
+        const double dv = v1 - v0;
+        if (du == 0) {
+            // A vertical edge bounds no area of its own
+            return;
+        }
+
+        // Only the part of the edge over the columns of the grid counts
+        const double columns = static_cast<double>(grid_.columns);
+        double t_first = (0 - u0) / du;
+        double t_last  = (columns - u0) / du;
+        if (t_first > t_last) {
+            std::swap(t_first, t_last);
+        }
+        t_first = std::max(t_first, 0.0);
+        t_last  = std::min(t_last, 1.0);
+        if (!(t_first < t_last)) {
+            return;
+        }
+
+        // Parameters along the edge at which it crosses a column or row boundary
+        crossings_.clear();
+        crossings_.push_back(t_first);
+        crossings_.push_back(t_last);
+
+        const double u_first = u0 + t_first * du, u_last = u0 + t_last * du;
+        for (double u = std::floor(std::min(u_first, u_last)) + 1; u < std::max(u_first, u_last); u++) {
+            crossings_.push_back((u - u0) / du);
+        }
+
+        // Rows outside the grid need no splitting; pieces above it cover every row below
+        const double rows = static_cast<double>(grid_.rows);
+        const double v_first = v0 + t_first * dv, v_last = v0 + t_last * dv;
+        if (dv != 0) {
+            const double v_low  = std::max(std::floor(std::min(v_first, v_last)) + 1, 0.0);
+            const double v_high = std::min(std::max(v_first, v_last), rows + 1);
+            for (double v = v_low; v < v_high; v++) {
+                crossings_.push_back((v - v0) / dv);
+            }
+        }
+
+        std::sort(crossings_.begin(), crossings_.end());
+
+        for (std::size_t i = 0; i + 1 < crossings_.size(); i++) {
+            const double ta = crossings_[i], tb = crossings_[i + 1];
+            if (!(ta < tb)) {
+                continue;
+            }
+
+            const double width = (tb - ta) * du * sign;
+            const double u_mid = u0 + (ta + tb) / 2 * du;
+            const double v_mid = v0 + (ta + tb) / 2 * dv;
+            const std::size_t column = std::min(static_cast<std::size_t>(std::max(u_mid, 0.0)), grid_.columns - 1);
+
+            if (v_mid >= rows) {
+                pieces_.push_back({ column, grid_.rows - 1, 0, width });
+            }
+            else if (v_mid >= 0) {
+                const double row = std::floor(v_mid);
+                pieces_.push_back({ column, static_cast<std::size_t>(row), width * (v_mid - row), 0 });
+                if (row > 0) {
+                    pieces_.push_back({ column, static_cast<std::size_t>(row) - 1, 0, width });
+                }
+            }
+        }
+    }
+
+    coverage_grid grid_;
+    std::vector<vertex> vertices_;
+    std::vector<double> crossings_;
+    std::vector<piece> pieces_;
+
+    //! Covered cells as found, by column, and the start of each row when they are reordered
+    std::vector<cell_coverage> by_column_;
+    std::vector<std::size_t> row_offsets_;
+};
+
+} // namespace ngen
+
+#endif // NGEN_UTILITIES_GRID_COVERAGE_HPP
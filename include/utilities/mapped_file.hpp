@@ -0,0 +1,85 @@
+#ifndef NGEN_UTILITIES_MAPPED_FILE_HPP
+#define NGEN_UTILITIES_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ngen {
+
+/**
+ * A read-only memory mapping of an entire file
+ */
+class mapped_file
+{
+  public:
+    /**
+     * Map a file
+     *
+     * @param path Path of the file
+     * @param description What the file is, for error messages
+     * @throws std::runtime_error If the file cannot be opened or mapped, or is empty
+     */
+    mapped_file(const std::string& path, const std::string& description)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Unable to open " + description + " " + path);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            throw std::runtime_error("Unable to read " + description + " " + path);
+        }
+
+        size_ = static_cast<std::size_t>(info.st_size);
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Unable to map " + description + " " + path);
+        }
+
+        data_ = static_cast<const char*>(data);
+    }
+
+    mapped_file(const mapped_file&)            = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file()
+    {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+
+    /**
+     * Hint that the file will be read once from start to end, so it is read ahead aggressively
+     */
+    void advise_sequential() const noexcept
+    {
+        ::madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+    }
+
+    const char* data() const noexcept
+    {
+        return data_;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return size_;
+    }
+
+  private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace ngen
+
+#endif // NGEN_UTILITIES_MAPPED_FILE_HPP
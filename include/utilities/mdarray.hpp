@@ -2,6 +2,8 @@
 #define NGEN_MDARRAY_HPP
 
 #include "mdarray/mdarray.hpp"
+#include "mdarray/view.hpp"
 #include "mdarray/iterator.hpp"
+#include "mdarray/algorithm.hpp"
 
 #endif // NGEN_MDARRAY_HPP
@@ -0,0 +1,326 @@
+#ifndef NGEN_MDARRAY_ALGORITHM_HPP
+#define NGEN_MDARRAY_ALGORITHM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/core/span.hpp>
+
+#include "mdarray.hpp"
+#include "view.hpp"
+
+// Bulk operations over mdarray views.
+//
+// Each operation walks a view as a series of lanes along its first dimension,
+// and a view whose values are packed together as a single lane, so the inner
+// loops run over raw pointers with a fixed stride, which the compiler can
+// vectorize when the stride is one.
+
+namespace ngen {
+
+namespace detail {
+
+/**
+ * Call @p f(a_offset, b_offset, length, a_stride, b_stride) for each lane of two
+ * views of the same shape, where the offsets locate the first value of the lane
+ * in each view.
+ *
+ * @param packed Whether both views are contiguous, so are walked as one lane
+ */
+template<typename F>
+void for_each_lane(
+    boost::span<const std::size_t> shape,
+    boost::span<const std::size_t> a_strides,
+    boost::span<const std::size_t> b_strides,
+    bool packed,
+    F&& f
+)
+{
+    std::size_t size = 1;
+    for (std::size_t extent : shape)
+        size *= extent;
+
+    if (size == 0)
+        return;
+
+    if (packed || shape.empty()) {
+        f(0, 0, size, 1, 1);
+        return;
+    }
+
+    const std::size_t rank = shape.size();
+    std::vector<std::size_t> index(rank, 0);
+    std::size_t a = 0, b = 0;
+    while (true) {
+        f(a, b, shape[0], a_strides[0], b_strides[0]);
+
+        // Advance the remaining dimensions like an odometer, the second turning fastest
+        std::size_t k = 1;
+        for (; k < rank; k++) {
+            a += a_strides[k];
+            b += b_strides[k];
+            if (++index[k] < shape[k])
+                break;
+
+            a -= a_strides[k] * shape[k];
+            b -= b_strides[k] * shape[k];
+            index[k] = 0;
+        }
+
+        if (k == rank)
+            return;
+    }
+}
+
+/**
+ * Sum of a lane, with independent partial sums so a contiguous lane can be vectorized.
+ */
+template<typename T>
+T lane_sum(const T* values, std::size_t length, std::size_t stride) noexcept
+{
+    T partial[4] = { T(), T(), T(), T() };
+    std::size_t i = 0;
+    if (stride == 1) {
+        for (; i + 4 <= length; i += 4) {
+            partial[0] += values[i];
+            partial[1] += values[i + 1];
+            partial[2] += values[i + 2];
+            partial[3] += values[i + 3];
+        }
+    }
+    for (; i < length; i++)
+        partial[0] += values[i * stride];
+
+    return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
+template<typename T, typename U>
+void check_same_shape(const mdarray_view<T>& x, const mdarray_view<U>& y)
+{
+    const auto xs = x.shape();
+    const auto ys = y.shape();
+    if (xs.size() != ys.size() || !std::equal(xs.begin(), xs.end(), ys.begin()))
+        throw std::invalid_argument(
+            "mdarray views of rank " + std::to_string(xs.size()) + " and " +
+            std::to_string(ys.size()) + " must have the same shape"
+        );
+}
+
+} // namespace detail
+
+/**
+ * Set every value of a view.
+ *
+ * @param x View to fill
+ * @param value Value to set
+ */
+template<typename T>
+void fill(const mdarray_view<T>& x, const typename mdarray_view<T>::value_type& value)
+{
+    static_assert(!std::is_const<T>::value, "cannot fill a read-only mdarray_view");
+
+    T* const data = x.data();
+    detail::for_each_lane(x.shape(), x.strides(), x.strides(), x.contiguous(),
+        [&](std::size_t offset, std::size_t, std::size_t length, std::size_t stride, std::size_t) {
+            T* const lane = data + offset;
+            if (stride == 1) {
+                for (std::size_t i = 0; i < length; i++)
+                    lane[i] = value;
+            } else {
+                for (std::size_t i = 0; i < length; i++)
+                    lane[i * stride] = value;
+            }
+        }
+    );
+}
+
+/**
+ * Replace each value of a view with `value * scale + offset`, as for a linear units conversion.
+ *
+ * @param x View to transform in place
+ * @param scale Factor to multiply each value by
+ * @param offset Amount to add after scaling
+ */
+template<typename T>
+void scale_offset(
+    const mdarray_view<T>& x,
+    const typename mdarray_view<T>::value_type& scale,
+    const typename mdarray_view<T>::value_type& offset
+)
+{
+    static_assert(!std::is_const<T>::value, "cannot scale a read-only mdarray_view");
+
+    T* const data = x.data();
+    detail::for_each_lane(x.shape(), x.strides(), x.strides(), x.contiguous(),
+        [&](std::size_t first, std::size_t, std::size_t length, std::size_t stride, std::size_t) {
+            T* const lane = data + first;
+            if (stride == 1) {
+                for (std::size_t i = 0; i < length; i++)
+                    lane[i] = lane[i] * scale + offset;
+            } else {
+                for (std::size_t i = 0; i < length; i++)
+                    lane[i * stride] = lane[i * stride] * scale + offset;
+            }
+        }
+    );
+}
+
+/**
+ * Add a multiple of one view to another: `y = a * x + y`.
+ *
+ * @param a Factor to multiply each value of @p x by
+ * @param x View to add, with the same shape as @p y
+ * @param y View to add to
+ * @throws std::invalid_argument if the views do not have the same shape
+ */
+template<typename T, typename U>
+void axpy(const typename mdarray_view<T>::value_type& a, const mdarray_view<U>& x, const mdarray_view<T>& y)
+{
+    static_assert(!std::is_const<T>::value, "cannot add to a read-only mdarray_view");
+    static_assert(
+        std::is_same<typename mdarray_view<U>::value_type, T>::value,
+        "mdarray views must have the same value type"
+    );
+    detail::check_same_shape(x, y);
+
+    const U* const x_data = x.data();
+    T* const y_data = y.data();
+    detail::for_each_lane(x.shape(), x.strides(), y.strides(), x.contiguous() && y.contiguous(),
+        [&](std::size_t x_first, std::size_t y_first, std::size_t length, std::size_t x_stride, std::size_t y_stride) {
+            const U* const x_lane = x_data + x_first;
+            T* const y_lane = y_data + y_first;
+            if (x_stride == 1 && y_stride == 1) {
+                for (std::size_t i = 0; i < length; i++)
+                    y_lane[i] += a * x_lane[i];
+            } else {
+                for (std::size_t i = 0; i < length; i++)
+                    y_lane[i * y_stride] += a * x_lane[i * x_stride];
+            }
+        }
+    );
+}
+
+/**
+ * Sum every value of a view.
+ *
+ * Values are added in lanes with independent partial sums, so a floating point
+ * total may differ in its last bits from one added in order.
+ *
+ * @param x View to sum
+ * @return total of the values, or zero for an empty view
+ */
+template<typename T>
+typename mdarray_view<T>::value_type sum(const mdarray_view<T>& x)
+{
+    using value_type = typename mdarray_view<T>::value_type;
+
+    const T* const data = x.data();
+    value_type total = value_type();
+    detail::for_each_lane(x.shape(), x.strides(), x.strides(), x.contiguous(),
+        [&](std::size_t first, std::size_t, std::size_t length, std::size_t stride, std::size_t) {
+            total += detail::lane_sum<value_type>(data + first, length, stride);
+        }
+    );
+    return total;
+}
+
+/**
+ * Sum the values of a view along one dimension.
+ *
+ * @example
+ * mdarray<double> flow({catchments, times});
+ * mdarray<double> volume = sum(flow.view(), 1); // per catchment, over time
+ *
+ * @param x View to sum
+ * @param dimension Dimension to sum over
+ * @return mdarray with the shape of @p x without @p dimension
+ */
+template<typename T>
+mdarray<typename mdarray_view<T>::value_type> sum(const mdarray_view<T>& x, std::size_t dimension)
+{
+    using value_type = typename mdarray_view<T>::value_type;
+
+    if (dimension >= x.rank())
+        throw std::out_of_range(
+            "dimension " + std::to_string(dimension) +
+            " must be less than view rank " + std::to_string(x.rank())
+        );
+
+    std::vector<std::size_t> shape;
+    shape.reserve(x.rank() - 1);
+    for (std::size_t k = 0; k < x.rank(); k++) {
+        if (k != dimension)
+            shape.push_back(x.shape()[k]);
+    }
+
+    mdarray<value_type> result{boost::span<const std::size_t>(shape)};
+
+    // Walk the result alongside the input, staying in place along the summed dimension
+    const std::vector<std::size_t> result_strides = result.strides();
+    std::vector<std::size_t> strides(x.rank(), 0);
+    for (std::size_t k = 0, r = 0; k < x.rank(); k++) {
+        if (k != dimension)
+            strides[k] = result_strides[r++];
+    }
+
+    const T* const data = x.data();
+    value_type* const totals = result.data().data();
+    detail::for_each_lane(x.shape(), x.strides(), strides, false,
+        [&](std::size_t first, std::size_t total, std::size_t length, std::size_t stride, std::size_t total_stride) {
+            if (total_stride == 0) {
+                totals[total] += detail::lane_sum<value_type>(data + first, length, stride);
+            } else if (stride == 1 && total_stride == 1) {
+                for (std::size_t i = 0; i < length; i++)
+                    totals[total + i] += data[first + i];
+            } else {
+                for (std::size_t i = 0; i < length; i++)
+                    totals[total + i * total_stride] += data[first + i * stride];
+            }
+        }
+    );
+
+    return result;
+}
+
+/**
+ * Mean of every value of a view.
+ *
+ * @param x View to average, which must not be empty
+ * @return mean of the values
+ */
+template<typename T>
+typename mdarray_view<T>::value_type mean(const mdarray_view<T>& x)
+{
+    using value_type = typename mdarray_view<T>::value_type;
+    static_assert(std::is_floating_point<value_type>::value, "mean requires a floating point mdarray_view");
+
+    return sum(x) / static_cast<value_type>(x.size());
+}
+
+/**
+ * Mean of the values of a view along one dimension.
+ *
+ * @param x View to average, which must not be empty along @p dimension
+ * @param dimension Dimension to average over
+ * @return mdarray with the shape of @p x without @p dimension
+ */
+template<typename T>
+mdarray<typename mdarray_view<T>::value_type> mean(const mdarray_view<T>& x, std::size_t dimension)
+{
+    using value_type = typename mdarray_view<T>::value_type;
+    static_assert(std::is_floating_point<value_type>::value, "mean requires a floating point mdarray_view");
+
+    mdarray<value_type> result = sum(x, dimension);
+    const value_type count = static_cast<value_type>(x.shape()[dimension]);
+    for (value_type& total : result.data())
+        total /= count;
+    return result;
+}
+
+} // namespace ngen
+
+#endif // NGEN_MDARRAY_ALGORITHM_HPP
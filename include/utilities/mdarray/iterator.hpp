@@ -1,7 +1,11 @@
 #ifndef NGEN_MDARRAY_ITERATOR_HPP
 #define NGEN_MDARRAY_ITERATOR_HPP
 
+#include <algorithm>
+#include <iterator>
+
 #include "mdarray.hpp"
+#include "view.hpp"
 
 namespace ngen {
 
@@ -77,6 +81,99 @@ struct mdarray<T>::iterator
 
 };
 
+/**
+ * Forward iterator over the values of an mdarray_view, in the same order as
+ * mdarray::iterator: the first dimension varies fastest.
+ *
+ * Each step follows the strides of the view, so no index is recomputed
+ * per value.
+ */
+template<typename T>
+struct mdarray_view<T>::iterator
+{
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = mdarray_view::difference_type;
+    using value_type        = mdarray_view::value_type;
+    using pointer           = mdarray_view::pointer;
+    using reference         = mdarray_view::reference;
+
+    iterator(const mdarray_view& ref, size_type position)
+        : m_ref(&ref)
+        , m_index(ref.rank(), 0)
+        , m_ptr(ref.data())
+        , m_position(position){};
+
+    reference operator*() const noexcept
+    {
+        return *this->m_ptr;
+    }
+
+    pointer operator->() const noexcept
+    {
+        return this->m_ptr;
+    }
+
+    iterator& operator++() noexcept
+    {
+        this->m_position++;
+
+        const auto shape   = this->m_ref->shape();
+        const auto strides = this->m_ref->strides();
+        for (size_type k = 0; k < shape.size(); k++) {
+            this->m_ptr += strides[k];
+            if (++this->m_index[k] < shape[k])
+                break;
+
+            this->m_ptr -= strides[k] * shape[k];
+            this->m_index[k] = 0;
+        }
+
+        return *this;
+    }
+
+    iterator operator++(int)
+    {
+        iterator tmp = *this;
+        ++(*this);
+        return tmp;
+    }
+
+    void mdindex(boost::span<size_type> n) const noexcept
+    {
+        std::copy(this->m_index.begin(), this->m_index.end(), n.begin());
+    }
+
+    friend bool operator==(const iterator& a, const iterator& b)
+    {
+        return (a.m_ref == b.m_ref) &&
+                (a.m_position == b.m_position);
+    }
+
+    friend bool operator!=(const iterator& a, const iterator& b)
+    {
+        return !(a == b);
+    }
+
+    private:
+    const mdarray_view*    m_ref;
+    std::vector<size_type> m_index;
+    pointer                m_ptr;
+    size_type              m_position;
+
+};
+
+template<typename T>
+typename mdarray_view<T>::iterator mdarray_view<T>::begin() const
+{
+    return iterator(*this, 0);
+}
+
+template<typename T>
+typename mdarray_view<T>::iterator mdarray_view<T>::end() const
+{
+    return iterator(*this, this->size());
+}
+
 }
 
 #endif // NGEN_MDARRAY_ITERATOR_HPP
@@ -6,6 +6,8 @@
 
 #include <boost/core/span.hpp>
 
+#include "view.hpp"
+
 namespace ngen {
 
 template<typename T>
@@ -171,6 +173,57 @@ class mdarray
         return this->m_shape;
     }
 
+    /**
+     * Get the values of this mdarray, in address index order.
+     *
+     * @return span of every value
+     */
+    boost::span<value_type> data() noexcept
+    {
+        return this->m_data;
+    }
+
+    boost::span<const value_type> data() const noexcept
+    {
+        return this->m_data;
+    }
+
+    /**
+     * Get a view of every value of this mdarray, which can be sliced without copying.
+     *
+     * @example
+     * mdarray<double> x({3, 4});
+     * x.view().slice(1, 2);     // the 3 values with index (i, 2)
+     * x.view().row({{ 2 }});    // the same values, as a contiguous span
+     *
+     * @return mdarray_view
+     */
+    mdarray_view<value_type> view()
+    {
+        return mdarray_view<value_type>(this->m_data.data(), this->m_shape, this->strides());
+    }
+
+    mdarray_view<const value_type> view() const
+    {
+        return mdarray_view<const value_type>(this->m_data.data(), this->m_shape, this->strides());
+    }
+
+    /**
+     * Get the distance between consecutive indices of each dimension, in address indices.
+     *
+     * @return stride per dimension
+     */
+    std::vector<size_type> strides() const
+    {
+        std::vector<size_type> strides(this->rank());
+        size_type stride = 1;
+        for (size_type k = 0; k < this->rank(); k++) {
+            strides[k] = stride;
+            stride *= this->m_shape[k];
+        }
+        return strides;
+    }
+
     /**
      * Index a multi-dimensional set of indices to a single address index.
      * 
@@ -0,0 +1,280 @@
+#ifndef NGEN_MDARRAY_VIEW_HPP
+#define NGEN_MDARRAY_VIEW_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/core/span.hpp>
+
+namespace ngen {
+
+/**
+ * Non-owning, strided view of the values of an mdarray.
+ *
+ * A view shares the layout of mdarray: the first dimension varies fastest. Each
+ * dimension has its own stride, in elements, so slicing a view along any
+ * dimension is a view of the same values, and never copies them.
+ *
+ * A view does not keep its values alive; it is invalidated by anything that
+ * invalidates pointers into the mdarray it was taken from.
+ *
+ * @tparam T Element type, const-qualified for a read-only view.
+ */
+template<typename T>
+class mdarray_view
+{
+  public:
+    using element_type    = T;
+    using value_type      = typename std::remove_const<T>::type;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using pointer         = T*;
+
+    struct iterator;
+
+    mdarray_view() = default;
+
+    /**
+     * Create a view of values laid out with the given shape and strides.
+     *
+     * @param data Address of the value at index zero
+     * @param shape Extent of each dimension
+     * @param strides Distance in elements between consecutive indices of each dimension
+     */
+    mdarray_view(pointer data, std::vector<size_type> shape, std::vector<size_type> strides)
+        : m_data(data)
+        , m_shape(std::move(shape))
+        , m_strides(std::move(strides))
+    {
+        if (this->m_shape.size() != this->m_strides.size())
+            throw std::invalid_argument(
+                "mdarray_view rank " + std::to_string(this->m_shape.size()) +
+                " does not match its number of strides " + std::to_string(this->m_strides.size())
+            );
+    }
+
+    /**
+     * A read-only view of the same values as a mutable view.
+     */
+    template<
+        typename U,
+        typename = typename std::enable_if<std::is_same<const U, T>::value && !std::is_const<U>::value>::type
+    >
+    mdarray_view(const mdarray_view<U>& other)
+        : m_data(other.data())
+        , m_shape(other.shape().begin(), other.shape().end())
+        , m_strides(other.strides().begin(), other.strides().end())
+    {}
+
+    /**
+     * Address of the value at index zero.
+     */
+    pointer data() const noexcept
+    {
+        return this->m_data;
+    }
+
+    size_type rank() const noexcept
+    {
+        return this->m_shape.size();
+    }
+
+    boost::span<const size_type> shape() const noexcept
+    {
+        return this->m_shape;
+    }
+
+    boost::span<const size_type> strides() const noexcept
+    {
+        return this->m_strides;
+    }
+
+    /**
+     * Number of values in this view.
+     */
+    size_type size() const noexcept
+    {
+        size_type size = 1;
+        for (size_type extent : this->m_shape)
+            size *= extent;
+        return size;
+    }
+
+    bool empty() const noexcept
+    {
+        return this->size() == 0;
+    }
+
+    /**
+     * Whether the values of this view are packed together in the same order as an
+     * mdarray of its shape, so that they can be treated as a single span.
+     */
+    bool contiguous() const noexcept
+    {
+        size_type expected = 1;
+        for (size_type k = 0; k < this->rank(); k++) {
+            // The stride of a dimension with a single index is never used
+            if (this->m_shape[k] != 1 && this->m_strides[k] != expected)
+                return false;
+            expected *= this->m_shape[k];
+        }
+        return true;
+    }
+
+    /**
+     * Offset in elements from data() to the value at the given index.
+     *
+     * @param n Index list
+     * @return size_type
+     */
+    size_type offset(const boost::span<const size_type> n) const noexcept
+    {
+        size_type offset = 0;
+        for (size_type k = 0; k < this->rank(); k++)
+            offset += n[k] * this->m_strides[k];
+        return offset;
+    }
+
+    /**
+     * Retrieve a reference to the value at the given index.
+     *
+     * @param n Index list
+     * @return reference
+     */
+    reference at(const boost::span<const size_type> n) const
+    {
+        if (n.size() != this->rank())
+            throw std::out_of_range(
+                "index of rank " + std::to_string(n.size()) +
+                " must match view rank " + std::to_string(this->rank())
+            );
+        for (size_type k = 0; k < this->rank(); k++)
+            this->bounds_check(k, n[k], 1);
+
+        return this->m_data[this->offset(n)];
+    }
+
+    reference operator[](const boost::span<const size_type> n) const noexcept
+    {
+        return this->m_data[this->offset(n)];
+    }
+
+    /**
+     * View the values at a single index of one dimension, dropping that dimension.
+     *
+     * @example
+     * mdarray<double> flow({catchments, times});
+     * auto step = flow.view().slice(1, t); // rank 1: every catchment at time t
+     *
+     * @param dimension Dimension to fix
+     * @param index Index within that dimension
+     * @return mdarray_view of rank one less than this view
+     */
+    mdarray_view slice(size_type dimension, size_type index) const
+    {
+        this->dimension_check(dimension);
+        this->bounds_check(dimension, index, 1);
+
+        std::vector<size_type> shape, strides;
+        shape.reserve(this->rank() - 1);
+        strides.reserve(this->rank() - 1);
+        for (size_type k = 0; k < this->rank(); k++) {
+            if (k == dimension)
+                continue;
+            shape.push_back(this->m_shape[k]);
+            strides.push_back(this->m_strides[k]);
+        }
+
+        return mdarray_view(
+            this->m_data + index * this->m_strides[dimension], std::move(shape), std::move(strides)
+        );
+    }
+
+    /**
+     * View a range of indices of one dimension, keeping the rank of this view.
+     *
+     * @param dimension Dimension to narrow
+     * @param first First index of the range
+     * @param count Number of indices in the range
+     * @return mdarray_view of the same rank as this view
+     */
+    mdarray_view slice(size_type dimension, size_type first, size_type count) const
+    {
+        this->dimension_check(dimension);
+        this->bounds_check(dimension, first, count);
+
+        std::vector<size_type> shape(this->m_shape);
+        shape[dimension] = count;
+
+        return mdarray_view(this->m_data + first * this->m_strides[dimension], std::move(shape), this->m_strides);
+    }
+
+    /**
+     * The values along the first dimension at an index of the remaining dimensions.
+     *
+     * The first dimension varies fastest, so in a view of a whole mdarray each row is
+     * contiguous and can be handed to code taking a pointer and a count, such as a BMI
+     * set_value or a units conversion.
+     *
+     * @example
+     * mdarray<double> flow({catchments, times});
+     * boost::span<double> step = flow.view().row({{ t }}); // every catchment at time t
+     *
+     * @param n Index of each dimension after the first
+     * @return boost::span<T>
+     * @throws std::logic_error if the first dimension of this view is not contiguous
+     */
+    boost::span<T> row(const boost::span<const size_type> n) const
+    {
+        if (this->rank() == 0 || n.size() != this->rank() - 1)
+            throw std::out_of_range(
+                "row index of rank " + std::to_string(n.size()) +
+                " must be one less than view rank " + std::to_string(this->rank())
+            );
+        if (this->m_shape[0] > 1 && this->m_strides[0] != 1)
+            throw std::logic_error("rows of this mdarray_view are not contiguous");
+
+        size_type offset = 0;
+        for (size_type k = 1; k < this->rank(); k++) {
+            this->bounds_check(k, n[k - 1], 1);
+            offset += n[k - 1] * this->m_strides[k];
+        }
+
+        return boost::span<T>(this->m_data + offset, this->m_shape[0]);
+    }
+
+    iterator begin() const;
+    iterator end() const;
+
+  private:
+    inline void dimension_check(size_type dimension) const
+    {
+        if (dimension >= this->rank())
+            throw std::out_of_range(
+                "dimension " + std::to_string(dimension) +
+                " must be less than view rank " + std::to_string(this->rank())
+            );
+    }
+
+    inline void bounds_check(size_type dimension, size_type first, size_type count) const
+    {
+        if (first > this->m_shape[dimension] || count > this->m_shape[dimension] - first)
+            throw std::out_of_range(
+                "index " + std::to_string(first + count - 1) +
+                " must be less than dimension size " + std::to_string(this->m_shape[dimension])
+            );
+    }
+
+    pointer                m_data = nullptr;
+    std::vector<size_type> m_shape;
+    std::vector<size_type> m_strides;
+};
+
+} // namespace ngen
+
+#endif // NGEN_MDARRAY_VIEW_HPP
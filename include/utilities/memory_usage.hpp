@@ -0,0 +1,45 @@
+#ifndef NGEN_MEMORY_USAGE_HPP
+#define NGEN_MEMORY_USAGE_HPP
+
+#include <fstream>
+
+#include <unistd.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace utils {
+
+    /**
+     * Get the resident set size of this process.
+     *
+     * @return The resident set size in bytes, or -1 if it cannot be determined on this platform.
+     */
+    inline long resident_set_size() {
+        #if defined(__linux__)
+        // /proc/self/statm gives the total program size, then the resident size, in pages
+        std::ifstream statm("/proc/self/statm");
+        long pages = 0, resident = 0;
+        if (statm >> pages >> resident) {
+            return resident * sysconf(_SC_PAGESIZE);
+        }
+        #endif
+        return -1;
+    }
+
+    /**
+     * Return memory that has been freed by the process to the operating system where the allocator supports it.
+     *
+     * Large structures released after initialization otherwise stay mapped by the allocator, so they would
+     * still be counted in the resident set size.
+     */
+    inline void release_free_memory() {
+        #if defined(__GLIBC__)
+        malloc_trim(0);
+        #endif
+    }
+
+}
+
+#endif // NGEN_MEMORY_USAGE_HPP
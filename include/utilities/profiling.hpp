@@ -0,0 +1,379 @@
+#ifndef NGEN_UTILITIES_PROFILING_HPP
+#define NGEN_UTILITIES_PROFILING_HPP
+
+#include <NGenConfig.h>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if NGEN_WITH_MPI
+#include <mpi.h>
+#endif
+
+namespace ngen {
+namespace profiling {
+
+/**
+ * A named stage of the run, with the total time spent in it and its nested stages.
+ *
+ * Timers form a tree: a timer started while another is running on the same thread
+ * becomes its child. Time is accumulated across every call, and across threads, so
+ * stages run concurrently may add up to more than the wall time of their parent.
+ */
+class timer
+{
+  public:
+    explicit timer(std::string name)
+      : name_(std::move(name))
+    {}
+
+    timer(const timer&)            = delete;
+    timer& operator=(const timer&) = delete;
+
+    const std::string& name() const
+    {
+        return name_;
+    }
+
+    //! Total time recorded, in seconds
+    double seconds() const
+    {
+        return nanoseconds_.load(std::memory_order_relaxed) * 1e-9;
+    }
+
+    //! Number of times the stage was entered
+    long calls() const
+    {
+        return calls_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get a nested stage, creating it the first time it is entered
+     */
+    timer& child(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& child : children_) {
+            if (child->name_ == name) {
+                return *child;
+            }
+        }
+        children_.emplace_back(new timer(name));
+        return *children_.back();
+    }
+
+    //! The nested stages, in the order they were first entered
+    std::vector<const timer*> children() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<const timer*> result;
+        result.reserve(children_.size());
+        for (const auto& child : children_) {
+            result.push_back(child.get());
+        }
+        return result;
+    }
+
+    void add(std::chrono::steady_clock::duration elapsed)
+    {
+        nanoseconds_.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+            std::memory_order_relaxed
+        );
+        calls_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+  private:
+    const std::string                   name_;
+    std::atomic<long long>              nanoseconds_{0};
+    std::atomic<long>                   calls_{0};
+    mutable std::mutex                  mutex_;
+    std::vector<std::unique_ptr<timer>> children_;
+};
+
+//! The root of this process's timers
+inline timer& root()
+{
+    static timer instance("");
+    return instance;
+}
+
+namespace detail {
+
+inline timer*& current()
+{
+    static thread_local timer* running = nullptr;
+    return running;
+}
+
+} // namespace detail
+
+//! The innermost timer running on this thread, or the root if there is none
+inline timer& current()
+{
+    timer* running = detail::current();
+    return running == nullptr ? root() : *running;
+}
+
+/**
+ * Times a stage for as long as it is in scope.
+ *
+ * @code{.cpp}
+ * {
+ *     ngen::profiling::scoped_timer t("hydrofabric");
+ *     // ... read the hydrofabric
+ * }
+ * @endcode
+ */
+class scoped_timer
+{
+  public:
+    explicit scoped_timer(const std::string& name)
+      : previous_(detail::current())
+      , timer_(current().child(name))
+      , start_(std::chrono::steady_clock::now())
+    {
+        detail::current() = &timer_;
+    }
+
+    scoped_timer(const scoped_timer&)            = delete;
+    scoped_timer& operator=(const scoped_timer&) = delete;
+
+    ~scoped_timer()
+    {
+        stop();
+    }
+
+    /**
+     * End the stage before the timer goes out of scope.
+     *
+     * Timers on the same thread must still be stopped innermost first.
+     */
+    void stop()
+    {
+        if (stopped_) {
+            return;
+        }
+        stopped_ = true;
+        timer_.add(std::chrono::steady_clock::now() - start_);
+        detail::current() = previous_;
+    }
+
+  private:
+    timer*                                previous_;
+    timer&                                timer_;
+    std::chrono::steady_clock::time_point start_;
+    bool                                  stopped_ = false;
+};
+
+/**
+ * Nests the timers started on this thread under a timer from another thread while in scope.
+ *
+ * Work handed to a thread pool can capture current() when it is submitted and adopt it
+ * when it runs, so that its stages are attributed to the stage that submitted it.
+ */
+class adopted_scope
+{
+  public:
+    explicit adopted_scope(timer& parent)
+      : previous_(detail::current())
+    {
+        detail::current() = &parent;
+    }
+
+    adopted_scope(const adopted_scope&)            = delete;
+    adopted_scope& operator=(const adopted_scope&) = delete;
+
+    ~adopted_scope()
+    {
+        detail::current() = previous_;
+    }
+
+  private:
+    timer* previous_;
+};
+
+namespace detail {
+
+//! A stage of the report, merged over every rank that recorded it
+struct merged_stage
+{
+    std::string name;
+    int         ranks   = 0;
+    long        calls   = 0;
+    double      min     = std::numeric_limits<double>::max();
+    double      max     = 0;
+    double      sum     = 0;
+    std::vector<std::unique_ptr<merged_stage>> children;
+
+    merged_stage& child(const std::string& child_name)
+    {
+        for (auto& child : children) {
+            if (child->name == child_name) {
+                return *child;
+            }
+        }
+        children.emplace_back(new merged_stage());
+        children.back()->name = child_name;
+        return *children.back();
+    }
+
+    void add(double seconds, long stage_calls)
+    {
+        ranks++;
+        calls += stage_calls;
+        min = std::min(min, seconds);
+        max = std::max(max, seconds);
+        sum += seconds;
+    }
+};
+
+/**
+ * Write the timers under @p node, one per line, as a tab-separated path, time, and call count
+ */
+inline void flatten(const timer& node, const std::string& path, std::ostringstream& out)
+{
+    for (const timer* child : node.children()) {
+        const std::string child_path = path.empty() ? child->name() : path + "/" + child->name();
+        out << child_path << '\t' << std::setprecision(17) << child->seconds() << '\t' << child->calls() << '\n';
+        flatten(*child, child_path, out);
+    }
+}
+
+inline void merge(merged_stage& root, const std::string& flattened)
+{
+    std::istringstream lines(flattened);
+    std::string        line;
+    while (std::getline(lines, line)) {
+        const std::size_t time_tab  = line.find('\t');
+        const std::size_t calls_tab = line.find('\t', time_tab + 1);
+        if (time_tab == std::string::npos || calls_tab == std::string::npos) {
+            continue;
+        }
+
+        merged_stage* stage = &root;
+        std::size_t   begin = 0;
+        while (begin < time_tab) {
+            std::size_t end = line.find('/', begin);
+            if (end == std::string::npos || end > time_tab) {
+                end = time_tab;
+            }
+            stage = &stage->child(line.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        stage->add(
+            std::stod(line.substr(time_tab + 1, calls_tab - time_tab - 1)),
+            std::stol(line.substr(calls_tab + 1))
+        );
+    }
+}
+
+inline std::string escape(const std::string& value)
+{
+    std::string escaped;
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+inline void write(const merged_stage& stage, std::ostringstream& out, int indent)
+{
+    const std::string pad(indent, ' ');
+    out << pad << "{\n"
+        << pad << "  \"name\": \"" << escape(stage.name) << "\",\n"
+        << pad << "  \"ranks\": " << stage.ranks << ",\n"
+        << pad << "  \"calls\": " << stage.calls << ",\n"
+        << pad << "  \"seconds\": { \"min\": " << stage.min << ", \"max\": " << stage.max
+        << ", \"mean\": " << stage.sum / stage.ranks << " },\n"
+        << pad << "  \"children\": [";
+    for (std::size_t i = 0; i < stage.children.size(); i++) {
+        out << (i == 0 ? "\n" : ",\n");
+        write(*stage.children[i], out, indent + 4);
+    }
+    out << (stage.children.empty() ? "]\n" : "\n" + pad + "  ]\n") << pad << "}";
+}
+
+} // namespace detail
+
+/**
+ * Build a JSON report of the timers recorded so far.
+ *
+ * Under MPI this is collective: every rank must call it, and only rank 0 gets the report,
+ * with each stage's time given as the minimum, maximum, and mean over the ranks that
+ * recorded it. Other ranks get an empty string.
+ *
+ * @return The report, as a JSON object with a list of top-level "stages"
+ */
+inline std::string report()
+{
+    std::ostringstream flattened;
+    detail::flatten(root(), "", flattened);
+
+    int ranks = 1;
+    std::vector<std::string> per_rank = { flattened.str() };
+
+    #if NGEN_WITH_MPI
+    int rank = 0;
+    int mpi_initialized = 0;
+    MPI_Initialized(&mpi_initialized);
+    if (mpi_initialized) {
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+    }
+    if (ranks > 1) {
+        int length = static_cast<int>(per_rank[0].size());
+        std::vector<int> lengths(ranks), offsets(ranks);
+        MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+        std::vector<char> gathered;
+        if (rank == 0) {
+            int total = 0;
+            for (int i = 0; i < ranks; i++) {
+                offsets[i] = total;
+                total += lengths[i];
+            }
+            gathered.resize(total);
+        }
+        MPI_Gatherv(per_rank[0].data(), length, MPI_CHAR, gathered.data(), lengths.data(), offsets.data(),
+                    MPI_CHAR, 0, MPI_COMM_WORLD);
+
+        if (rank != 0) {
+            return "";
+        }
+        per_rank.clear();
+        for (int i = 0; i < ranks; i++) {
+            per_rank.emplace_back(gathered.data() + offsets[i], lengths[i]);
+        }
+    }
+    #endif
+
+    detail::merged_stage merged;
+    for (const auto& flattened_rank : per_rank) {
+        detail::merge(merged, flattened_rank);
+    }
+
+    std::ostringstream out;
+    out << std::setprecision(6) << "{\n  \"ranks\": " << ranks << ",\n  \"stages\": [";
+    for (std::size_t i = 0; i < merged.children.size(); i++) {
+        out << (i == 0 ? "\n" : ",\n");
+        detail::write(*merged.children[i], out, 4);
+    }
+    out << (merged.children.empty() ? "]\n" : "\n  ]\n") << "}\n";
+    return out.str();
+}
+
+} // namespace profiling
+} // namespace ngen
+
+#endif // NGEN_UTILITIES_PROFILING_HPP
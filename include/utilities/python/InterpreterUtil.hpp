@@ -5,8 +5,10 @@
 
 #if NGEN_WITH_PYTHON
 
+#include <atomic>
 #include <cstdlib>
 #include <map>
+#include <boost/optional.hpp>
 #include <pybind11/embed.h>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
@@ -339,6 +341,55 @@ namespace utils {
             }
 
         };
+
+        /**
+         * Get the number of threads, besides the one running the interpreter, that may currently call into Python.
+         *
+         * While this is zero, the thread running the interpreter holds the GIL throughout, so it can call into Python
+         * without acquiring it.  A thread that calls into Python alongside it, like the Forcings Engine look-ahead
+         * thread, is counted for as long as it runs.
+         *
+         * @return The count of other threads that may call into Python.
+         */
+        inline std::atomic<int>& concurrentPythonThreads() {
+            static std::atomic<int> count{0};
+            return count;
+        }
+
+        /**
+         * Scoped acquisition of the GIL, made only while other threads may call into Python.
+         *
+         * Otherwise, the GIL is already held by the thread running the interpreter, and nothing is done.
+         */
+        class ConcurrentGilAcquire {
+        public:
+            ConcurrentGilAcquire() {
+                if (concurrentPythonThreads().load(std::memory_order_acquire) > 0) {
+                    acquired.emplace();
+                }
+            }
+
+        private:
+            boost::optional<py::gil_scoped_acquire> acquired;
+        };
+
+        /**
+         * Scoped release of the GIL, made only if the thread holds it, e.g. to wait on another thread calling into
+         * Python.
+         *
+         * The GIL is taken back by the same thread at the end of the scope.
+         */
+        class GilRelease {
+        public:
+            GilRelease() {
+                if (Py_IsInitialized() && PyGILState_Check()) {
+                    released.emplace();
+                }
+            }
+
+        private:
+            boost::optional<py::gil_scoped_release> released;
+        };
     }
 }
 
@@ -0,0 +1,131 @@
+#ifndef NGEN_UTILITIES_THREAD_POOL_HPP
+#define NGEN_UTILITIES_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ngen {
+
+/**
+ * A fixed-size pool of worker threads consuming a FIFO task queue.
+ *
+ * Tasks are submitted as nullary callables and their results (or exceptions)
+ * are returned through a std::future. The destructor drains any tasks that are
+ * still queued and joins all workers.
+ */
+class thread_pool
+{
+  public:
+    /**
+     * Construct a new thread pool
+     *
+     * @param threads Number of worker threads; if 0, uses the
+     *                hardware concurrency (at least 1).
+     */
+    explicit thread_pool(std::size_t threads = 0)
+    {
+        if (threads == 0) {
+            threads = default_size();
+        }
+
+        workers_.reserve(threads);
+        for (std::size_t i = 0; i < threads; i++) {
+            workers_.emplace_back([this]{ work_(); });
+        }
+    }
+
+    thread_pool(const thread_pool&)            = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+
+        condition_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /**
+     * Number of threads to use when none are specified
+     *
+     * @return std::size_t hardware concurrency, or 1 if it cannot be determined
+     */
+    static std::size_t default_size() noexcept
+    {
+        const auto n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    /**
+     * @return std::size_t Number of worker threads in this pool
+     */
+    std::size_t size() const noexcept
+    {
+        return workers_.size();
+    }
+
+    /**
+     * Queue a task for execution on the pool
+     *
+     * @param task Nullary callable to execute
+     * @return std::future holding the result of @p task
+     */
+    template<typename F, typename R = typename std::result_of<F()>::type>
+    std::future<R> submit(F&& task)
+    {
+        auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+        std::future<R> result = packaged->get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace([packaged]{ (*packaged)(); });
+        }
+
+        condition_.notify_one();
+        return result;
+    }
+
+  private:
+    void work_()
+    {
+        while (true) {
+            std::function<void()> task;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this]{ return stopping_ || !tasks_.empty(); });
+
+                if (tasks_.empty()) {
+                    return; // stopping, and nothing left to run
+                }
+
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+
+            task();
+        }
+    }
+
+    std::vector<std::thread>          workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex                        mutex_;
+    std::condition_variable           condition_;
+    bool                              stopping_ = false;
+};
+
+} // namespace ngen
+
+#endif // NGEN_UTILITIES_THREAD_POOL_HPP
@@ -0,0 +1,313 @@
+#ifndef NGEN_UTILITIES_TRACE_RECORDER_HPP
+#define NGEN_UTILITIES_TRACE_RECORDER_HPP
+
+#include <NGenConfig.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if NGEN_WITH_MPI
+#include <mpi.h>
+#endif
+
+namespace ngen {
+namespace trace {
+
+/**
+ * A recorded event: a span of time if @c duration_ns is non-negative, otherwise an instant
+ *
+ * Names and categories are not copied, so must outlive the recorder; string literals, or
+ * the names of objects that live for the whole run, such as layers.
+ */
+struct event
+{
+    const char*  category;
+    const char*  name;
+    std::int64_t begin_ns;
+    std::int64_t duration_ns;
+    std::int64_t arg;
+};
+
+/**
+ * Records timeline events into a ring buffer per thread, for export as Chrome trace JSON.
+ *
+ * Recording is off until enable() is called, and then only while the time step set with
+ * set_step() is inside the configured window, so that long runs can be traced around the
+ * steps of interest. While off, recording an event costs a single relaxed atomic load.
+ *
+ * Each thread keeps its most recent events: once its buffer is full, the oldest events are
+ * overwritten.
+ */
+class recorder
+{
+  public:
+    //! The recorder of this process
+    static recorder& instance()
+    {
+        static recorder trace;
+        return trace;
+    }
+
+    /**
+     * Start recording
+     *
+     * Under MPI, ranks should call this together (e.g. after a barrier), since event times
+     * are taken relative to it and the ranks' timelines are aligned on it.
+     *
+     * Events recorded before are discarded, and every thread's buffer is sized to @p capacity,
+     * so no events may be recorded while enabling.
+     *
+     * @param capacity Number of events kept per thread
+     * @param start_step First time step to record
+     * @param end_step Time step to stop recording at, exclusive
+     */
+    void enable(std::size_t capacity, long start_step = 0, long end_step = std::numeric_limits<long>::max())
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_   = std::max<std::size_t>(capacity, 1);
+        for (auto& thread : buffers_) {
+            thread->reset(capacity_);
+        }
+        start_step_ = start_step;
+        end_step_   = end_step;
+        epoch_      = std::chrono::steady_clock::now();
+        enabled_    = true;
+        update_recording_();
+    }
+
+    bool enabled() const
+    {
+        return enabled_;
+    }
+
+    //! Whether events are currently being recorded
+    bool recording() const
+    {
+        return recording_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Set the time step the run is on, which decides whether it is inside the window
+     */
+    void set_step(long step)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        step_ = step;
+        update_recording_();
+    }
+
+    std::int64_t now_ns() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    void record(const event& e)
+    {
+        thread_buffer_().push(e);
+    }
+
+    /**
+     * Write the recorded events of every rank to a Chrome trace JSON file
+     *
+     * Under MPI this is collective. Each rank appends its events to the file in turn, as a
+     * process of its own, so the file must be on a filesystem shared by all ranks. Event
+     * times are in microseconds since enable(). No events may be recorded while writing.
+     *
+     * @param path The file to write
+     * @return Whether this rank's events were written
+     */
+    bool write(const std::string& path) const
+    {
+        int rank = 0, ranks = 1;
+
+        #if NGEN_WITH_MPI
+        int mpi_initialized = 0;
+        MPI_Initialized(&mpi_initialized);
+        if (mpi_initialized) {
+            MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+            MPI_Comm_size(MPI_COMM_WORLD, &ranks);
+        }
+        #endif
+
+        bool written = true;
+        for (int turn = 0; turn < ranks; turn++) {
+            if (turn == rank) {
+                written = write_rank_(path, rank, rank == ranks - 1);
+            }
+            #if NGEN_WITH_MPI
+            if (ranks > 1) {
+                MPI_Barrier(MPI_COMM_WORLD);
+            }
+            #endif
+        }
+        return written;
+    }
+
+  private:
+    struct buffer
+    {
+        std::vector<event> events;
+        std::size_t        next  = 0;
+        bool               full  = false;
+        int                tid   = 0;
+
+        void reset(std::size_t capacity)
+        {
+            events.assign(capacity, event{});
+            next = 0;
+            full = false;
+        }
+
+        void push(const event& e)
+        {
+            events[next] = e;
+            if (++next == events.size()) {
+                next = 0;
+                full = true;
+            }
+        }
+    };
+
+    recorder() = default;
+
+    void update_recording_()
+    {
+        recording_.store(enabled_ && step_ >= start_step_ && step_ < end_step_, std::memory_order_relaxed);
+    }
+
+    buffer& thread_buffer_()
+    {
+        static thread_local buffer* local = nullptr;
+        if (local == nullptr) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffers_.emplace_back(new buffer());
+            local = buffers_.back().get();
+            local->reset(capacity_);
+            local->tid = static_cast<int>(buffers_.size());
+        }
+        return *local;
+    }
+
+    static void write_escaped_(std::ofstream& out, const char* value)
+    {
+        for (; *value != '\0'; value++) {
+            if (*value == '"' || *value == '\\') {
+                out << '\\';
+            }
+            out << *value;
+        }
+    }
+
+    bool write_rank_(const std::string& path, int rank, bool last) const
+    {
+        std::ofstream out(path, rank == 0 ? std::ios::trunc : std::ios::app);
+        if (rank == 0) {
+            out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        }
+        else {
+            out << ",\n";
+        }
+        out << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << rank
+            << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        for (const auto& thread : buffers_) {
+            const std::size_t count = thread->full ? thread->events.size() : thread->next;
+            const std::size_t first = thread->full ? thread->next : 0;
+            for (std::size_t i = 0; i < count; i++) {
+                const event& e = thread->events[(first + i) % thread->events.size()];
+                out << ",\n{\"cat\":\"";
+                write_escaped_(out, e.category);
+                out << "\",\"name\":\"";
+                write_escaped_(out, e.name);
+                out << "\",\"pid\":" << rank << ",\"tid\":" << thread->tid
+                    << ",\"ts\":" << e.begin_ns / 1e3;
+                if (e.duration_ns >= 0) {
+                    out << ",\"ph\":\"X\",\"dur\":" << e.duration_ns / 1e3;
+                }
+                else {
+                    out << ",\"ph\":\"i\",\"s\":\"t\"";
+                }
+                out << ",\"args\":{\"value\":" << e.arg << "}}";
+            }
+        }
+
+        if (last) {
+            out << "\n]}\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+    mutable std::mutex                   mutex_;
+    std::vector<std::unique_ptr<buffer>> buffers_;
+    std::atomic<bool>                    recording_{false};
+    bool                                 enabled_    = false;
+    std::size_t                          capacity_   = 1;
+    long                                 step_       = 0;
+    long                                 start_step_ = 0;
+    long                                 end_step_   = std::numeric_limits<long>::max();
+    std::chrono::steady_clock::time_point epoch_     = std::chrono::steady_clock::now();
+};
+
+/**
+ * Records a span of time, from construction to destruction, if recording when constructed
+ *
+ * @code{.cpp}
+ * {
+ *     ngen::trace::scoped_event e("mpi", "recv_wait", rank);
+ *     // ... wait
+ * }
+ * @endcode
+ */
+class scoped_event
+{
+  public:
+    scoped_event(const char* category, const char* name, std::int64_t arg = 0)
+    {
+        recorder& trace = recorder::instance();
+        if (trace.recording()) {
+            event_ = { category, name, trace.now_ns(), 0, arg };
+            active_ = true;
+        }
+    }
+
+    scoped_event(const scoped_event&)            = delete;
+    scoped_event& operator=(const scoped_event&) = delete;
+
+    ~scoped_event()
+    {
+        if (active_) {
+            recorder& trace = recorder::instance();
+            event_.duration_ns = trace.now_ns() - event_.begin_ns;
+            trace.record(event_);
+        }
+    }
+
+  private:
+    event event_;
+    bool  active_ = false;
+};
+
+//! Records a point in time, if recording
+inline void instant(const char* category, const char* name, std::int64_t arg = 0)
+{
+    recorder& trace = recorder::instance();
+    if (trace.recording()) {
+        trace.record({ category, name, trace.now_ns(), -1, arg });
+    }
+}
+
+} // namespace trace
+} // namespace ngen
+
+#endif // NGEN_UTILITIES_TRACE_RECORDER_HPP
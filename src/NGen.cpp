@@ -9,6 +9,7 @@
 #include "realizations/catchment/Formulation_Manager.hpp"
 #include <Catchment_Formulation.hpp>
 #include <HY_Features.hpp>
+#include <hydrofabric.hpp>
 
 #if NGEN_WITH_SQLITE3
 #include <geopackage.hpp>
@@ -17,6 +18,10 @@
 #include "NGenConfig.h"
 
 #include <FileChecker.h>
+#include <memory_usage.hpp>
+#include <profiling.hpp>
+#include <catchment_profile.hpp>
+#include <trace_recorder.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/range/algorithm/sort.hpp>
 
@@ -27,6 +32,7 @@
 #if NGEN_WITH_PYTHON
 #include <pybind11/embed.h>
 #include "python/InterpreterUtil.hpp"
+#include "forcing/ForcingsEngineDataProvider.hpp"
 #endif // NGEN_WITH_PYTHON
     
 #if NGEN_WITH_ROUTING
@@ -160,6 +166,7 @@ int main(int argc, char *argv[]) {
     } 
 
     auto time_start = std::chrono::steady_clock::now();
+    ngen::profiling::scoped_timer init_timer("init");
 
     std::cout << "NGen Framework " << ngen_VERSION_MAJOR << "."
               << ngen_VERSION_MINOR << "."
@@ -358,30 +365,53 @@ int main(int argc, char *argv[]) {
     }
     #endif // NGEN_WITH_MPI
 
+    ngen::profiling::scoped_timer hydrofabric_timer("hydrofabric");
+    // A compiled hydrofabric holds both collections, already linked
+    bool features_linked = false;
+    ngen::hydrofabric::collections compiled_fabric;
+    if (ngen::hydrofabric::is_compiled(nexusDataFile) || ngen::hydrofabric::is_compiled(catchmentDataFile)) {
+      if (nexusDataFile != catchmentDataFile) {
+        throw std::runtime_error("A compiled hydrofabric must be given as both the catchment and nexus data path.");
+      }
+      ngen::profiling::scoped_timer compiled_timer("compiled");
+      compiled_fabric = ngen::hydrofabric::load(catchmentDataFile, catchment_subset_ids, nexus_subset_ids);
+      features_linked = true;
+    }
+
     // TODO: Instead of iterating through a collection of FeatureBase objects mapping to nexi, we instead want to iterate through HY_HydroLocation objects
     geojson::GeoJSON nexus_collection;
-    if (boost::algorithm::ends_with(nexusDataFile, "gpkg")) {
+    ngen::profiling::scoped_timer nexus_timer("nexus");
+    if (features_linked) {
+      nexus_collection = compiled_fabric.nexuses;
+    } else if (boost::algorithm::ends_with(nexusDataFile, "gpkg")) {
       #if NGEN_WITH_SQLITE3
-      nexus_collection = ngen::geopackage::read(nexusDataFile, "nexus", nexus_subset_ids);
+      // Nothing downstream of this point consumes feature geometry, so skip
+      // WKB decoding and reprojection and only read the attribute columns
+      nexus_collection = ngen::geopackage::read(nexusDataFile, "nexus", nexus_subset_ids, false);
       #else
       throw std::runtime_error("SQLite3 support required to read GeoPackage files.");
       #endif
     } else {
-      nexus_collection = geojson::read(nexusDataFile, nexus_subset_ids);
+      nexus_collection = geojson::read(nexusDataFile, nexus_subset_ids, false);
     }
+    nexus_timer.stop();
     std::cout << "Building Catchment collection" << std::endl;
 
     // TODO: Instead of iterating through a collection of FeatureBase objects mapping to catchments, we instead want to iterate through HY_Catchment objects
     geojson::GeoJSON catchment_collection;
-    if (boost::algorithm::ends_with(catchmentDataFile, "gpkg")) {
+    ngen::profiling::scoped_timer catchment_timer("catchments");
+    if (features_linked) {
+      catchment_collection = compiled_fabric.catchments;
+    } else if (boost::algorithm::ends_with(catchmentDataFile, "gpkg")) {
       #if NGEN_WITH_SQLITE3
-      catchment_collection = ngen::geopackage::read(catchmentDataFile, "divides", catchment_subset_ids);
+      catchment_collection = ngen::geopackage::read(catchmentDataFile, "divides", catchment_subset_ids, false);
       #else
       throw std::runtime_error("SQLite3 support required to read GeoPackage files.");
       #endif
     } else {
-      catchment_collection = geojson::read(catchmentDataFile, catchment_subset_ids);
+      catchment_collection = geojson::read(catchmentDataFile, catchment_subset_ids, false);
     }
+    catchment_timer.stop();
     
     for(auto& feature: *catchment_collection)
     {
@@ -392,9 +422,13 @@ int main(int argc, char *argv[]) {
     //Update the feature ids for the combined collection, using the alternative property 'id'
     //to map features to their primary id as well as the alternative property
     nexus_collection->update_ids("id");
+    hydrofabric_timer.stop();
+
     std::cout<<"Initializing formulations" << std::endl;
+    ngen::profiling::scoped_timer formulations_timer("formulations");
     std::shared_ptr<realization::Formulation_Manager> manager = std::make_shared<realization::Formulation_Manager>(REALIZATION_CONFIG_PATH);
     manager->read(catchment_collection, utils::getStdOut());
+    formulations_timer.stop();
 
     //TODO refactor manager->read so certain configs can be queried before the entire
     //realization collection is created
@@ -404,6 +438,7 @@ int main(int argc, char *argv[]) {
     { // Run t-route from single process
     if(manager->get_using_routing()) {
       std::cout<<"Using Routing"<<std::endl;
+      ngen::profiling::scoped_timer routing_timer("routing");
       std::string t_route_config_file_with_path = manager->get_t_route_config_file_with_path();
       router = std::make_unique<routing_py_adapter::Routing_Py_Adapter>(t_route_config_file_with_path);
     }
@@ -414,7 +449,12 @@ int main(int argc, char *argv[]) {
     #endif //NGEN_WITH_ROUTING
     std::cout<<"Building Feature Index" <<std::endl;;
     std::string link_key = "toid";
-    nexus_collection->link_features_from_property(nullptr, &link_key);
+    if (!features_linked) {
+      ngen::profiling::scoped_timer link_timer("link_features");
+      nexus_collection->link_features_from_property(nullptr, &link_key);
+    }
+
+    ngen::profiling::scoped_timer network_timer("network");
 
     #if NGEN_WITH_MPI
     //mpirun with one processor without partition file
@@ -430,12 +470,11 @@ int main(int argc, char *argv[]) {
 
     //validate dendritic connections
     features.validate_dendritic();
-    //TODO don't really need catchment_collection once catchments are added to nexus collection
-    //Still using  catchments for geometry at the moment, fix this later
-    //catchment_collection.reset();
     nexus_collection.reset();
+    network_timer.stop();
 
     //Still hacking nexus output for the moment
+    ngen::profiling::scoped_timer output_files_timer("output_files");
     for(const auto& id : features.nexuses()) {
         #if NGEN_WITH_MPI
         if (mpi_num_procs > 1) {
@@ -450,8 +489,12 @@ int main(int argc, char *argv[]) {
         #endif
     }
 
+    output_files_timer.stop();
+
     std::cout<<"Running Models"<<std::endl;
 
+    ngen::profiling::scoped_timer layers_timer("layers");
+
     // check the time loops for the existing layers
     ngen::LayerDataStorage& layer_meta_data = manager->get_layer_metadata();
 
@@ -501,13 +544,42 @@ int main(int argc, char *argv[]) {
 
     }
 
+    layers_timer.stop();
+
+    // Everything the time loop needs from the hydrofabric has been copied into the
+    // features and layers, so release the collections (properties and all) before it starts
+    const long rss_before_release = utils::resident_set_size();
+    catchment_collection.reset();
+    compiled_fabric = ngen::hydrofabric::collections{};
+    utils::release_free_memory();
+    const long rss_after_release = utils::resident_set_size();
+
+    init_timer.stop();
     auto time_done_init = std::chrono::steady_clock::now();
     std::chrono::duration<double> time_elapsed_init = time_done_init - time_start;
 
+    // Trace the time loop if configured, starting every rank's timeline together
+    const auto trace_config = manager->get_trace_config();
+    ngen::trace::recorder& trace = ngen::trace::recorder::instance();
+    if (trace_config) {
+#if NGEN_WITH_MPI
+        MPI_Barrier(MPI_COMM_WORLD);
+#endif
+        trace.enable(trace_config->buffer_events, trace_config->start_step, trace_config->end_step);
+    }
+
+#if NGEN_WITH_PYTHON
+    // Without Python models, layers update without the GIL while a Forcings Engine looks ahead, so
+    // that it generates the next time step's forcings while the models compute this one. Its calls
+    // from the models take the GIL only while the look-ahead thread is counted, so not otherwise.
+    const bool release_gil = !manager->get_using_python_models();
+#endif
+
     //Now loop some time, iterate catchments, do stuff for total number of output times
     auto num_times = manager->Simulation_Time_Object->get_total_output_times();
     for( int count = 0; count < num_times; count++) 
     {
+      trace.set_step(count);
       // The Inner loop will advance all layers unless doing so will break one of two constraints
       // 1) A layer may not proceed ahead of the master simulation object's current time
       // 2) A layer may not proceed ahead of any layer that is computed before it
@@ -535,6 +607,13 @@ int main(int argc, char *argv[]) {
           if ( layer_next_time <= next_time && layer_next_time <=  prev_layer_time)
           {
             if(count%100==0) std::cout<<"Updating layer: "<<layer->get_name()<<"\n";
+            ngen::trace::scoped_event layer_event("layer", layer->get_name().c_str(), count);
+#if NGEN_WITH_PYTHON
+            boost::optional<utils::ngenPy::GilRelease> released;
+            if (release_gil && utils::ngenPy::concurrentPythonThreads() > 0) {
+                released.emplace();
+            }
+#endif
             layer->update_models(); //assume update_models() calls time->advance_timestep()
             prev_layer_time = layer_next_time;
           }
@@ -556,9 +635,13 @@ int main(int argc, char *argv[]) {
       }
 
     } //done time
+    trace.set_step(num_times);
 
 #if NGEN_WITH_MPI
-    MPI_Barrier(MPI_COMM_WORLD);
+    {
+        ngen::trace::scoped_event barrier_event("mpi", "barrier");
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
 #endif
 
     if (mpi_rank == 0)
@@ -585,6 +668,7 @@ int main(int argc, char *argv[]) {
 
           int delta_time = manager->Simulation_Time_Object->get_output_interval_seconds();
           
+          ngen::trace::scoped_event routing_event("routing", "route", number_of_timesteps);
           router->route(number_of_timesteps, delta_time); 
         }
     }
@@ -602,10 +686,69 @@ int main(int argc, char *argv[]) {
                   << "\n\tNGen::routing: " << time_elapsed_routing.count()
 #endif
                   << std::endl;
+        if (rss_before_release >= 0 && rss_after_release >= 0) {
+            std::cout << "NGen resident memory (MiB):"
+                      << "\n\tbefore releasing hydrofabric: " << rss_before_release / (1024.0 * 1024.0)
+                      << "\n\tafter releasing hydrofabric: " << rss_after_release / (1024.0 * 1024.0)
+                      << std::endl;
+        }
     }
 
+    // Every rank contributes to the report, which only rank 0 receives and writes
+    const std::string init_profile = ngen::profiling::report();
+    if (mpi_rank == 0)
+    {
+        const std::string init_profile_path = manager->get_output_root() + "ngen_init_profile.json";
+        std::ofstream init_profile_file(init_profile_path, std::ios::trunc);
+        if (init_profile_file << init_profile) {
+            std::cout << "NGen init profile written to " << init_profile_path << std::endl;
+        }
+        else {
+            std::cerr << "WARNING: could not write NGen init profile to " << init_profile_path << std::endl;
+        }
+    }
+
+    if (trace_config) {
+        // A relative path is taken from the output root
+        std::string trace_path = trace_config->path;
+        if (trace_path.empty() || trace_path[0] != '/') {
+            trace_path = manager->get_output_root() + trace_path;
+        }
+        const bool trace_written = trace.write(trace_path);
+        if (!trace_written) {
+            std::cerr << "WARNING: could not write NGen trace to " << trace_path << std::endl;
+        }
+        else if (mpi_rank == 0) {
+            std::cout << "NGen trace written to " << trace_path << std::endl;
+        }
+    }
+
+#if NGEN_WITH_PROFILING
+    // Each rank writes the runtime table of its own catchments
+    const auto& catchment_profile = ngen::profiling::catchment_profile::instance();
+    std::string catchment_profile_path = manager->get_output_root() + "ngen_catchment_profile";
+#if NGEN_WITH_MPI
+    if (mpi_num_procs > 1) {
+        catchment_profile_path += "." + std::to_string(mpi_rank);
+    }
+#endif
+    catchment_profile_path += ".csv";
+    std::ofstream catchment_profile_file(catchment_profile_path, std::ios::trunc);
+    catchment_profile.write_csv(catchment_profile_file);
+    if (mpi_rank == 0)
+    {
+        catchment_profile.summarize(std::cout);
+        std::cout << "NGen catchment profile written to " << catchment_profile_path << std::endl;
+    }
+#endif
+
   manager->finalize();
 
+#if NGEN_WITH_PYTHON
+  // Stop any Forcings Engine look-ahead and release the instances while the interpreter is still alive
+  data_access::detail::ForcingsEngineStorage::instances.clear();
+#endif // NGEN_WITH_PYTHON
+
 #if NGEN_WITH_MPI
     MPI_Finalize();
 #endif
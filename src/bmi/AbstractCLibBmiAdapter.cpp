@@ -1,11 +1,10 @@
 #include "bmi/AbstractCLibBmiAdapter.hpp"
+#include "bmi/SharedLibrary.hpp"
 
 #include "utilities/FileChecker.h"
 #include "utilities/ExternalIntegrationException.hpp"
 #include "utilities/logging_utils.h"
 
-#include <dlfcn.h>
-
 namespace models {
 namespace bmi {
 
@@ -38,12 +37,18 @@ void AbstractCLibBmiAdapter::dynamic_library_load() {
                                    "; empty name given for library's registration function.";
         throw std::runtime_error(this->init_exception_msg);
     }
-    if (dyn_lib_handle != nullptr) {
+    if (dyn_lib != nullptr) {
         std::string message = "AbstractCLibBmiAdapter::dynamic_library_load: ignoring attempt to reload dynamic shared library '" + bmi_lib_file + "' for " + this->model_name;
         logging::warning(message.c_str());
         return;
     }
-    if (!utils::FileChecker::file_is_readable(bmi_lib_file)) {
+    // Another adapter for the same module has usually loaded the library already
+    dyn_lib = SharedLibrary::find(bmi_lib_file);
+    if (dyn_lib != nullptr) {
+        return;
+    }
+    std::string lib_file = bmi_lib_file;
+    if (!utils::FileChecker::file_is_readable(lib_file)) {
         // Try alternative extension...
         size_t idx = bmi_lib_file.rfind(".");
         if (idx == std::string::npos) {
@@ -72,7 +77,7 @@ void AbstractCLibBmiAdapter::dynamic_library_load() {
         // TODO: Try looking in e.g. /usr/lib, /usr/local/lib, $LD_LIBRARY_PATH... try pre-pending
         // "lib"...
         if (utils::FileChecker::file_is_readable(alt_bmi_lib_file)) {
-            bmi_lib_file = alt_bmi_lib_file;
+            lib_file = alt_bmi_lib_file;
         } else {
             this->init_exception_msg = "Can't init " + this->model_name +
                                        "; unreadable shared library file '" + bmi_lib_file + "'";
@@ -80,17 +85,14 @@ void AbstractCLibBmiAdapter::dynamic_library_load() {
         }
     }
 
-    // Call first to ensure any previous error is cleared before trying to load the symbol
-    dlerror();
-    // Load up the necessary library dynamically
-    dyn_lib_handle = dlopen(bmi_lib_file.c_str(), RTLD_NOW | RTLD_LOCAL);
-    // Now call again to see if there was an error (if there was, this will not be null)
-    char* err_message = dlerror();
-    if (dyn_lib_handle == nullptr && err_message != nullptr) {
+    // Load up the necessary library dynamically, or get it from the adapter that loaded it meanwhile
+    std::string err_message;
+    dyn_lib = SharedLibrary::open(bmi_lib_file, lib_file, err_message);
+    if (dyn_lib == nullptr) {
         this->init_exception_msg =
-            "Cannot load shared lib '" + bmi_lib_file + "' for model " + this->model_name;
-        if (err_message != nullptr) {
-            this->init_exception_msg += " (" + std::string(err_message) + ")";
+            "Cannot load shared lib '" + lib_file + "' for model " + this->model_name;
+        if (!err_message.empty()) {
+            this->init_exception_msg += " (" + err_message + ")";
         }
         throw ::external::ExternalIntegrationException(this->init_exception_msg);
     }
@@ -100,22 +102,19 @@ void* AbstractCLibBmiAdapter::dynamic_load_symbol(
     const std::string& symbol_name,
     bool is_null_valid
 ) {
-    if (dyn_lib_handle == nullptr) {
+    if (dyn_lib == nullptr) {
         throw std::runtime_error(
             "Cannot load symbol '" + symbol_name +
             "' without handle to shared library (bmi_lib_file = '" + bmi_lib_file + "')"
         );
     }
-    // Call first to ensure any previous error is cleared before trying to load the symbol
-    dlerror();
-    void* symbol = dlsym(dyn_lib_handle, symbol_name.c_str());
-    // Now call again to see if there was an error (if there was, this will not be null)
-    char* err_message = dlerror();
-    if (symbol == nullptr && (err_message != nullptr || !is_null_valid)) {
+    std::string err_message;
+    void* symbol = dyn_lib->symbol(symbol_name, err_message);
+    if (symbol == nullptr && (!err_message.empty() || !is_null_valid)) {
         this->init_exception_msg =
             "Cannot load shared lib symbol '" + symbol_name + "' for model " + this->model_name;
-        if (err_message != nullptr) {
-            this->init_exception_msg += " (" + std::string(err_message) + ")";
+        if (!err_message.empty()) {
+            this->init_exception_msg += " (" + err_message + ")";
         }
         throw ::external::ExternalIntegrationException(this->init_exception_msg);
     }
@@ -123,10 +122,8 @@ void* AbstractCLibBmiAdapter::dynamic_load_symbol(
 }
 
 void AbstractCLibBmiAdapter::finalizeForLibAbstraction() {
-    //  close the dynamically loaded library
-    if (dyn_lib_handle != nullptr) {
-        dlclose(dyn_lib_handle);
-    }
+    // Release this adapter's hold on the dynamically loaded library, which is closed once no adapter holds it
+    dyn_lib.reset();
 }
 
 } // namespace bmi
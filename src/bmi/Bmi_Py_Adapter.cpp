@@ -15,9 +15,10 @@ Bmi_Py_Adapter::Bmi_Py_Adapter(const std::string &type_name, std::string bmi_ini
                                bool has_fixed_time_step)
         : Bmi_Adapter(type_name + " (BMI Py)", std::move(bmi_init_config),
                                   has_fixed_time_step),
-          bmi_type_py_full_name(bmi_python_type),
-          np(utils::ngenPy::InterpreterUtil::getPyModule("numpy")) /* like 'import numpy as np' */
+          bmi_type_py_full_name(bmi_python_type)
 {
+    utils::ngenPy::ConcurrentGilAcquire gil;
+    np = utils::ngenPy::InterpreterUtil::getPyModule("numpy"); /* like 'import numpy as np' */
     try {
         construct_and_init_backing_model_for_py_adapter();
         // Make sure this is set to 'true' after this function call finishes
@@ -37,24 +38,29 @@ Bmi_Py_Adapter::Bmi_Py_Adapter(const std::string &type_name, std::string bmi_ini
 }
 
 std::string Bmi_Py_Adapter::GetComponentName() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::str(bmi_model->attr("get_component_name")());
 }
 
 double Bmi_Py_Adapter::GetCurrentTime() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     // TODO: will need to verify the implicit casting for this works as expected
     return py::float_(bmi_model->attr("get_current_time")());
 }
 
 double Bmi_Py_Adapter::GetEndTime() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     // TODO: will need to verify the implicit casting for this works as expected
     return py::float_(bmi_model->attr("get_end_time")());
 }
 
 int Bmi_Py_Adapter::GetInputItemCount() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::int_(bmi_model->attr("get_input_item_count")());
 }
 
 std::vector<std::string> Bmi_Py_Adapter::GetInputVarNames() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     std::vector<std::string> in_var_names(GetInputItemCount());
     py::tuple in_var_names_tuple = bmi_model->attr("get_input_var_names")();
     int i = 0;
@@ -66,10 +72,12 @@ std::vector<std::string> Bmi_Py_Adapter::GetInputVarNames() {
 }
 
 int Bmi_Py_Adapter::GetOutputItemCount() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::int_(bmi_model->attr("get_output_item_count")());
 }
 
 std::vector<std::string> Bmi_Py_Adapter::GetOutputVarNames() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     std::vector<std::string> out_var_names(GetOutputItemCount());
     py::tuple out_var_names_tuple = bmi_model->attr("get_output_var_names")();
     int i = 0;
@@ -81,15 +89,18 @@ std::vector<std::string> Bmi_Py_Adapter::GetOutputVarNames() {
 }
 
 double Bmi_Py_Adapter::GetStartTime() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     // TODO: will need to verify the implicit casting for this works as expected
     return py::float_(bmi_model->attr("get_start_time")());
 }
 
 std::string Bmi_Py_Adapter::GetTimeUnits() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::str(bmi_model->attr("get_time_units")());
 }
 
 double Bmi_Py_Adapter::GetTimeStep() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::float_(bmi_model->attr("get_time_step")());
 }
 
@@ -132,31 +143,38 @@ void Bmi_Py_Adapter::GetValueAtIndices(std::string name, void *dest, int *inds,
 }
 
 void *Bmi_Py_Adapter::GetValuePtr(std::string name) {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     auto ptr_array = bmi_model->attr("get_value_ptr")(name);
     return ((py::array)ptr_array).request().ptr;
 }
 
 int Bmi_Py_Adapter::GetVarGrid(std::string name) {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::int_(bmi_model->attr("get_var_grid")(name));
 }
 
 int Bmi_Py_Adapter::GetVarItemsize(std::string name) {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::int_(bmi_model->attr("get_var_itemsize")(name));
 }
 
 std::string Bmi_Py_Adapter::GetVarLocation(std::string name) {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::str(bmi_model->attr("get_var_location")(name));
 }
 
 int Bmi_Py_Adapter::GetVarNbytes(std::string name) {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::int_(bmi_model->attr("get_var_nbytes")(name));
 }
 
 std::string Bmi_Py_Adapter::GetVarType(std::string name) {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::str(bmi_model->attr("get_var_type")(name));
 }
 
 std::string Bmi_Py_Adapter::GetVarUnits(std::string name) {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     return py::str(bmi_model->attr("get_var_units")(name));
 }
 
@@ -215,10 +233,12 @@ void Bmi_Py_Adapter::SetValueAtIndices(std::string name, int *inds, int count, v
 }
 
 void Bmi_Py_Adapter::Update() {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     bmi_model->attr("update")();
 }
 
 void Bmi_Py_Adapter::UpdateUntil(double time) {
+    utils::ngenPy::ConcurrentGilAcquire gil;
     bmi_model->attr("update_until")(time);
 }
 
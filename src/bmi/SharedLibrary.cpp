@@ -0,0 +1,92 @@
+#include "bmi/SharedLibrary.hpp"
+
+#include <dlfcn.h>
+
+namespace models {
+namespace bmi {
+
+namespace {
+
+/**
+ * The libraries currently loaded, by the path they were requested by.
+ *
+ * Entries expire once the last adapter holding the library releases it.
+ */
+struct registry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<SharedLibrary>> libraries;
+};
+
+registry& get_registry() {
+    static registry instance;
+    return instance;
+}
+
+} // namespace
+
+std::shared_ptr<SharedLibrary> SharedLibrary::find(const std::string& path) {
+    registry& loaded = get_registry();
+    std::lock_guard<std::mutex> lock(loaded.mutex);
+    const auto library = loaded.libraries.find(path);
+    return library == loaded.libraries.end() ? nullptr : library->second.lock();
+}
+
+std::shared_ptr<SharedLibrary> SharedLibrary::open(
+    const std::string& path,
+    const std::string& file,
+    std::string& error
+) {
+    registry& loaded = get_registry();
+    std::lock_guard<std::mutex> lock(loaded.mutex);
+
+    std::weak_ptr<SharedLibrary>& entry = loaded.libraries[path];
+    std::shared_ptr<SharedLibrary> library = entry.lock();
+    if (library != nullptr) {
+        return library;
+    }
+
+    // Call first to ensure any previous error is cleared before trying to load the library
+    dlerror();
+    void* handle = dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+    // Now call again to see if there was an error (if there was, this will not be null)
+    char* err_message = dlerror();
+    if (handle == nullptr) {
+        loaded.libraries.erase(path);
+        error = err_message != nullptr ? err_message : "";
+        return nullptr;
+    }
+
+    library = std::shared_ptr<SharedLibrary>(new SharedLibrary(file, handle));
+    entry = library;
+    return library;
+}
+
+SharedLibrary::~SharedLibrary() {
+    dlclose(handle);
+}
+
+void* SharedLibrary::symbol(const std::string& symbol_name, std::string& error) {
+    std::lock_guard<std::mutex> lock(symbols_mutex);
+    error.clear();
+
+    const auto found = symbols.find(symbol_name);
+    if (found != symbols.end()) {
+        return found->second;
+    }
+
+    // Call first to ensure any previous error is cleared before trying to load the symbol
+    dlerror();
+    void* address = dlsym(handle, symbol_name.c_str());
+    // Now call again to see if there was an error (if there was, this will not be null)
+    char* err_message = dlerror();
+    if (err_message != nullptr) {
+        error = err_message;
+        return nullptr;
+    }
+
+    symbols.emplace(symbol_name, address);
+    return address;
+}
+
+} // namespace bmi
+} // namespace models
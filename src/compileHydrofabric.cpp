@@ -0,0 +1,74 @@
+#include <NGenConfig.h>
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <FeatureBuilder.hpp>
+#include <hydrofabric.hpp>
+
+#if NGEN_WITH_SQLITE3
+#include <geopackage.hpp>
+#endif
+
+/**
+ * Read a hydrofabric layer from GeoJSON or GeoPackage, without geometry
+ */
+geojson::GeoJSON read_layer(const std::string& path, const std::string& gpkg_layer)
+{
+    if (boost::algorithm::ends_with(path, "gpkg")) {
+        #if NGEN_WITH_SQLITE3
+        return ngen::geopackage::read(path, gpkg_layer, {}, false);
+        #else
+        throw std::runtime_error("SQLite3 support required to read GeoPackage files.");
+        #endif
+    }
+
+    return geojson::read(path, {}, false);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 4) {
+        std::cout << "Usage: " << argv[0] << " <catchment_data_path> <nexus_data_path> <output_path>" << std::endl
+                  << std::endl
+                  << "Compiles the catchments and nexuses of a GeoJSON or GeoPackage hydrofabric into a binary file" << std::endl
+                  << "that ngen can load without parsing. Pass the output (which must end in "
+                  << ngen::hydrofabric::compiled_extension << ") as both" << std::endl
+                  << "the catchment and nexus data paths when running ngen." << std::endl;
+        return argc == 1 ? 0 : -1;
+    }
+
+    const std::string catchment_data_path = argv[1];
+    const std::string nexus_data_path     = argv[2];
+    const std::string output_path         = argv[3];
+
+    if (!ngen::hydrofabric::is_compiled(output_path)) {
+        std::cerr << "Output path " << output_path << " must end in " << ngen::hydrofabric::compiled_extension << std::endl;
+        return -1;
+    }
+
+    try {
+        const auto time_start = std::chrono::steady_clock::now();
+
+        ngen::hydrofabric::collections fabric;
+        fabric.nexuses    = read_layer(nexus_data_path, "nexus");
+        fabric.catchments = read_layer(catchment_data_path, "divides");
+
+        ngen::hydrofabric::compile(fabric, output_path);
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_start;
+        std::cout << "Compiled " << fabric.catchments->get_size() << " catchments and "
+                  << fabric.nexuses->get_size() << " nexuses into " << output_path
+                  << " in " << elapsed.count() << " seconds" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
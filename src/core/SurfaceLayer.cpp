@@ -1,4 +1,5 @@
 #include "SurfaceLayer.hpp"
+#include "trace_recorder.hpp"
 
 /***
  * @brief Run one simulation timestep for each model in this layer, then gather catchment output
@@ -13,6 +14,7 @@ void ngen::SurfaceLayer::update_models()
     //At this point, could make an internal routing pass, extracting flows from nexuses and routing
     //across the flowpath to the next nexus.
     //Once everything is updated for this timestep, dump the nexus output
+    trace::scoped_event output_event("output", "nexus_output", current_time_index);
     for(const auto& id : features.nexuses()) 
     {
         std::string current_timestamp = simulation_time.get_timestamp(current_time_index);
@@ -1,5 +1,6 @@
 #include "HY_PointHydroNexusRemote.hpp"
 #include "Constants.h"
+#include "trace_recorder.hpp"
 
 
 #if NGEN_WITH_MPI
@@ -150,11 +151,13 @@ double HY_PointHydroNexusRemote::get_downstream_flow(std::string catchment_id, t
                         &stored_receives.back().mpi_request);
 
        		MPI_Handle_Error(status); 
+       		ngen::trace::instant("mpi", "irecv", rank);
        		
                 //std::cerr << "Creating receive with target_rank=" << rank << " on tag=" << tag << "\n";
     	}
     	
         //std::cerr << "Waiting on receives\n";
+        ngen::trace::scoped_event wait_event("mpi", "recv_wait", t);
         while ( stored_receives.size() > 0 )
     	{
     		process_communications();
@@ -215,8 +218,9 @@ void HY_PointHydroNexusRemote::add_upstream_flow(double val, std::string catchme
 		        &stored_sends.back().mpi_request);
 		        
 		    //std::cerr << "Creating send with target_rank=" << *downstream_ranks.begin() << " on tag=" << tag << "\n";	
-		        
+		    ngen::trace::instant("mpi", "isend", *downstream_ranks.begin());
 		    
+		    ngen::trace::scoped_event wait_event("mpi", "send_wait", t);
 		    while ( stored_sends.size() > 0 )
 		    {
 		    	process_communications();  
@@ -0,0 +1,330 @@
+#include <NGenConfig.h>
+
+#if NGEN_WITH_NETCDF
+#include "CsvForcingConverter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <limits>
+#include <memory>
+#include <regex>
+#include <stdexcept>
+#include <vector>
+
+#include <dirent.h>
+
+#include <boost/algorithm/string/replace.hpp>
+
+#include <netcdf>
+
+#include "AorcForcing.hpp"
+#include "CsvForcingReader.hpp"
+#include "thread_pool.hpp"
+
+namespace data_access {
+
+namespace {
+
+//! Memory to spend on each block of catchments parsed ahead of writing; two blocks are held at once
+constexpr std::size_t block_budget_bytes = std::size_t(512) << 20;
+
+struct forcing_file
+{
+    std::string id;
+    std::string path;
+};
+
+struct forcing_variable
+{
+    std::string name;
+    std::string units;
+};
+
+/**
+ * The variables and times shared by every forcing file, taken from the first
+ */
+struct forcing_layout
+{
+    std::string path;
+    std::vector<forcing_variable> variables;
+    std::vector<time_t> times;
+};
+
+/**
+ * Values of every variable for a run of consecutive catchments, parsed ahead of writing
+ */
+struct forcing_block
+{
+    std::size_t first = 0;
+    std::size_t count = 0;
+
+    //! Per variable, catchment by time, with time varying fastest as in the output
+    std::vector<std::vector<double>> values;
+
+    //! One per catchment in the block
+    std::vector<std::future<void>> pending;
+};
+
+/**
+ * Find the forcing files in a directory whose names match a pattern, ordered by name
+ */
+std::vector<forcing_file> list_forcing_files(const std::string& directory, const std::string& pattern)
+{
+    if (pattern.find("{{id}}") == std::string::npos) {
+        throw std::runtime_error("File name pattern " + pattern + " has no {{id}}");
+    }
+    const std::regex name_regex{boost::algorithm::replace_first_copy(pattern, "{{id}}", "(.+?)")};
+
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        throw std::runtime_error("Unable to open forcing directory " + directory);
+    }
+
+    std::vector<forcing_file> files;
+    std::smatch match;
+    for (struct dirent* entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (std::regex_match(name, match, name_regex)) {
+            files.push_back({ match[1].str(), directory + "/" + name });
+        }
+    }
+    closedir(dir);
+
+    std::sort(files.begin(), files.end(), [](const forcing_file& a, const forcing_file& b) {
+        return a.path < b.path;
+    });
+    for (std::size_t i = 1; i < files.size(); i++) {
+        if (files[i].id == files[i - 1].id) {
+            throw std::runtime_error("Forcing files " + files[i - 1].path + " and " + files[i].path + " are both for " + files[i].id);
+        }
+    }
+
+    return files;
+}
+
+/**
+ * Take the variables, their units, and the times from the first forcing file
+ */
+forcing_layout read_layout(const forcing_file& file)
+{
+    const auto table = data_access::read_csv_forcing(file.path, std::numeric_limits<time_t>::min(), std::numeric_limits<time_t>::max());
+
+    forcing_layout layout;
+    layout.path  = file.path;
+    layout.times = table.times;
+
+    for (std::size_t c = 0; c < table.header.size(); c++) {
+        if (c == table.time_column) {
+            continue;
+        }
+
+        forcing_variable variable;
+        data_access::parse_csv_forcing_column(table.header[c], variable.name, variable.units);
+
+        // Record the units the providers would assume, so the file describes itself
+        const auto wkf = data_access::WellKnownFields.find(variable.name);
+        if (variable.units.empty() && wkf != data_access::WellKnownFields.end()) {
+            variable.units = std::get<1>(wkf->second);
+        }
+
+        layout.variables.push_back(std::move(variable));
+    }
+
+    if (layout.times.empty()) {
+        throw std::runtime_error("Forcing file " + file.path + " has no rows");
+    }
+    if (layout.variables.empty()) {
+        throw std::runtime_error("Forcing file " + file.path + " has no variables");
+    }
+
+    return layout;
+}
+
+/**
+ * Read a forcing file into row @p row of each variable of a block
+ */
+void read_forcing(const forcing_file& file, const forcing_layout& layout, forcing_block& block, std::size_t row)
+{
+    auto table = data_access::read_csv_forcing(file.path, std::numeric_limits<time_t>::min(), std::numeric_limits<time_t>::max());
+
+    if (table.times != layout.times) {
+        throw std::runtime_error("Forcing file " + file.path + " does not have the same times as " + layout.path);
+    }
+
+    const std::size_t steps = layout.times.size();
+    std::vector<bool> found(layout.variables.size(), false);
+    for (std::size_t c = 0; c < table.header.size(); c++) {
+        if (c == table.time_column) {
+            continue;
+        }
+
+        std::string name, units;
+        data_access::parse_csv_forcing_column(table.header[c], name, units);
+
+        const auto variable = std::find_if(layout.variables.begin(), layout.variables.end(), [&name](const forcing_variable& v) {
+            return v.name == name;
+        });
+        if (variable == layout.variables.end()) {
+            throw std::runtime_error("Forcing file " + file.path + " has variable " + name + ", which " + layout.path + " does not");
+        }
+
+        const std::size_t v = variable - layout.variables.begin();
+        found[v] = true;
+        std::copy(table.columns[c].begin(), table.columns[c].end(), block.values[v].begin() + row * steps);
+    }
+
+    for (std::size_t v = 0; v < found.size(); v++) {
+        if (!found[v]) {
+            throw std::runtime_error("Forcing file " + file.path + " does not have variable " + layout.variables[v].name);
+        }
+    }
+}
+
+/**
+ * Queue reading the forcing files of a block of catchments
+ *
+ * Once any read fails, @p failed is set, and reads still queued are skipped rather than run.
+ */
+std::unique_ptr<forcing_block> read_block(
+    ngen::thread_pool& pool,
+    const std::vector<forcing_file>& files,
+    const forcing_layout& layout,
+    std::size_t first,
+    std::size_t count,
+    std::atomic<bool>& failed
+)
+{
+    std::unique_ptr<forcing_block> block{new forcing_block};
+    block->first = first;
+    block->count = count;
+    block->values.assign(layout.variables.size(), std::vector<double>(count * layout.times.size()));
+
+    forcing_block* target = block.get();
+    for (std::size_t row = 0; row < count; row++) {
+        block->pending.push_back(pool.submit([&files, &layout, &failed, target, first, row]{
+            if (failed) {
+                return;
+            }
+
+            try {
+                read_forcing(files[first + row], layout, *target, row);
+            }
+            catch (...) {
+                failed = true;
+                throw;
+            }
+        }));
+    }
+
+    return block;
+}
+
+} // namespace
+
+CsvForcingConversionSummary convert_csv_forcing(
+    const std::string& csv_directory,
+    const std::string& output_path,
+    const CsvForcingConversion& options,
+    std::ostream& progress
+)
+{
+    const auto files = list_forcing_files(csv_directory, options.pattern);
+    if (files.empty()) {
+        throw std::runtime_error("No forcing files in " + csv_directory + " match " + options.pattern);
+    }
+
+    const forcing_layout layout = read_layout(files.front());
+    const std::size_t catchments = files.size();
+    const std::size_t steps = layout.times.size();
+
+    // Catchments parsed at once, and the chunking of each variable across catchments, so that
+    // reading one time step of every catchment touches as few chunks as possible. A chunk is no
+    // larger than a block, and a block is a whole number of chunks, so no chunk is written twice.
+    const std::size_t row_bytes = steps * layout.variables.size() * sizeof(double);
+    std::size_t block_catchments = std::min(catchments, std::max<std::size_t>(1, block_budget_bytes / row_bytes));
+    const std::size_t chunk_catchments = std::min(block_catchments, options.chunk_catchments > 0 ? options.chunk_catchments : block_catchments);
+    block_catchments -= block_catchments % chunk_catchments;
+
+    netCDF::NcFile nc_file{output_path, netCDF::NcFile::replace, netCDF::NcFile::nc4};
+    int old_fill_mode = 0;
+    nc_set_fill(nc_file.getId(), NC_NOFILL, &old_fill_mode);
+
+    const netCDF::NcDim catchment_dim = nc_file.addDim("catchment-id", catchments);
+    const netCDF::NcDim time_dim      = nc_file.addDim("time", steps);
+    const std::vector<netCDF::NcDim> dims = { catchment_dim, time_dim };
+
+    netCDF::NcVar ids = nc_file.addVar("ids", netCDF::ncString, catchment_dim);
+
+    netCDF::NcVar time_var = nc_file.addVar("Time", netCDF::ncDouble, dims);
+    std::vector<size_t> time_chunks = { 1, steps };
+    time_var.setChunking(netCDF::NcVar::nc_CHUNKED, time_chunks);
+    if (options.deflate_level > 0) {
+        time_var.setCompression(true, true, options.deflate_level);
+    }
+    time_var.putAtt("units", "s");
+    time_var.putAtt("epoch_start", "01/01/1970 00:00:00");
+
+    std::vector<netCDF::NcVar> variables;
+    std::vector<size_t> variable_chunks = { chunk_catchments, 1 };
+    for (const auto& variable : layout.variables) {
+        netCDF::NcVar var = nc_file.addVar(variable.name, options.double_precision ? netCDF::ncDouble : netCDF::ncFloat, dims);
+        var.setChunking(netCDF::NcVar::nc_CHUNKED, variable_chunks);
+        if (options.deflate_level > 0) {
+            var.setCompression(true, true, options.deflate_level);
+        }
+        if (!variable.units.empty()) {
+            var.putAtt("units", variable.units);
+        }
+        variables.push_back(var);
+    }
+
+    std::vector<const char*> id_values;
+    for (const auto& file : files) {
+        id_values.push_back(file.id.c_str());
+    }
+    ids.putVar(std::vector<size_t>{ 0 }, std::vector<size_t>{ catchments }, id_values.data());
+
+    // Every catchment has the same times, so one block of them serves every block of catchments
+    std::vector<double> time_values(block_catchments * steps);
+    for (std::size_t row = 0; row < block_catchments; row++) {
+        std::copy(layout.times.begin(), layout.times.end(), time_values.begin() + row * steps);
+    }
+
+    // Files are parsed on the pool one block ahead of the block being written. The pool is
+    // declared after the blocks and the failure flag so that it finishes any queued reads,
+    // which skip their work once one has failed, before they are freed.
+    std::unique_ptr<forcing_block> current, next;
+    std::atomic<bool> failed{false};
+    ngen::thread_pool pool{options.threads};
+
+    current = read_block(pool, files, layout, 0, block_catchments, failed);
+    while (current != nullptr) {
+        for (auto& pending : current->pending) {
+            pending.get();
+        }
+
+        const std::size_t next_first = current->first + current->count;
+        if (next_first < catchments) {
+            next = read_block(pool, files, layout, next_first, std::min(block_catchments, catchments - next_first), failed);
+        }
+
+        const std::vector<size_t> start = { current->first, 0 };
+        const std::vector<size_t> count = { current->count, steps };
+        time_var.putVar(start, count, time_values.data());
+        for (std::size_t v = 0; v < variables.size(); v++) {
+            variables[v].putVar(start, count, current->values[v].data());
+        }
+
+        progress << "Converted " << next_first << " of " << catchments << " catchments" << std::endl;
+        current = std::move(next);
+    }
+
+    nc_file.close();
+
+    return { catchments, layout.variables.size(), steps };
+}
+
+} // namespace data_access
+
+#endif // NGEN_WITH_NETCDF
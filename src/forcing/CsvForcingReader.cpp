@@ -0,0 +1,312 @@
+#include "CsvForcingReader.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <time.h>
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include "mapped_file.hpp"
+#include "trace_recorder.hpp"
+
+namespace data_access {
+
+namespace {
+
+bool is_blank(char c) noexcept
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+void trim(const char*& begin, const char*& end) noexcept
+{
+    while (begin < end && is_blank(*begin))
+        begin++;
+    while (end > begin && is_blank(end[-1]))
+        end--;
+}
+
+/**
+ * Parse the unsigned decimal integer at @p p, advancing past it
+ */
+bool parse_unsigned(const char*& p, const char* end, long& value) noexcept
+{
+    const char* const start = p;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9' && p - start < 9) {
+        value = value * 10 + (*p - '0');
+        p++;
+    }
+    return p > start;
+}
+
+/**
+ * Days from 1970-01-01 to a date in the proleptic Gregorian calendar
+ */
+long days_from_civil(long year, long month, long day) noexcept
+{
+    year -= month <= 2;
+    const long era = (year >= 0 ? year : year - 399) / 400;
+    const long year_of_era = year - era * 400;
+    const long day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const long day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * Parse a `%Y-%m-%d %H:%M:%S` UTC time to epoch seconds.
+ *
+ * Times written plainly are converted directly, and any others are left to strptime and timegm,
+ * as they were before, so that the same times result.
+ */
+time_t parse_time(const char* begin, const char* end)
+{
+    const char* p = begin;
+    trim(p, end);
+
+    long fields[6];
+    const char separators[] = "-- ::";
+    bool plain = true;
+    for (int i = 0; i < 6 && plain; i++) {
+        if (i > 0) {
+            if (p < end && *p == separators[i - 1])
+                p++;
+            else
+                plain = false;
+        }
+        plain = plain && parse_unsigned(p, end, fields[i]);
+    }
+    plain = plain && p == end
+        && fields[1] >= 1 && fields[1] <= 12 && fields[2] >= 1 && fields[2] <= 31
+        && fields[3] <= 23 && fields[4] <= 59 && fields[5] <= 60;
+
+    if (plain) {
+        return static_cast<time_t>(days_from_civil(fields[0], fields[1], fields[2])) * 86400
+            + fields[3] * 3600 + fields[4] * 60 + fields[5];
+    }
+
+    const std::string text(begin, end);
+    struct tm time_utc = tm();
+    strptime(text.c_str(), "%Y-%m-%d %H:%M:%S", &time_utc);
+    return timegm(&time_utc);
+}
+
+/**
+ * Parse a number with strtod, which needs it to be terminated
+ */
+bool parse_double_slow(const char* begin, const char* end, double& value)
+{
+    const std::string text(begin, end);
+    char* parsed_end = nullptr;
+    value = std::strtod(text.c_str(), &parsed_end);
+    return !text.empty() && parsed_end == text.c_str() + text.size();
+}
+
+/**
+ * Parse a decimal number, with the same result as strtod.
+ *
+ * A number with at most 19 significant digits is read into an integer. When that integer and the
+ * power of ten scaling it are both exact doubles, a single multiplication or division of the two
+ * is correctly rounded, so gives the same value strtod would. Every other number, including
+ * infinities and NaN, is parsed by strtod.
+ */
+bool parse_double(const char* begin, const char* end, double& value)
+{
+    static const double powers_of_ten[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    trim(begin, end);
+
+    const char* p = begin;
+    const bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+'))
+        p++;
+
+    std::uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int digits = 0;
+    long exponent = 0;
+
+    for (; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+        if (mantissa != 0 || *p != '0') {
+            if (++significant_digits > 19)
+                return parse_double_slow(begin, end, value);
+            mantissa = mantissa * 10 + (*p - '0');
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+            if (mantissa != 0 || *p != '0') {
+                if (++significant_digits > 19)
+                    return parse_double_slow(begin, end, value);
+                mantissa = mantissa * 10 + (*p - '0');
+            }
+            exponent--;
+        }
+    }
+    if (digits == 0)
+        return parse_double_slow(begin, end, value);
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        const bool negative_exponent = p < end && *p == '-';
+        if (p < end && (*p == '-' || *p == '+'))
+            p++;
+        long written = 0;
+        if (!parse_unsigned(p, end, written))
+            return parse_double_slow(begin, end, value);
+        exponent += negative_exponent ? -written : written;
+    }
+    if (p != end)
+        return parse_double_slow(begin, end, value);
+
+    if (mantissa == 0) {
+        value = negative ? -0.0 : 0.0;
+        return true;
+    }
+    if (mantissa > (std::uint64_t(1) << 53) || exponent < -22 || exponent > 22)
+        return parse_double_slow(begin, end, value);
+
+    value = static_cast<double>(mantissa);
+    value = exponent < 0 ? value / powers_of_ten[-exponent] : value * powers_of_ten[exponent];
+    if (negative)
+        value = -value;
+    return true;
+}
+
+} // namespace
+
+void parse_csv_forcing_column(const std::string& header, std::string& name, std::string& units)
+{
+    name = header;
+    units = "";
+
+    boost::trim(name); // remove leading/trailing ws
+    if (name.empty())
+        return;
+
+    const auto name_close = name.back();
+    if (name_close == ']' || name_close == ')') {
+        // found closing bracket/parenth
+
+        const bool is_bracket = name_close == ']';
+        const size_t name_open = is_bracket ? name.rfind('[') : name.rfind('(');
+        if (name_open != std::string::npos) {
+            // found matching opening bracket/parenth
+
+            units = name.substr(name_open + 1);
+            units.pop_back(); // remove closing bracket
+
+            name = name.substr(0, name_open);
+            boost::trim(name); // trim again in case of ws between name and units
+        }
+    }
+}
+
+CsvForcingTable read_csv_forcing(const std::string& path, time_t start_time, time_t end_time)
+{
+    ngen::trace::scoped_event read_event("forcing", "csv_read");
+
+    const ngen::mapped_file file{path, "forcing file"};
+    file.advise_sequential();
+
+    const char* p = file.data();
+    const char* const file_end = p + file.size();
+
+    const auto line_end = [file_end](const char* line) {
+        const void* found = std::memchr(line, '\n', file_end - line);
+        return found == nullptr ? file_end : static_cast<const char*>(found);
+    };
+
+    CsvForcingTable table;
+
+    // Header
+    const char* end = line_end(p);
+    const char* content_end = end > p && end[-1] == '\r' ? end - 1 : end;
+    for (const char* cell = p;;) {
+        const void* comma = std::memchr(cell, ',', content_end - cell);
+        const char* cell_end = comma == nullptr ? content_end : static_cast<const char*>(comma);
+        table.header.emplace_back(cell, cell_end);
+        if (comma == nullptr)
+            break;
+        cell = cell_end + 1;
+    }
+    for (std::size_t c = 0; c < table.header.size(); c++) {
+        if (table.header[c] == "Time" || table.header[c] == "time")
+            table.time_column = c;
+    }
+    table.columns.resize(table.header.size());
+    p = end < file_end ? end + 1 : file_end;
+
+    // Rows
+    std::size_t line_number = 1;
+    for (const char* next = p; p < file_end; p = next) {
+        line_number++;
+        end = line_end(p);
+        next = end < file_end ? end + 1 : file_end;
+        content_end = end > p && end[-1] == '\r' ? end - 1 : end;
+
+        // A blank line has no usable time, so is never within the window
+        if (content_end == p)
+            continue;
+
+        // Find the time first, to pass over rows before the window without reading their values
+        const char* cell = p;
+        for (std::size_t c = 0; c < table.time_column && cell != nullptr; c++) {
+            const void* comma = std::memchr(cell, ',', content_end - cell);
+            cell = comma == nullptr ? nullptr : static_cast<const char*>(comma) + 1;
+        }
+        time_t time = 0;
+        if (cell != nullptr) {
+            const void* comma = std::memchr(cell, ',', content_end - cell);
+            time = parse_time(cell, comma == nullptr ? content_end : static_cast<const char*>(comma));
+        }
+        else {
+            time = parse_time(content_end, content_end);
+        }
+
+        if (table.rows_read == 0)
+            table.first_time = time;
+        table.rows_read++;
+        table.last_time = time;
+
+        if (time > end_time)
+            break;
+        if (time < start_time)
+            continue;
+
+        table.times.push_back(time);
+        const char* value_begin = p;
+        for (std::size_t c = 0;; c++) {
+            const void* comma = std::memchr(value_begin, ',', content_end - value_begin);
+            const char* value_end = comma == nullptr ? content_end : static_cast<const char*>(comma);
+
+            if (c >= table.header.size())
+                throw std::runtime_error(
+                    "Forcing file " + path + " has more values than columns on line " + std::to_string(line_number)
+                );
+            if (c != table.time_column) {
+                double value;
+                if (!parse_double(value_begin, value_end, value))
+                    throw std::runtime_error(
+                        "Forcing file " + path + " has a value that is not a number on line " +
+                        std::to_string(line_number) + ": '" + std::string(value_begin, value_end) + "'"
+                    );
+                table.columns[c].push_back(value);
+            }
+
+            if (comma == nullptr)
+                break;
+            value_begin = value_end + 1;
+        }
+    }
+
+    return table;
+}
+
+} // namespace data_access
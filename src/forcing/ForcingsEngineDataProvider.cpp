@@ -1,6 +1,7 @@
 #include <forcing/ForcingsEngineDataProvider.hpp>
 #include <utilities/python/InterpreterUtil.hpp>
 
+#include <algorithm>
 #include <ctime> // timegm
 #include <iomanip> // std::get_time
 
@@ -44,5 +45,209 @@ void assert_forcings_engine_requirements()
     }
 }
 
+ForcingsEngineSnapshots::ForcingsEngineSnapshots(std::shared_ptr<bmi_type> bmi, std::vector<std::string> variables)
+  : bmi_(std::move(bmi))
+  , time_step_(std::lround(bmi_->GetTimeStep()))
+  , variables_(std::move(variables))
+{
+    offsets_.reserve(variables_.size() + 1);
+    offsets_.push_back(0);
+    for (const auto& variable : variables_) {
+        if (bmi_->GetVarItemsize(variable) != sizeof(double)) {
+            throw std::runtime_error{"ForcingsEngineSnapshots: output variable `" + variable + "` is not an array of doubles."};
+        }
+        offsets_.push_back(offsets_.back() + static_cast<std::size_t>(bmi_->GetVarNbytes(variable)) / sizeof(double));
+    }
+}
+
+ForcingsEngineSnapshots::~ForcingsEngineSnapshots()
+{
+    disable_lookahead();
+}
+
+boost::span<const double> ForcingsEngineSnapshots::values(std::size_t step, std::size_t variable)
+{
+    if (snapshots_.empty() || step >= first_step_ + snapshots_.size()) {
+        advance_(step);
+    }
+    else if (step < first_step_) {
+        throw std::out_of_range{
+            "ForcingsEngineSnapshots: time step " + std::to_string(step)
+            + " is before the earliest kept, " + std::to_string(first_step_)
+        };
+    }
+
+    const auto& snapshot = snapshots_[step - first_step_];
+    return boost::span<const double>{ snapshot.data() + offsets_[variable], offsets_[variable + 1] - offsets_[variable] };
+}
+
+std::size_t ForcingsEngineSnapshots::variable_index(const std::string& name) const
+{
+    const auto pos = std::find(variables_.begin(), variables_.end(), name);
+    if (pos == variables_.end()) {
+        throw std::out_of_range{"ForcingsEngineSnapshots: variable `" + name + "` is not copied."};
+    }
+
+    return std::distance(variables_.begin(), pos);
+}
+
+void ForcingsEngineSnapshots::reserve(std::size_t steps)
+{
+    capacity_ = std::max(capacity_, steps);
+}
+
+void ForcingsEngineSnapshots::settle()
+{
+    if (ahead_pending_) {
+        take_ahead_();
+    }
+}
+
+bool ForcingsEngineSnapshots::ahead_ready()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ahead_state_ == ahead_state::ready;
+}
+
+void ForcingsEngineSnapshots::enable_lookahead(std::size_t last_step)
+{
+    lookahead_ = true;
+    last_step_ = last_step;
+}
+
+void ForcingsEngineSnapshots::disable_lookahead()
+{
+    lookahead_ = false;
+
+    if (ahead_pending_) {
+        try {
+            take_ahead_();
+        }
+        catch (...) {
+            // The time step is advanced to again when it is next requested
+        }
+    }
+
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        requested_.notify_one();
+        worker_.join();
+        stopping_ = false;
+        utils::ngenPy::concurrentPythonThreads()--;
+    }
+}
+
+void ForcingsEngineSnapshots::advance_(std::size_t step)
+{
+    // The time step worked on ahead is always the one after the latest kept
+    if (ahead_pending_) {
+        take_ahead_();
+    }
+
+    // With no earlier snapshot to follow on from, go straight to the step
+    if (snapshots_.empty()) {
+        first_step_ = step;
+    }
+
+    for (std::size_t next = first_step_ + snapshots_.size(); next <= step; next++) {
+        utils::ngenPy::ConcurrentGilAcquire gil;
+        bmi_->UpdateUntil(static_cast<double>((next * time_step_).count()));
+        copy_(spare_);
+        keep_(spare_);
+    }
+
+    if (!lookahead_ || step >= last_step_) {
+        return;
+    }
+
+    if (!worker_.joinable()) {
+        // Counted before it starts, so calls into Python on this thread acquire the GIL from now on
+        utils::ngenPy::concurrentPythonThreads()++;
+        worker_ = std::thread{&ForcingsEngineSnapshots::work_, this};
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ahead_step_ = step + 1;
+        ahead_state_ = ahead_state::requested;
+    }
+    ahead_pending_ = true;
+    requested_.notify_one();
+}
+
+void ForcingsEngineSnapshots::copy_(std::vector<double>& snapshot)
+{
+    snapshot.resize(offsets_.back());
+    for (std::size_t i = 0; i < variables_.size(); i++) {
+        const auto* values = static_cast<const double*>(bmi_->GetValuePtr(variables_[i]));
+        std::copy(values, values + (offsets_[i + 1] - offsets_[i]), snapshot.begin() + offsets_[i]);
+    }
+}
+
+void ForcingsEngineSnapshots::keep_(std::vector<double>& snapshot)
+{
+    std::vector<double> earliest;
+    if (snapshots_.size() >= capacity_) {
+        earliest = std::move(snapshots_.front());
+        snapshots_.pop_front();
+        first_step_++;
+    }
+
+    snapshots_.push_back(std::move(snapshot));
+    snapshot = std::move(earliest);
+}
+
+void ForcingsEngineSnapshots::take_ahead_()
+{
+    std::exception_ptr error;
+    {
+        // The look-ahead thread needs the GIL to finish
+        utils::ngenPy::GilRelease released;
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this] { return ahead_state_ == ahead_state::ready; });
+        ahead_state_ = ahead_state::idle;
+        std::swap(error, ahead_error_);
+    }
+    ahead_pending_ = false;
+
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+
+    keep_(ahead_);
+}
+
+void ForcingsEngineSnapshots::work_()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        requested_.wait(lock, [this] { return stopping_ || ahead_state_ == ahead_state::requested; });
+        if (stopping_) {
+            return;
+        }
+
+        const std::size_t step = ahead_step_;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            py::gil_scoped_acquire gil;
+            bmi_->UpdateUntil(static_cast<double>((step * time_step_).count()));
+            copy_(ahead_);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        ahead_error_ = error;
+        ahead_state_ = ahead_state::ready;
+        ready_.notify_one();
+    }
+}
+
 } // namespace detail
 } // namespace data_access
@@ -1,4 +1,5 @@
 #include "DataProvider.hpp"
+#include <algorithm>
 #include <chrono>
 #include <forcing/ForcingsEngineLumpedDataProvider.hpp>
 
@@ -23,7 +24,8 @@ Provider::ForcingsEngineLumpedDataProvider(
     const std::string& init,
     std::size_t time_begin_seconds,
     std::size_t time_end_seconds,
-    const std::string& divide_id
+    const std::string& divide_id,
+    std::size_t window_seconds
 )
   : BaseProvider(init, time_begin_seconds, time_end_seconds)
 {
@@ -57,6 +59,16 @@ Provider::ForcingsEngineLumpedDataProvider(
     } else {
         divide_idx_ = std::distance(cat_id_span.begin(), divide_id_pos);
     }
+
+    snapshots_ = storage_type::instances.get_snapshots(init);
+    if (snapshots_ == nullptr) {
+        snapshots_ = std::make_shared<detail::ForcingsEngineSnapshots>(bmi_, var_output_names_);
+        storage_type::instances.set_snapshots(init, snapshots_);
+    }
+
+    // Keep the time steps of this provider's windows before another provider's reads can drop them
+    const auto window = std::max<clock_type::duration>(std::chrono::seconds{window_seconds}, time_step_);
+    snapshots_->reserve((window + time_step_ - clock_type::duration{1}) / time_step_);
 }
 
 std::size_t Provider::divide() const noexcept
@@ -69,6 +81,24 @@ std::size_t Provider::divide_index() const noexcept
     return divide_idx_;
 }
 
+Provider::~ForcingsEngineLumpedDataProvider()
+{
+    if (lookahead_) {
+        snapshots_->disable_lookahead();
+    }
+}
+
+void Provider::lookahead(bool enabled)
+{
+    lookahead_ = enabled;
+    if (enabled) {
+        snapshots_->enable_lookahead((time_end_ - time_begin_) / time_step_);
+    }
+    else {
+        snapshots_->disable_lookahead();
+    }
+}
+
 Provider::data_type Provider::get_value(
     const Provider::selection_type& selector,
     data_access::ReSampleMethod m
@@ -76,7 +106,7 @@ Provider::data_type Provider::get_value(
 {
     assert(divide_id_ == convert_divide_id_stoi(selector.get_id()));
 
-    auto variable = ensure_variable(selector.get_variable_name());
+    const auto variable = snapshots_->variable_index(ensure_variable(selector.get_variable_name()));
 
     if (m == ReSampleMethod::SUM || m == ReSampleMethod::MEAN) {
         double acc = 0.0;
@@ -86,16 +116,18 @@ Provider::data_type Provider::get_value(
         const auto end = std::chrono::seconds{selector.get_duration_secs()} + start;
         assert(end <= time_end_);
 
+        // Keep every time step of the window until the other providers have read it too
+        snapshots_->reserve((end - start + time_step_ - clock_type::duration{1}) / time_step_);
+
         auto current = start;
         while (current < end) {
             current += time_step_;
-            bmi_->UpdateUntil(std::chrono::duration_cast<std::chrono::seconds>(current - time_begin_).count());
-            acc += static_cast<double*>(bmi_->GetValuePtr(variable))[divide_idx_];
+            acc += value_at_(current, variable);
         }
 
         if (m == ReSampleMethod::MEAN) {
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>(current - start).count();
-            auto num_time_steps = duration / time_step_.count();
+            // time_step_ is in clock ticks, so count the steps by dividing durations
+            auto num_time_steps = (current - start) / time_step_;
             acc /= num_time_steps;
         }
 
@@ -112,7 +144,7 @@ std::vector<Provider::data_type> Provider::get_values(
 {
     assert(divide_id_ == convert_divide_id_stoi(selector.get_id()));
 
-    auto variable = ensure_variable(selector.get_variable_name());
+    const auto variable = snapshots_->variable_index(ensure_variable(selector.get_variable_name()));
 
     const auto start = clock_type::from_time_t(selector.get_init_time());
     assert(start >= time_begin_);
@@ -120,15 +152,102 @@ std::vector<Provider::data_type> Provider::get_values(
     const auto end = std::chrono::seconds{selector.get_duration_secs()} + start;
     assert(end <= time_end_);
 
+    snapshots_->reserve((end - start + time_step_ - clock_type::duration{1}) / time_step_);
+
     std::vector<double> values;
     auto current = start;
     while (current < end) {
         current += time_step_;
-        bmi_->UpdateUntil(std::chrono::duration_cast<std::chrono::seconds>(current - time_begin_).count());
-        values.push_back(static_cast<double*>(bmi_->GetValuePtr(variable))[divide_idx_]);
+        values.push_back(value_at_(current, variable));
     }
 
     return values;
 }
 
+CatchmentBatch Provider::get_batch(std::vector<std::string> ids) const
+{
+    snapshots_->settle();
+    utils::ngenPy::ConcurrentGilAcquire gil;
+
+    const auto cat_id_span = boost::span<const int>(
+        static_cast<const int*>(bmi_->GetValuePtr("CAT-ID")),
+        static_cast<std::size_t>(bmi_->GetVarNbytes("CAT-ID") / bmi_->GetVarItemsize("CAT-ID"))
+    );
+
+    CatchmentBatch batch{std::move(ids), {}};
+    batch.positions.reserve(batch.ids.size());
+    for (const auto& id : batch.ids) {
+        const auto divide_id = static_cast<int>(convert_divide_id_stoi(id));
+        const auto divide_id_pos = std::find(cat_id_span.begin(), cat_id_span.end(), divide_id);
+        if (divide_id_pos == cat_id_span.end()) {
+            throw std::out_of_range{"Divide ID `" + id + "` is not in the Forcings Engine domain"};
+        }
+        batch.positions.push_back(std::distance(cat_id_span.begin(), divide_id_pos));
+    }
+
+    return batch;
+}
+
+void Provider::get_batch_values(
+    const CatchmentBatch& batch,
+    const Provider::selection_type& selector,
+    boost::span<Provider::data_type> values,
+    data_access::ReSampleMethod m
+)
+{
+    if (values.size() != batch.positions.size()) {
+        throw std::invalid_argument{
+            "Got " + std::to_string(values.size()) + " values to write for a batch of "
+            + std::to_string(batch.positions.size()) + " divides"
+        };
+    }
+
+    if (m != ReSampleMethod::SUM && m != ReSampleMethod::MEAN) {
+        throw std::runtime_error{"Given ReSampleMethod " + std::to_string(m) + " not implemented."};
+    }
+
+    const auto variable = snapshots_->variable_index(ensure_variable(selector.get_variable_name()));
+
+    const auto start = clock_type::from_time_t(selector.get_init_time());
+    assert(start >= time_begin_);
+
+    const auto end = std::chrono::seconds{selector.get_duration_secs()} + start;
+    assert(end <= time_end_);
+
+    snapshots_->reserve((end - start + time_step_ - clock_type::duration{1}) / time_step_);
+
+    const auto last_position = batch.positions.empty()
+        ? 0 : *std::max_element(batch.positions.begin(), batch.positions.end());
+
+    std::fill(values.begin(), values.end(), 0.0);
+    auto current = start;
+    while (current < end) {
+        current += time_step_;
+        const auto step_values = snapshots_->values((current - time_begin_) / time_step_, variable);
+        if (last_position >= step_values.size()) {
+            throw std::out_of_range{"Batch position " + std::to_string(last_position) + " is not in the Forcings Engine domain"};
+        }
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            values[i] += step_values[batch.positions[i]];
+        }
+    }
+
+    if (m == ReSampleMethod::MEAN) {
+        const auto num_time_steps = (current - start) / time_step_;
+        for (auto& value : values) {
+            value /= num_time_steps;
+        }
+    }
+}
+
+Provider::data_type Provider::value_at_(clock_type::time_point time, std::size_t variable) const
+{
+    const auto values = snapshots_->values((time - time_begin_) / time_step_, variable);
+    if (divide_idx_ >= values.size()) {
+        throw std::out_of_range{"Divide ID `" + std::to_string(divide_id_) + "` is not in the Forcings Engine domain"};
+    }
+
+    return values[divide_idx_];
+}
+
 } // namespace data_access
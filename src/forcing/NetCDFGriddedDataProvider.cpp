@@ -0,0 +1,468 @@
+#include <NGenConfig.h>
+
+#if NGEN_WITH_NETCDF
+#include "NetCDFGriddedDataProvider.hpp"
+#include "AorcForcing.hpp"
+#include "trace_recorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include <UnitsHelper.hpp>
+#include <FeatureBuilder.hpp>
+
+#include <netcdf>
+
+std::mutex data_access::NetCDFGriddedDataProvider::shared_providers_mutex;
+std::map<std::string, std::shared_ptr<data_access::NetCDFGriddedDataProvider>> data_access::NetCDFGriddedDataProvider::shared_providers;
+
+namespace data_access {
+
+namespace {
+
+/**
+ * Find the first of several possible names of a coordinate among the dimensions of a file
+ */
+netCDF::NcDim find_dimension(const netCDF::NcFile& file, std::initializer_list<const char*> names)
+{
+    for (const char* name : names) {
+        const auto dim = file.getDim(name);
+        if (!dim.isNull()) {
+            return dim;
+        }
+    }
+    return {};
+}
+
+std::vector<double> read_coordinate(const netCDF::NcFile& file, const netCDF::NcDim& dim)
+{
+    const auto var = file.getVar(dim.getName());
+    if (var.isNull() || var.getDimCount() != 1) {
+        throw std::runtime_error("Gridded forcing file has no coordinate variable for dimension " + dim.getName());
+    }
+
+    std::vector<double> values(dim.getSize());
+    var.getVar(values.data());
+    return values;
+}
+
+std::string get_string_attribute(const netCDF::NcVar& var, const std::string& name)
+{
+    std::string value;
+    const auto atts = var.getAtts();
+    const auto att = atts.find(name);
+    if (att != atts.end()) {
+        att->second.getValues(value);
+    }
+    return value;
+}
+
+std::vector<double> get_double_attribute(const netCDF::NcVar& var, const std::string& name)
+{
+    const auto atts = var.getAtts();
+    const auto att = atts.find(name);
+    if (att == atts.end()) {
+        return {};
+    }
+
+    std::vector<double> values(att->second.getAttLength());
+    att->second.getValues(values.data());
+    return values;
+}
+
+/**
+ * Parse CF time units, such as `hours since 2016-01-01 00:00:00`, into seconds per unit and epoch time
+ */
+void parse_time_units(const std::string& units, double& scale, time_t& epoch)
+{
+    const auto since = units.find(" since ");
+    if (since == std::string::npos) {
+        throw std::runtime_error("Gridded forcing file has time units '" + units + "', which are not of the form '<units> since <time>'");
+    }
+
+    const std::string unit = units.substr(0, since);
+    if (unit == "seconds" || unit == "second" || unit == "s") {
+        scale = 1;
+    }
+    else if (unit == "minutes" || unit == "minute" || unit == "min") {
+        scale = 60;
+    }
+    else if (unit == "hours" || unit == "hour" || unit == "h") {
+        scale = 3600;
+    }
+    else if (unit == "days" || unit == "day" || unit == "d") {
+        scale = 86400;
+    }
+    else {
+        throw std::runtime_error("Gridded forcing file has unknown time units '" + unit + "'");
+    }
+
+    const std::string reference = units.substr(since + 7);
+    std::tm tm{};
+    if (strptime(reference.c_str(), "%Y-%m-%d %H:%M:%S", &tm) == nullptr) {
+        tm = std::tm{};
+        if (strptime(reference.c_str(), "%Y-%m-%d", &tm) == nullptr) {
+            throw std::runtime_error("Gridded forcing file has time units with an unreadable reference time '" + reference + "'");
+        }
+    }
+    epoch = timegm(&tm);
+}
+
+} // namespace
+
+std::shared_ptr<NetCDFGriddedDataProvider> NetCDFGriddedDataProvider::get_shared_provider(std::string input_path, std::string geometry_path, time_t sim_start, time_t sim_end, utils::StreamHandler log_s)
+{
+    {
+        const std::lock_guard<std::mutex> lock(shared_providers_mutex);
+        const auto existing = shared_providers.find(input_path);
+        if (existing != shared_providers.end()) {
+            return existing->second;
+        }
+    }
+
+    if (geometry_path.empty()) {
+        throw std::runtime_error("Gridded forcing from " + input_path + " requires a geometry_path to the catchment polygons");
+    }
+
+    // Reading the polygons and weighting the grid is slow, so it is done without holding the lock,
+    // and a provider made meanwhile by another thread for the same path is kept instead of this one
+    std::vector<std::string> ids;
+    std::vector<geojson::multipolygon_t> catchments;
+    const geojson::GeoJSON geometries = geojson::read(geometry_path);
+    for (const auto& feature : *geometries) {
+        const auto geometry = feature->geometry();
+        if (const auto* polygon = boost::get<geojson::polygon_t>(&geometry)) {
+            catchments.emplace_back(geojson::multipolygon_t{ *polygon });
+        }
+        else if (const auto* multipolygon = boost::get<geojson::multipolygon_t>(&geometry)) {
+            catchments.emplace_back(*multipolygon);
+        }
+        else {
+            continue;
+        }
+        ids.push_back(feature->get_id());
+    }
+
+    auto p = std::make_shared<data_access::NetCDFGriddedDataProvider>(input_path, std::move(ids), catchments, sim_start, sim_end, log_s);
+
+    const std::lock_guard<std::mutex> lock(shared_providers_mutex);
+    return shared_providers.emplace(input_path, std::move(p)).first->second;
+}
+
+void NetCDFGriddedDataProvider::cleanup_shared_providers()
+{
+    const std::lock_guard<std::mutex> lock(shared_providers_mutex);
+    shared_providers.clear();
+}
+
+NetCDFGriddedDataProvider::NetCDFGriddedDataProvider(
+    std::string input_path,
+    std::vector<std::string> ids,
+    const std::vector<geojson::multipolygon_t>& catchments,
+    time_t sim_start,
+    time_t sim_end,
+    utils::StreamHandler log_s
+)
+  : sim_start_date_time_epoch(sim_start)
+  , sim_end_date_time_epoch(sim_end)
+  , loc_ids(std::move(ids))
+  , log_stream(log_s)
+  , value_cache(20)
+{
+    for (size_t i = 0; i < loc_ids.size(); ++i) {
+        id_pos[loc_ids[i]] = i;
+    }
+
+    nc_file = std::make_shared<netCDF::NcFile>(input_path, netCDF::NcFile::read);
+
+    // Find the grid from its cell centers, which are evenly spaced and may run in either direction
+    const auto x_dim = find_dimension(*nc_file, { "x", "lon", "longitude" });
+    const auto y_dim = find_dimension(*nc_file, { "y", "lat", "latitude" });
+    if (x_dim.isNull() || y_dim.isNull()) {
+        throw std::runtime_error("Gridded forcing file " + input_path + " has no x and y dimensions");
+    }
+
+    const auto xs = read_coordinate(*nc_file, x_dim);
+    const auto ys = read_coordinate(*nc_file, y_dim);
+    if (xs.size() < 2 || ys.size() < 2) {
+        throw std::runtime_error("Gridded forcing file " + input_path + " must have at least two cells in x and y");
+    }
+
+    const double dx = (xs.back() - xs.front()) / static_cast<double>(xs.size() - 1);
+    const double dy = (ys.back() - ys.front()) / static_cast<double>(ys.size() - 1);
+    const bool y_descending = dy < 0;
+    const double xmin = std::min(xs.front(), xs.back()) - std::abs(dx) / 2;
+    const double ymin = std::min(ys.front(), ys.back()) - std::abs(dy) / 2;
+
+    const GridSpecification grid{
+        ys.size(),
+        xs.size(),
+        box_t{ { xmin, ymin }, { xmin + std::abs(dx) * xs.size(), ymin + std::abs(dy) * ys.size() } }
+    };
+
+    weights = compute_zonal_weights(grid, catchments);
+
+    // Read only the window of rows and columns that the catchments cover, in the file's row order
+    size_t row_min = grid.rows, row_max = 0, col_min = grid.columns, col_max = 0;
+    for (size_t zone = 0; zone < weights.zones(); ++zone) {
+        for (const auto cell : weights.cells(zone)) {
+            const size_t col = cell % grid.columns;
+            const size_t row = y_descending ? grid.rows - 1 - cell / grid.columns : cell / grid.columns;
+            row_min = std::min(row_min, row);
+            row_max = std::max(row_max, row + 1);
+            col_min = std::min(col_min, col);
+            col_max = std::max(col_max, col + 1);
+        }
+    }
+
+    if (row_min < row_max) {
+        window_start = { row_min, col_min };
+        window_count = { row_max - row_min, col_max - col_min };
+    }
+
+    const size_t columns = grid.columns, rows = grid.rows, window_columns = window_count[1];
+    weights.remap_cells([=](ZonalWeights::cell_index cell) {
+        const size_t col = cell % columns;
+        const size_t row = y_descending ? rows - 1 - cell / columns : cell / columns;
+        return static_cast<ZonalWeights::cell_index>((row - row_min) * window_columns + (col - col_min));
+    });
+
+    // Variables over (time, y, x)
+    for (const auto& element : nc_file->getVars()) {
+        const auto& ncvar = element.second;
+        const auto dims = ncvar.getDims();
+        if (dims.size() != 3 || dims[0].getName() != "time" || dims[1] != y_dim || dims[2] != x_dim) {
+            continue;
+        }
+
+        const std::string var_name = element.first;
+        std::string native_units = get_string_attribute(ncvar, "units");
+
+        Packing packing;
+        const auto scale_factor = get_double_attribute(ncvar, "scale_factor");
+        const auto add_offset = get_double_attribute(ncvar, "add_offset");
+        packing.scale_factor = scale_factor.empty() ? 1.0 : scale_factor[0];
+        packing.add_offset = add_offset.empty() ? 0.0 : add_offset[0];
+        packing.missing_values = get_double_attribute(ncvar, "_FillValue");
+        const auto missing_values = get_double_attribute(ncvar, "missing_value");
+        packing.missing_values.insert(packing.missing_values.end(), missing_values.begin(), missing_values.end());
+
+        variable_names.push_back(var_name);
+        ncvar_cache.emplace(var_name, ncvar);
+        packing_cache[var_name] = packing;
+
+        auto wkf = data_access::WellKnownFields.find(var_name);
+        if(wkf != data_access::WellKnownFields.end()){
+            native_units = native_units.empty() ? std::get<1>(wkf->second) : native_units;
+            std::string can_name = std::get<0>(wkf->second); // the CSDMS name
+            variable_names.push_back(can_name);
+            ncvar_cache.emplace(can_name, ncvar);
+            packing_cache[can_name] = packing;
+            units_cache[can_name] = native_units;
+        }
+
+        units_cache[var_name] = native_units;
+    }
+
+    // Times
+    const auto time_var = nc_file->getVar("time");
+    if (time_var.isNull() || time_var.getDimCount() != 1) {
+        throw std::runtime_error("Gridded forcing file " + input_path + " has no time coordinate variable");
+    }
+
+    std::vector<double> raw_time(time_var.getDim(0).getSize());
+    if (raw_time.size() < 2) {
+        throw std::runtime_error("Gridded forcing file " + input_path + " must have at least two time steps");
+    }
+    time_var.getVar(raw_time.data());
+
+    double time_scale_factor = 1;
+    time_t epoch_start_time = 0;
+    parse_time_units(get_string_attribute(time_var, "units"), time_scale_factor, epoch_start_time);
+
+    time_vals.resize(raw_time.size());
+    std::transform(raw_time.begin(), raw_time.end(), time_vals.begin(),
+        [&](const auto& n){return n * time_scale_factor + epoch_start_time; });
+
+    time_stride = time_vals[1] - time_vals[0];
+
+    #ifndef NCEP_OPERATIONS
+    for( size_t i = 1; i < time_vals.size() -1; ++i)
+    {
+        double tinterval = time_vals[i+1] - time_vals[i];
+
+        if ( std::abs(tinterval - time_stride) > 0.000001)
+        {
+            log_stream << "Error: Time intervals are not constant in forcing file\n";
+
+            throw std::runtime_error("Time intervals in forcing file are not constant");
+        }
+    }
+    #endif
+
+    start_time = time_vals[0];
+    stop_time = time_vals.back() + time_stride;
+}
+
+NetCDFGriddedDataProvider::~NetCDFGriddedDataProvider() = default;
+
+void NetCDFGriddedDataProvider::finalize()
+{
+    if (nc_file != nullptr) {
+        nc_file->close();
+    }
+    nc_file = nullptr;
+}
+
+boost::span<const std::string> NetCDFGriddedDataProvider::get_available_variable_names() const
+{
+    return variable_names;
+}
+
+const std::vector<std::string>& NetCDFGriddedDataProvider::get_ids() const
+{
+    return loc_ids;
+}
+
+long NetCDFGriddedDataProvider::get_data_start_time() const
+{
+    //FIXME: Matching behavior from NetCDFPerFeatureDataProvider
+    return sim_start_date_time_epoch;
+}
+
+long NetCDFGriddedDataProvider::get_data_stop_time() const
+{
+    //FIXME: Matching behavior from NetCDFPerFeatureDataProvider
+    return sim_end_date_time_epoch;
+}
+
+long NetCDFGriddedDataProvider::record_duration() const
+{
+    return time_stride;
+}
+
+size_t NetCDFGriddedDataProvider::get_ts_index_for_time(const time_t &epoch_time) const
+{
+    if (start_time <= epoch_time && epoch_time < stop_time)
+    {
+        double offset = epoch_time - start_time;
+        offset /= time_stride;
+        return size_t(offset);
+    }
+    else
+    {
+        std::stringstream ss;
+        ss << "The value " << (int)epoch_time << " was not in the range [" << (int)start_time << "," << (int)stop_time << ")\n" << SOURCE_LOC;
+        throw std::out_of_range(ss.str().c_str());
+    }
+}
+
+std::shared_ptr<std::vector<double>> NetCDFGriddedDataProvider::get_catchment_means(const std::string& name, size_t time_index)
+{
+    const auto ncvar = ncvar_cache.find(name);
+    if (ncvar == ncvar_cache.end()) {
+        throw std::runtime_error("Got request for variable " + name + " but it was not found in the cache. This should not happen." + SOURCE_LOC);
+    }
+
+    // Keyed by the variable in the file, which several names may refer to
+    const std::string key = ncvar->second.getName() + "|" + std::to_string(time_index);
+    if (value_cache.contains(key)) {
+        return value_cache.get(key).get();
+    }
+
+    ngen::trace::scoped_event read_event("forcing", "netcdf_grid_read", time_index);
+
+    std::vector<double> window(window_count[0] * window_count[1]);
+    if (!window.empty()) {
+        ncvar->second.getVar({ time_index, window_start[0], window_start[1] }, { 1, window_count[0], window_count[1] }, window.data());
+    }
+
+    const auto& packing = packing_cache.at(name);
+    for (auto& value : window) {
+        if (std::find(packing.missing_values.begin(), packing.missing_values.end(), value) != packing.missing_values.end()) {
+            value = std::numeric_limits<double>::quiet_NaN();
+        }
+        else {
+            value = value * packing.scale_factor + packing.add_offset;
+        }
+    }
+
+    auto means = std::make_shared<std::vector<double>>(weights.zones());
+    weights.apply(window, *means);
+    value_cache.insert(key, means);
+    return means;
+}
+
+double NetCDFGriddedDataProvider::get_value(const CatchmentAggrDataSelector& selector, ReSampleMethod m)
+{
+    const auto cat_pos = id_pos.find(selector.get_id());
+    if (cat_pos == id_pos.end()) {
+        throw std::out_of_range("Catchment " + selector.get_id() + " has no geometry in the gridded forcing configuration" + SOURCE_LOC);
+    }
+
+    auto init_time = selector.get_init_time();
+    auto end_time = init_time + selector.get_duration_secs();
+
+    size_t idx1 = get_ts_index_for_time(init_time);
+    size_t idx2;
+    try {
+        idx2 = get_ts_index_for_time(end_time-1); // Don't include next timestep when duration % timestep = 0
+    }
+    catch(const std::out_of_range &e){
+        idx2 = get_ts_index_for_time(this->stop_time-1); //to the edge
+    }
+
+    double t1 = time_vals[idx1];
+    double t2 = time_vals[idx2];
+
+    std::vector<double> raw_values;
+    raw_values.reserve(idx2 - idx1 + 1);
+    for (size_t i = idx1; i <= idx2; ++i) {
+        raw_values.push_back((*get_catchment_means(selector.get_variable_name(), i))[cat_pos->second]);
+    }
+
+    // The first and last data values may be only partly within the window
+    double rvalue = 0.0;
+    double a = 1.0 - ( (t1 - init_time) / time_stride );
+    double b = 0.0;
+    rvalue += (a * raw_values[0]);
+
+    for( size_t i = 1; i < raw_values.size() -1; ++i )
+    {
+        rvalue += raw_values[i];
+    }
+
+    if (  raw_values.size() > 1)
+    {
+        b = (end_time - t2) / time_stride;
+        rvalue += (b * raw_values.back() );
+    }
+
+    if (m == MEAN) {
+        double scale_factor = (selector.get_duration_secs() > time_stride ) ? (time_stride / selector.get_duration_secs()) : (1.0 / (a + b));
+        rvalue *= scale_factor;
+    }
+
+    try
+    {
+        return UnitsHelper::get_converted_value(units_cache.at(selector.get_variable_name()), rvalue, selector.get_output_units());
+    }
+    catch (const std::runtime_error& e)
+    {
+        #ifndef UDUNITS_QUIET
+        std::cerr<<"WARN: Unit conversion unsuccessful - Returning unconverted value! (\""<<e.what()<<"\")"<<std::endl;
+        #endif
+        return rvalue;
+    }
+}
+
+std::vector<double> NetCDFGriddedDataProvider::get_values(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m)
+{
+    return std::vector<double>(1, get_value(selector, m));
+}
+
+}
+
+#endif
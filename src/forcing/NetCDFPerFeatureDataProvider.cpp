@@ -2,6 +2,7 @@
 
 #if NGEN_WITH_NETCDF
 #include "NetCDFPerFeatureDataProvider.hpp"
+#include "trace_recorder.hpp"
 
 #include <netcdf>
 
@@ -335,8 +336,6 @@ double NetCDFPerFeatureDataProvider::get_value(const CatchmentAggrDataSelector&
 
     auto stride = idx2 - idx1;
 
-    std::vector<std::size_t> start, count;
-
     auto cat_pos = id_pos[selector.get_id()];
 
 
@@ -359,22 +358,8 @@ double NetCDFPerFeatureDataProvider::get_value(const CatchmentAggrDataSelector&
     size_t cache_slices_t_n = read_len / cache_slice_t_size; // Integer division!
     // For reference: https://stackoverflow.com/a/72030286
     for( size_t i = 0; i < cache_slices_t_n; i++ ) {
-        std::shared_ptr<std::vector<double>> cached;
         int cache_t_idx = (idx1 - (idx1 % cache_slice_t_size) + i);
-        std::string key = ncvar.getName() + "|" + std::to_string(cache_t_idx);
-        if(value_cache.contains(key)){
-            cached = value_cache.get(key).get();
-        } else {
-            cached = std::make_shared<std::vector<double>>(cache_slice_c_size * cache_slice_t_size);
-            start.clear();
-            start.push_back(0); // only always 0 when cache_slice_c_size = numids!
-            start.push_back(cache_t_idx * cache_slice_t_size);
-            count.clear();
-            count.push_back(cache_slice_c_size);
-            count.push_back(cache_slice_t_size); // Must be 1 for now!...probably...
-            ncvar.getVar(start,count,&(*cached)[0]);
-            value_cache.insert(key, cached);
-        }
+        std::shared_ptr<std::vector<double>> cached = get_cache_slice(ncvar, cache_t_idx);
         for( size_t j = 0; j < cache_slice_t_size; j++){
             raw_values[i+j] = cached->at((j*cache_slice_t_size) + cat_pos);
         }
@@ -441,6 +426,80 @@ std::vector<double> NetCDFPerFeatureDataProvider::get_values(const CatchmentAggr
     return std::vector<double>(1, get_value(selector, m));
 }
 
+CatchmentBatch NetCDFPerFeatureDataProvider::get_batch(std::vector<std::string> ids) const
+{
+    CatchmentBatch batch{std::move(ids), {}};
+    batch.positions.reserve(batch.ids.size());
+    for (const auto& id : batch.ids) {
+        auto pos = id_pos.find(id);
+        if (pos == id_pos.end()) {
+            throw std::out_of_range("Catchment " + id + " is not in the forcing file" + SOURCE_LOC);
+        }
+        batch.positions.push_back(pos->second);
+    }
+    return batch;
+}
+
+void NetCDFPerFeatureDataProvider::get_batch_values(const CatchmentBatch& batch, const CatchmentAggrDataSelector& selector, boost::span<double> values, ReSampleMethod m)
+{
+    if (values.size() != batch.positions.size()) {
+        throw std::invalid_argument("Got " + std::to_string(values.size()) + " values to write for a batch of "
+                                    + std::to_string(batch.positions.size()) + " catchments" + SOURCE_LOC);
+    }
+
+    auto init_time = selector.get_init_time();
+    auto end_time = init_time + selector.get_duration_secs();
+
+    size_t idx1 = get_ts_index_for_time(init_time);
+    size_t idx2;
+    try {
+        idx2 = get_ts_index_for_time(end_time-1); // Don't include next timestep when duration % timestep = 0
+    }
+    catch(const std::out_of_range &e){
+        idx2 = get_ts_index_for_time(this->stop_time-1); //to the edge
+    }
+
+    double t1 = time_vals[idx1];
+    double t2 = time_vals[idx2];
+
+    const auto& ncvar = get_ncvar(selector.get_variable_name());
+    const std::string& native_units = get_ncvar_units(selector.get_variable_name());
+
+    auto read_len = idx2 - idx1 + 1;
+
+    // Weights of the time steps as in get_value: the first and last may be partly in the period
+    double a = 1.0 - ( (t1 - init_time) / time_stride );
+    double b = read_len > 1 ? (end_time - t2) / time_stride : 0.0;
+
+    std::fill(values.begin(), values.end(), 0.0);
+    for( size_t i = 0; i < read_len; i++ ) {
+        double weight = i == 0 ? a : (i == read_len - 1 ? b : 1.0);
+        auto cached = get_cache_slice(ncvar, idx1 - (idx1 % cache_slice_t_size) + i);
+        const double* slice = cached->data();
+        for( size_t k = 0; k < values.size(); k++ ) {
+            values[k] += weight * slice[batch.positions[k]];
+        }
+    }
+
+    if (m == MEAN) {
+        double scale_factor = (selector.get_duration_secs() > time_stride ) ? (time_stride / selector.get_duration_secs()) : (1.0 / (a + b));
+        for (auto& value : values) {
+            value *= scale_factor;
+        }
+    }
+
+    try
+    {
+        UnitsHelper::convert_values(native_units, values.data(), selector.get_output_units(), values.data(), values.size());
+    }
+    catch (const std::runtime_error& e)
+    {
+        #ifndef UDUNITS_QUIET
+        std::cerr<<"WARN: Unit conversion unsuccessful - Returning unconverted value! (\""<<e.what()<<"\")"<<std::endl;
+        #endif
+    }
+}
+
 // private:
 
 const netCDF::NcVar& NetCDFPerFeatureDataProvider::get_ncvar(const std::string& name){
@@ -452,6 +511,24 @@ const netCDF::NcVar& NetCDFPerFeatureDataProvider::get_ncvar(const std::string&
     throw std::runtime_error("Got request for variable " + name + " but it was not found in the cache. This should not happen." + SOURCE_LOC);
 }
 
+std::shared_ptr<std::vector<double>> NetCDFPerFeatureDataProvider::get_cache_slice(const netCDF::NcVar& ncvar, size_t cache_t_idx){
+    std::string key = ncvar.getName() + "|" + std::to_string(cache_t_idx);
+    if(value_cache.contains(key)){
+        return value_cache.get(key).get();
+    }
+
+    ngen::trace::scoped_event read_event("forcing", "netcdf_cache_miss", cache_t_idx);
+    auto cached = std::make_shared<std::vector<double>>(cache_slice_c_size * cache_slice_t_size);
+    std::vector<std::size_t> start, count;
+    start.push_back(0); // only always 0 when cache_slice_c_size = numids!
+    start.push_back(cache_t_idx * cache_slice_t_size);
+    count.push_back(cache_slice_c_size);
+    count.push_back(cache_slice_t_size); // Must be 1 for now!...probably...
+    ncvar.getVar(start,count,&(*cached)[0]);
+    value_cache.insert(key, cached);
+    return cached;
+}
+
 const std::string& NetCDFPerFeatureDataProvider::get_ncvar_units(const std::string& name){
     auto cache_hit = units_cache.find(name);
     if(cache_hit != units_cache.end()){
@@ -0,0 +1,61 @@
+#include "ZonalWeights.hpp"
+
+#include "grid_coverage.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace data_access {
+
+void ZonalWeights::apply(boost::span<const double> grid, boost::span<double> means) const
+{
+    for (std::size_t zone = 0; zone < zones(); zone++) {
+        double total = 0;
+        double weight = 0;
+        for (std::size_t i = offsets_[zone]; i < offsets_[zone + 1]; i++) {
+            const double value = grid[cells_[i]];
+            if (!std::isnan(value)) {
+                total  += weights_[i] * value;
+                weight += weights_[i];
+            }
+        }
+        means[zone] = weight > 0 ? total / weight : std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+ZonalWeights compute_zonal_weights(const GridSpecification& grid, const std::vector<geojson::multipolygon_t>& zones)
+{
+    if (grid.rows * grid.columns > std::numeric_limits<ZonalWeights::cell_index>::max()) {
+        throw std::invalid_argument(
+            "Grid of " + std::to_string(grid.rows) + " by " + std::to_string(grid.columns) + " cells is too large to weight"
+        );
+    }
+
+    // Coverage is found in the plane of the grid, whatever coordinate system the zones are given in
+    ngen::grid_coverage coverage{{
+        /*xmin=*/grid.extent.xmin(),
+        /*ymin=*/grid.extent.ymin(),
+        /*dx=*/(grid.extent.xmax() - grid.extent.xmin()) / static_cast<double>(grid.columns),
+        /*dy=*/(grid.extent.ymax() - grid.extent.ymin()) / static_cast<double>(grid.rows),
+        /*columns=*/grid.columns,
+        /*rows=*/grid.rows
+    }};
+
+    ZonalWeights weights;
+    std::vector<ngen::cell_coverage> covered;
+    for (const auto& zone : zones) {
+        weights.add_zone();
+
+        coverage.add_multipolygon(zone);
+        coverage.compute(covered);
+        for (const auto& cell : covered) {
+            weights.add_cell(static_cast<ZonalWeights::cell_index>(cell.column + cell.row * grid.columns), cell.fraction);
+        }
+    }
+
+    return weights;
+}
+
+} // namespace data_access
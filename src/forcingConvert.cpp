@@ -0,0 +1,129 @@
+#include <NGenConfig.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CsvForcingConverter.hpp"
+
+namespace {
+
+struct options
+{
+    data_access::CsvForcingConversion conversion;
+    std::string csv_directory;
+    std::string output_path;
+};
+
+void usage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options] <csv_directory> <output_path>" << std::endl
+              << std::endl
+              << "Converts a directory of per-feature CSV forcing files into a single NetCDF file for the" << std::endl
+              << "NetCDF per-feature forcing provider. Every file must have the same columns and times." << std::endl
+              << std::endl
+              << "Options:" << std::endl
+              << "  -j <threads>     Number of threads parsing CSV files (default: hardware concurrency)" << std::endl
+              << "  -p <pattern>     Regular expression matching forcing file names, with {{id}} in place of" << std::endl
+              << "                   the feature id (default: {{id}}(_.*)?\\.csv)" << std::endl
+              << "  -c <catchments>  Number of catchments per chunk of each variable (default: as many as" << std::endl
+              << "                   are converted at once)" << std::endl
+              << "  -z <level>       Compress variables with shuffle and deflate at level 1 to 9 (default: off)" << std::endl
+              << "  -d               Store values as double rather than float" << std::endl;
+}
+
+std::size_t parse_count(const std::string& option, const char* value)
+{
+    char* end = nullptr;
+    const long count = std::strtol(value, &end, 10);
+    if (end == value || *end != '\0' || count < 0) {
+        throw std::runtime_error("Option " + option + " requires a non-negative number, not '" + value + "'");
+    }
+    return static_cast<std::size_t>(count);
+}
+
+/**
+ * Parse the command line, or return false if usage should be shown instead
+ */
+bool parse_options(int argc, char* argv[], options& opts)
+{
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool takes_value = arg == "-j" || arg == "-p" || arg == "-c" || arg == "-z";
+        if (takes_value && i + 1 >= argc) {
+            throw std::runtime_error("Option " + arg + " requires a value");
+        }
+
+        if (arg == "-h" || arg == "--help") {
+            return false;
+        }
+        else if (arg == "-j") {
+            opts.conversion.threads = std::max<std::size_t>(1, parse_count(arg, argv[++i]));
+        }
+        else if (arg == "-p") {
+            opts.conversion.pattern = argv[++i];
+        }
+        else if (arg == "-c") {
+            opts.conversion.chunk_catchments = parse_count(arg, argv[++i]);
+        }
+        else if (arg == "-z") {
+            opts.conversion.deflate_level = static_cast<int>(std::min<std::size_t>(9, parse_count(arg, argv[++i])));
+        }
+        else if (arg == "-d") {
+            opts.conversion.double_precision = true;
+        }
+        else if (arg.size() > 1 && arg[0] == '-') {
+            throw std::runtime_error("Unknown option " + arg);
+        }
+        else {
+            positional.push_back(arg);
+        }
+    }
+
+    if (positional.size() != 2) {
+        return false;
+    }
+
+    opts.csv_directory = positional[0];
+    opts.output_path   = positional[1];
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    options opts;
+
+    try {
+        if (!parse_options(argc, argv, opts)) {
+            usage(argv[0]);
+            return argc == 1 ? 0 : -1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    try {
+        const auto time_start = std::chrono::steady_clock::now();
+
+        const auto summary = data_access::convert_csv_forcing(opts.csv_directory, opts.output_path, opts.conversion, std::cout);
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - time_start;
+        std::cout << "Converted " << summary.catchments << " forcing files with " << summary.variables << " variables and "
+                  << summary.steps << " time steps into " << opts.output_path << " in " << elapsed.count() << " seconds" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -254,6 +254,25 @@ void FeatureCollection::update_ids(const std::string& alt_id ) {
     }
 }
 
+void FeatureCollection::store_properties_in_columns(std::shared_ptr<PropertyTable> table) {
+    if (table == nullptr) {
+        table = std::make_shared<PropertyTable>();
+    }
+
+    for (auto& feature : features) {
+        if (feature->get_property_table() == nullptr) {
+            feature->move_properties_to(table);
+        }
+    }
+
+    table->shrink_to_fit();
+    property_table = std::move(table);
+}
+
+const PropertyTable* FeatureCollection::get_property_table() const {
+    return property_table.get();
+}
+
 void FeatureCollection::add_feature_id(const std::string& id, Feature feature) {
     if (id != "") {
         feature_by_id.emplace(id, std::move(feature));
@@ -0,0 +1,648 @@
+#include "FeatureStreamReader.hpp"
+#include "FeatureBuilder.hpp"
+
+#include <cstdlib>
+#include <unordered_set>
+
+#include <boost/property_tree/json_parser/error.hpp>
+
+using namespace geojson;
+
+namespace {
+
+/**
+ * A minimal pull parser over a character stream.
+ *
+ * Values are consumed as they are read, so callers decide per value whether
+ * to interpret it, collect it into a (small) property tree, or skip it.
+ * Collected property trees follow the same conventions as
+ * boost::property_tree::json_parser, so they can be handed to the existing
+ * JSONProperty constructors unchanged.
+ */
+class json_stream
+{
+  public:
+    explicit json_stream(std::istream& input)
+      : buffer_(input.rdbuf())
+    {}
+
+    void skip_ws()
+    {
+        int c = peek();
+        while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            get();
+            c = peek();
+        }
+    }
+
+    //! Consume @p c (after any whitespace) if it is the next character
+    bool consume(char c)
+    {
+        skip_ws();
+        if (peek() == c) {
+            get();
+            return true;
+        }
+
+        return false;
+    }
+
+    void expect(char c)
+    {
+        if (!consume(c)) {
+            fail(std::string("expected '") + c + "'");
+        }
+    }
+
+    //! Check (after any whitespace) whether @p c is the next character, without consuming it
+    bool next_is(char c)
+    {
+        skip_ws();
+        return peek() == c;
+    }
+
+    //! Call @p on_member with the key of each member of an object, positioned at its value
+    template<typename F>
+    void for_each_member(F&& on_member)
+    {
+        expect('{');
+        if (consume('}')) {
+            return;
+        }
+
+        do {
+            skip_ws();
+            if (peek() != '"') {
+                fail("expected object key");
+            }
+            const std::string key = read_string();
+            expect(':');
+            on_member(key);
+        } while (consume(','));
+
+        expect('}');
+    }
+
+    //! Call @p on_element for each element of an array, positioned at the element
+    template<typename F>
+    void for_each_element(F&& on_element)
+    {
+        expect('[');
+        if (consume(']')) {
+            return;
+        }
+
+        do {
+            on_element();
+        } while (consume(','));
+
+        expect(']');
+    }
+
+    double read_double()
+    {
+        const std::string token = read_number();
+        return std::strtod(token.c_str(), nullptr);
+    }
+
+    //! Read any value into @p node, using the conventions of boost::property_tree::json_parser
+    void read_value(boost::property_tree::ptree& node)
+    {
+        skip_ws();
+        switch (peek()) {
+            case '{':
+                for_each_member([&](const std::string& key) {
+                    boost::property_tree::ptree child;
+                    read_value(child);
+                    node.push_back({key, std::move(child)});
+                });
+                break;
+            case '[':
+                for_each_element([&]() {
+                    boost::property_tree::ptree child;
+                    read_value(child);
+                    node.push_back({"", std::move(child)});
+                });
+                break;
+            case '"':
+                node.data() = read_string();
+                break;
+            case 't':
+                read_literal("true");
+                node.data() = "true";
+                break;
+            case 'f':
+                read_literal("false");
+                node.data() = "false";
+                break;
+            case 'n':
+                read_literal("null");
+                node.data() = "null";
+                break;
+            default:
+                node.data() = read_number();
+        }
+    }
+
+    //! Consume a value of any type without keeping it
+    void skip_value()
+    {
+        skip_ws();
+        switch (peek()) {
+            case '{':
+                for_each_member([&](const std::string&) { skip_value(); });
+                break;
+            case '[':
+                for_each_element([&]() { skip_value(); });
+                break;
+            case '"':
+                read_string(nullptr);
+                break;
+            case 't':
+                read_literal("true");
+                break;
+            case 'f':
+                read_literal("false");
+                break;
+            case 'n':
+                read_literal("null");
+                break;
+            default:
+                read_number();
+        }
+    }
+
+    //! Check that nothing but whitespace follows the document
+    void finish()
+    {
+        skip_ws();
+        if (peek() != std::char_traits<char>::eof()) {
+            fail("garbage after data");
+        }
+    }
+
+    [[noreturn]] void fail(const std::string& message) const
+    {
+        throw boost::property_tree::json_parser::json_parser_error(message, "", line_);
+    }
+
+  private:
+    int peek()
+    {
+        return buffer_->sgetc();
+    }
+
+    int get()
+    {
+        const int c = buffer_->sbumpc();
+        if (c == '\n') {
+            line_++;
+        }
+        return c;
+    }
+
+    std::string read_string()
+    {
+        std::string value;
+        read_string(&value);
+        return value;
+    }
+
+    //! Read a string value, appending it to @p value unless it is null
+    void read_string(std::string* value)
+    {
+        if (get() != '"') {
+            fail("expected string");
+        }
+
+        while (true) {
+            const int c = get();
+            if (c == '"') {
+                return;
+            }
+
+            if (c == std::char_traits<char>::eof() || (c >= 0 && c < 0x20)) {
+                fail("invalid code sequence");
+            }
+
+            if (c != '\\') {
+                if (value != nullptr) {
+                    value->push_back(static_cast<char>(c));
+                }
+                continue;
+            }
+
+            const int escaped = get();
+            char decoded;
+            switch (escaped) {
+                case '"':  decoded = '"';  break;
+                case '\\': decoded = '\\'; break;
+                case '/':  decoded = '/';  break;
+                case 'b':  decoded = '\b'; break;
+                case 'f':  decoded = '\f'; break;
+                case 'n':  decoded = '\n'; break;
+                case 'r':  decoded = '\r'; break;
+                case 't':  decoded = '\t'; break;
+                case 'u': {
+                    unsigned long codepoint = read_hex4();
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                        // High surrogate; the low half must follow as another escape
+                        if (get() != '\\' || get() != 'u') {
+                            fail("expected codepoint reference after high surrogate");
+                        }
+                        const unsigned long low = read_hex4();
+                        if (low < 0xDC00 || low > 0xDFFF) {
+                            fail("expected low surrogate after high surrogate");
+                        }
+                        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+
+                    if (value != nullptr) {
+                        append_utf8(*value, codepoint);
+                    }
+                    continue;
+                }
+                default:
+                    fail("invalid escape sequence");
+            }
+
+            if (value != nullptr) {
+                value->push_back(decoded);
+            }
+        }
+    }
+
+    unsigned long read_hex4()
+    {
+        unsigned long codepoint = 0;
+        for (int i = 0; i < 4; i++) {
+            const int c = get();
+            codepoint <<= 4;
+            if (c >= '0' && c <= '9') {
+                codepoint += c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                codepoint += c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                codepoint += c - 'A' + 10;
+            } else {
+                fail("invalid codepoint reference");
+            }
+        }
+        return codepoint;
+    }
+
+    static void append_utf8(std::string& value, unsigned long codepoint)
+    {
+        if (codepoint < 0x80) {
+            value.push_back(static_cast<char>(codepoint));
+        } else if (codepoint < 0x800) {
+            value.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+            value.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        } else if (codepoint < 0x10000) {
+            value.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+            value.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            value.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        } else {
+            value.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+            value.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+            value.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+            value.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+        }
+    }
+
+    void read_literal(const char* literal)
+    {
+        for (const char* c = literal; *c != '\0'; c++) {
+            if (get() != *c) {
+                fail(std::string("expected '") + literal + "'");
+            }
+        }
+    }
+
+    //! Read the raw text of a number, checking that it is a well-formed JSON number
+    std::string read_number()
+    {
+        skip_ws();
+        std::string token;
+        int c = peek();
+        while ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            token.push_back(static_cast<char>(get()));
+            c = peek();
+        }
+
+        if (token.empty()) {
+            fail("expected value");
+        }
+
+        char* end = nullptr;
+        std::strtod(token.c_str(), &end);
+        if (end != token.c_str() + token.size() || token[0] == '+' || token[0] == '.') {
+            fail("invalid number");
+        }
+
+        return token;
+    }
+
+    std::streambuf* buffer_;
+    unsigned long   line_ = 1;
+};
+
+/**
+ * The positions of a GeoJSON "coordinates" member, flattened.
+ *
+ * Every position is reduced to its first two values. The nesting of the
+ * arrays around the positions is kept as the offsets (into points) at which
+ * each array ends, grouped by how far above the positions it is nested;
+ * e.g. for a Polygon, ends[1] holds the end of each ring.
+ */
+struct coordinate_tree
+{
+    std::vector<coordinate_t>             points;
+    std::vector<std::vector<std::size_t>> ends;
+
+    const std::vector<std::size_t>& ends_at(std::size_t level) const
+    {
+        static const std::vector<std::size_t> none;
+        return level < ends.size() ? ends[level] : none;
+    }
+};
+
+/**
+ * Read a (possibly nested) coordinate array into @p tree
+ *
+ * @return How many levels of arrays lie above the positions (0 for a single position)
+ */
+std::size_t read_coordinates(json_stream& stream, coordinate_tree& tree)
+{
+    stream.expect('[');
+
+    if (stream.next_is('[') || stream.next_is(']')) {
+        // An array of arrays; an empty array is treated as one holding no positions
+        std::size_t level = 1;
+        if (!stream.consume(']')) {
+            do {
+                level = std::max(level, read_coordinates(stream, tree) + 1);
+            } while (stream.consume(','));
+            stream.expect(']');
+        }
+
+        if (tree.ends.size() <= level) {
+            tree.ends.resize(level + 1);
+        }
+        tree.ends[level].push_back(tree.points.size());
+        return level;
+    }
+
+    double position[2] = {0.0, 0.0};
+    std::size_t size = 0;
+    do {
+        const double value = stream.read_double();
+        if (size < 2) {
+            position[size] = value;
+        }
+        size++;
+    } while (stream.consume(','));
+    stream.expect(']');
+
+    if (size < 2) {
+        stream.fail("a position must have at least two values");
+    }
+
+    tree.points.emplace_back(position[0], position[1]);
+    return 0;
+}
+
+//! Build a linestring-like geometry from the positions in [begin, end)
+template<typename T>
+T build_points(const coordinate_tree& tree, std::size_t begin, std::size_t end)
+{
+    T points;
+    for (std::size_t i = begin; i < end; i++) {
+        bg::append(points, tree.points[i]);
+    }
+    return points;
+}
+
+/**
+ * Build a geometry of the given type from its coordinates, giving the
+ * same result as the corresponding geojson::build_* function
+ */
+geometry build_geometry(FeatureType type, const coordinate_tree& tree, std::size_t depth)
+{
+    std::size_t expected_depth = 0;
+    switch (type) {
+        case FeatureType::Point:           expected_depth = 0; break;
+        case FeatureType::LineString:
+        case FeatureType::MultiPoint:      expected_depth = 1; break;
+        case FeatureType::Polygon:
+        case FeatureType::MultiLineString: expected_depth = 2; break;
+        case FeatureType::MultiPolygon:    expected_depth = 3; break;
+        default:
+            throw std::invalid_argument("tree");
+    }
+
+    if (depth != expected_depth && !tree.points.empty()) {
+        throw std::invalid_argument("coordinates");
+    }
+
+    const std::size_t npoints = tree.points.size();
+    switch (type) {
+        case FeatureType::Point:
+            if (npoints != 1) {
+                throw std::invalid_argument("coordinates");
+            }
+            return tree.points[0];
+        case FeatureType::LineString:
+            return build_points<linestring_t>(tree, 0, npoints);
+        case FeatureType::MultiPoint:
+            return build_points<multipoint_t>(tree, 0, npoints);
+        case FeatureType::Polygon: {
+            polygon_t polygon;
+            std::size_t begin = 0;
+            for (const std::size_t end : tree.ends_at(1)) {
+                if (begin == 0) {
+                    polygon.outer() = build_points<polygon_t::ring_type>(tree, begin, end);
+                } else {
+                    polygon.inners().push_back(build_points<polygon_t::ring_type>(tree, begin, end));
+                }
+                begin = end;
+            }
+            return polygon;
+        }
+        case FeatureType::MultiLineString: {
+            multilinestring_t lines;
+            std::size_t begin = 0;
+            for (const std::size_t end : tree.ends_at(1)) {
+                lines.push_back(build_points<linestring_t>(tree, begin, end));
+                begin = end;
+            }
+            return lines;
+        }
+        default: {
+            // As in build_multipolygon, each ring becomes the outer ring of its own polygon
+            multipolygon_t polygons;
+            std::size_t begin = 0;
+            for (const std::size_t end : tree.ends_at(1)) {
+                polygon_t polygon;
+                polygon.outer() = build_points<polygon_t::ring_type>(tree, begin, end);
+                polygons.push_back(std::move(polygon));
+                begin = end;
+            }
+            return polygons;
+        }
+    }
+}
+
+/**
+ * Read a GeoJSON geometry object into @p object
+ *
+ * @return The type of the geometry, or FeatureType::None if it was null
+ */
+FeatureType read_geometry(json_stream& stream, geometry& object)
+{
+    if (stream.next_is('n')) {
+        stream.skip_value();
+        return FeatureType::None;
+    }
+
+    std::string type_name;
+    coordinate_tree coordinates;
+    std::size_t depth = 0;
+
+    stream.for_each_member([&](const std::string& key) {
+        if (key == "type") {
+            boost::property_tree::ptree node;
+            stream.read_value(node);
+            type_name = std::move(node.data());
+        }
+        else if (key == "coordinates") {
+            depth = read_coordinates(stream, coordinates);
+        }
+        else {
+            stream.skip_value();
+        }
+    });
+
+    const FeatureType type = feature_type(type_name);
+    object = build_geometry(type, coordinates, depth);
+    return type;
+}
+
+}
+
+std::shared_ptr<FeatureCollection> geojson::read_stream(
+    std::istream& input,
+    const std::vector<std::string>& ids,
+    bool with_geometry
+)
+{
+    const std::unordered_set<std::string> selected(ids.begin(), ids.end());
+    auto is_selected = [&selected](const std::string& id) {
+        return selected.empty() || selected.count(id) > 0;
+    };
+
+    json_stream stream{input};
+    std::vector<double> bbox_values;
+    std::vector<Feature> features;
+
+    // Properties are moved into columns as each feature is built, so the per-feature maps never accumulate
+    auto properties_table = std::make_shared<PropertyTable>();
+
+    stream.for_each_member([&](const std::string& collection_key) {
+        if (collection_key == "bbox") {
+            stream.for_each_element([&]() { bbox_values.push_back(stream.read_double()); });
+        }
+        else if (collection_key == "features") {
+            stream.for_each_element([&]() {
+                geometry geometry_object;
+                std::vector<geometry> geometry_collection;
+                FeatureType type = FeatureType::None;
+                std::string id = "";
+                std::vector<double> bounding_box;
+                PropertyMap properties;
+                PropertyMap foreign_members;
+                bool skipped = false;
+
+                stream.for_each_member([&](const std::string& key) {
+                    if (skipped || (!with_geometry && (key == "geometry" || key == "geometries"))) {
+                        stream.skip_value();
+                    }
+                    else if (key == "geometry") {
+                        type = read_geometry(stream, geometry_object);
+                    }
+                    else if (key == "geometries") {
+                        type = FeatureType::GeometryCollection;
+                        stream.for_each_element([&]() {
+                            geometry_collection.emplace_back();
+                            read_geometry(stream, geometry_collection.back());
+                        });
+                    }
+                    else if (key == "id") {
+                        boost::property_tree::ptree node;
+                        stream.read_value(node);
+                        id = std::move(node.data());
+
+                        // Once a feature is known not to be selected, the rest of it is never materialized
+                        skipped = !id.empty() && !is_selected(id);
+                    }
+                    else if (key == "bbox" && !stream.next_is('n')) {
+                        stream.for_each_element([&]() { bounding_box.push_back(stream.read_double()); });
+                    }
+                    else if (key == "properties" && !stream.next_is('n')) {
+                        stream.for_each_member([&](const std::string& property_key) {
+                            boost::property_tree::ptree node;
+                            stream.read_value(node);
+                            properties.emplace(property_key, JSONProperty(property_key, node));
+                        });
+                    }
+                    else if (key == "bbox" || key == "properties") {
+                        stream.skip_value();
+                    }
+                    else {
+                        boost::property_tree::ptree node;
+                        stream.read_value(node);
+                        foreign_members.emplace(key, JSONProperty(key, node));
+                    }
+                });
+
+                if (skipped) {
+                    return;
+                }
+
+                // As in build_collection, features without an id member are identified by their "id" property
+                if (id.empty()) {
+                    const auto property = properties.find("id");
+                    if (property != properties.end()) {
+                        id = property->second.as_string();
+                    }
+                }
+
+                if (!is_selected(id)) {
+                    return;
+                }
+
+                features.push_back(build_feature(
+                    type,
+                    std::move(geometry_object),
+                    std::move(geometry_collection),
+                    std::move(id),
+                    std::move(properties),
+                    std::move(bounding_box),
+                    std::move(foreign_members)
+                ));
+                features.back()->move_properties_to(properties_table);
+            });
+        }
+        else {
+            stream.skip_value();
+        }
+    });
+
+    stream.finish();
+
+    auto collection = std::make_shared<FeatureCollection>(std::move(features), std::move(bbox_values));
+    collection->store_properties_in_columns(std::move(properties_table));
+    collection->update_ids();
+
+    return collection;
+}
@@ -0,0 +1,161 @@
+#include "PropertyTable.hpp"
+
+#include <stdexcept>
+
+using namespace geojson;
+
+constexpr std::uint8_t PropertyColumn::missing;
+constexpr std::uint8_t PropertyColumn::typed;
+constexpr std::uint8_t PropertyColumn::overflow;
+
+JSONProperty PropertyColumn::get(const std::string& key, std::size_t row) const {
+    if (not has(row)) {
+        throw std::invalid_argument("JSON Property '" + key + "' not found.");
+    }
+
+    if (state[row] == overflow) {
+        return JSONProperty(key, overflow_values.at(row));
+    }
+
+    switch (column_type) {
+        case PropertyType::Natural:
+            return JSONProperty(key, naturals[row]);
+        case PropertyType::Real:
+            return JSONProperty(key, reals[row]);
+        case PropertyType::Boolean:
+            return JSONProperty(key, booleans[row] != 0);
+        default:
+            // Use the const char* constructor; the std::string one re-infers the type
+            return JSONProperty(key, strings[row].c_str());
+    }
+}
+
+void PropertyColumn::set(std::size_t row, const JSONProperty& value) {
+    if (row >= state.size()) {
+        resize(row + 1);
+    }
+
+    if (state[row] == overflow) {
+        overflow_values.erase(row);
+    }
+
+    if (value.get_type() != column_type) {
+        overflow_values.emplace(row, value);
+        state[row] = overflow;
+        return;
+    }
+
+    switch (column_type) {
+        case PropertyType::Natural:
+            naturals[row] = value.as_natural_number();
+            break;
+        case PropertyType::Real:
+            reals[row] = value.as_real_number();
+            break;
+        case PropertyType::Boolean:
+            booleans[row] = value.as_boolean() ? 1 : 0;
+            break;
+        case PropertyType::String:
+            strings[row] = value.as_string();
+            break;
+        default:
+            // Lists and objects have no typed array
+            overflow_values.emplace(row, value);
+            state[row] = overflow;
+            return;
+    }
+
+    state[row] = typed;
+}
+
+void PropertyColumn::resize(std::size_t rows) {
+    state.resize(rows, missing);
+
+    switch (column_type) {
+        case PropertyType::Natural:
+            naturals.resize(rows);
+            break;
+        case PropertyType::Real:
+            reals.resize(rows);
+            break;
+        case PropertyType::Boolean:
+            booleans.resize(rows);
+            break;
+        case PropertyType::String:
+            strings.resize(rows);
+            break;
+        default:
+            break;
+    }
+}
+
+void PropertyColumn::shrink_to_fit() {
+    state.shrink_to_fit();
+    naturals.shrink_to_fit();
+    reals.shrink_to_fit();
+    booleans.shrink_to_fit();
+    strings.shrink_to_fit();
+}
+
+std::size_t PropertyTable::add_row(const PropertyMap& properties) {
+    const std::size_t row = rows++;
+
+    for (const auto& property : properties) {
+        auto column = columns.find(property.first);
+        if (column == columns.end()) {
+            column = columns.emplace(property.first, PropertyColumn(property.second.get_type())).first;
+        }
+        column->second.set(row, property.second);
+    }
+
+    return row;
+}
+
+bool PropertyTable::has(std::size_t row, const std::string& key) const {
+    const auto column = columns.find(key);
+    return column != columns.end() && column->second.has(row);
+}
+
+JSONProperty PropertyTable::get(std::size_t row, const std::string& key) const {
+    const auto column = columns.find(key);
+    if (column == columns.end()) {
+        throw std::invalid_argument("JSON Property '" + key + "' not found.");
+    }
+
+    return column->second.get(key, row);
+}
+
+std::vector<std::string> PropertyTable::keys(std::size_t row) const {
+    std::vector<std::string> row_keys;
+
+    for (const auto& column : columns) {
+        if (column.second.has(row)) {
+            row_keys.push_back(column.first);
+        }
+    }
+
+    return row_keys;
+}
+
+PropertyMap PropertyTable::properties(std::size_t row) const {
+    PropertyMap values;
+
+    for (const auto& column : columns) {
+        if (column.second.has(row)) {
+            values.emplace(column.first, column.second.get(column.first, row));
+        }
+    }
+
+    return values;
+}
+
+const PropertyColumn* PropertyTable::column(const std::string& key) const {
+    const auto found = columns.find(key);
+    return found == columns.end() ? nullptr : &found->second;
+}
+
+void PropertyTable::shrink_to_fit() {
+    for (auto& column : columns) {
+        column.second.shrink_to_fit();
+    }
+}
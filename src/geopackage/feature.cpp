@@ -15,11 +15,22 @@ geojson::Feature ngen::geopackage::build_feature(
   const std::string& id_col,
   const std::string& geom_col
 )
+{
+    return build_feature(
+        row.get<std::string>(id_col),
+        build_properties(row, geom_col),
+        row.get<std::vector<uint8_t>>(geom_col)
+    );
+}
+
+geojson::Feature ngen::geopackage::build_feature(
+  std::string id,
+  geojson::PropertyMap properties,
+  const boost::span<const uint8_t> geometry_blob
+)
 {
     std::vector<double> bounding_box(4);
-    std::string id                   = row.get<std::string>(id_col);
-    geojson::PropertyMap properties  = build_properties(row, geom_col);
-    geojson::geometry geometry       = build_geometry(row, geom_col, bounding_box);
+    geojson::geometry geometry = build_geometry(geometry_blob, bounding_box);
 
     // Convert variant type (0-based) to FeatureType
     const auto wkb_type = static_cast<geojson::FeatureType>(geometry.which() + 1);
@@ -29,53 +40,65 @@ geojson::Feature ngen::geopackage::build_feature(
             build_point_bbox(geometry, bounding_box);
             return std::make_shared<geojson::PointFeature>(
                 boost::get<geojson::coordinate_t>(geometry),
-                id,
-                properties,
-                bounding_box
+                std::move(id),
+                std::move(properties),
+                std::move(bounding_box)
             );
         case geojson::FeatureType::LineString:
             return std::make_shared<geojson::LineStringFeature>(
-                boost::get<geojson::linestring_t>(geometry),
-                id,
-                properties,
-                bounding_box
+                std::move(boost::get<geojson::linestring_t>(geometry)),
+                std::move(id),
+                std::move(properties),
+                std::move(bounding_box)
             );
         case geojson::FeatureType::Polygon:
             return std::make_shared<geojson::PolygonFeature>(
-                boost::get<geojson::polygon_t>(geometry),
-                id,
-                properties,
-                bounding_box
+                std::move(boost::get<geojson::polygon_t>(geometry)),
+                std::move(id),
+                std::move(properties),
+                std::move(bounding_box)
             );
         case geojson::FeatureType::MultiPoint:
             return std::make_shared<geojson::MultiPointFeature>(
-                boost::get<geojson::multipoint_t>(geometry),
-                id,
-                properties,
-                bounding_box
+                std::move(boost::get<geojson::multipoint_t>(geometry)),
+                std::move(id),
+                std::move(properties),
+                std::move(bounding_box)
             );
         case geojson::FeatureType::MultiLineString:
             return std::make_shared<geojson::MultiLineStringFeature>(
-                boost::get<geojson::multilinestring_t>(geometry),
-                id,
-                properties,
-                bounding_box
+                std::move(boost::get<geojson::multilinestring_t>(geometry)),
+                std::move(id),
+                std::move(properties),
+                std::move(bounding_box)
             );
         case geojson::FeatureType::MultiPolygon:
             return std::make_shared<geojson::MultiPolygonFeature>(
-                boost::get<geojson::multipolygon_t>(geometry),
-                id,
-                properties,
-                bounding_box
+                std::move(boost::get<geojson::multipolygon_t>(geometry)),
+                std::move(id),
+                std::move(properties),
+                std::move(bounding_box)
             );
         case geojson::FeatureType::GeometryCollection:
             return std::make_shared<geojson::CollectionFeature>(
                 std::vector<geojson::geometry>{geometry},
-                id,
-                properties,
-                bounding_box
+                std::move(id),
+                std::move(properties),
+                std::move(bounding_box)
             );
         default:
             throw std::runtime_error("invalid WKB feature type. Received: " + std::to_string(geometry.which() + 1));
     }
 }
+
+geojson::Feature ngen::geopackage::build_attribute_feature(
+  const ngen::sqlite::database::iterator& row,
+  const std::string& id_col
+)
+{
+    return std::make_shared<geojson::CollectionFeature>(
+        std::vector<geojson::geometry>{},
+        row.get<std::string>(id_col),
+        build_properties(row, "")
+    );
+}
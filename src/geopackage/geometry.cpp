@@ -10,6 +10,14 @@ geojson::geometry ngen::geopackage::build_geometry(
 )
 {
     const std::vector<uint8_t> geometry_blob = row.get<std::vector<uint8_t>>(geom_col);
+    return build_geometry(geometry_blob, bounding_box);
+}
+
+geojson::geometry ngen::geopackage::build_geometry(
+    const boost::span<const uint8_t> geometry_blob,
+    std::vector<double>& bounding_box
+)
+{
     if (geometry_blob[0] != 'G' || geometry_blob[1] != 'P') {
         throw std::runtime_error("expected geopackage WKB, but found invalid format instead");
     }
@@ -27,8 +35,7 @@ geojson::geometry ngen::geopackage::build_geometry(
     uint32_t srs_id = 0;
     utils::copy_from(geometry_blob, index, srs_id, endian);
     
-    const auto epsg = ngen::srs::epsg::get(srs_id);
-    const bg::srs::transformation<> prj{epsg, ngen::srs::epsg::get(ngen::srs::epsg::wgs84)};
+    const bg::srs::transformation<>& prj = ngen::srs::epsg::to_wgs84(srs_id);
     wkb::wgs84 pvisitor{srs_id, prj};
     
     if (indicator > 0 && indicator < 5) {
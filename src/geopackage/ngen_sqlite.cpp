@@ -232,5 +232,59 @@ auto database::query(
     return iterator{stmt_t{stmt}};
 }
 
+void database::execute(const std::string& statement)
+{
+    char* errmsg = nullptr;
+    const int code = sqlite3_exec(connection(), statement.c_str(), nullptr, nullptr, &errmsg);
+
+    if (code != SQLITE_OK) {
+        const std::string extra = errmsg == nullptr ? "" : errmsg;
+        sqlite3_free(errmsg);
+        throw sqlite_error{"sqlite3_exec", code, extra};
+    }
+}
+
+void database::execute_many(
+    const std::string& statement,
+    const boost::span<const std::string> values
+)
+{
+    sqlite3_stmt* raw = nullptr;
+    const int code = sqlite3_prepare_v2(
+        connection(),
+        statement.c_str(),
+        statement.length() + 1,
+        &raw,
+        nullptr
+    );
+
+    if (code != SQLITE_OK) {
+        throw sqlite_error{"sqlite3_prepare_v2", code};
+    }
+
+    stmt_t stmt{raw};
+
+    execute("BEGIN");
+    try {
+        for (const auto& value : values) {
+            const int bind_code = sqlite3_bind_text(stmt.get(), 1, value.c_str(), value.size(), SQLITE_STATIC);
+            if (bind_code != SQLITE_OK) {
+                throw sqlite_error{"sqlite3_bind_text", bind_code};
+            }
+
+            const int step_code = sqlite3_step(stmt.get());
+            if (step_code != SQLITE_DONE) {
+                throw sqlite_error{"sqlite3_step", step_code};
+            }
+
+            sqlite3_reset(stmt.get());
+        }
+    } catch (...) {
+        sqlite3_exec(connection(), "ROLLBACK", nullptr, nullptr, nullptr);
+        throw;
+    }
+    execute("COMMIT");
+}
+
 } // namespace sqlite
 } // namespace ngen
@@ -1,5 +1,8 @@
 #include "proj.hpp"
 
+#include <memory>
+#include <mutex>
+
 namespace ngen {
 namespace srs {
 
@@ -19,5 +22,22 @@ auto epsg::get(uint32_t srid) -> srs_type
     return defs_.at(srid);
 }
 
+auto epsg::to_wgs84(uint32_t srid) -> const bg::srs::transformation<>&
+{
+    using transformation_type = bg::srs::transformation<>;
+
+    static std::mutex mutex;
+    static std::unordered_map<uint32_t, std::unique_ptr<const transformation_type>> cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& entry = cache[srid];
+    if (entry == nullptr) {
+        entry.reset(new transformation_type{get(srid), get(wgs84)});
+    }
+
+    return *entry;
+}
+
 } // namespace srs
 } // namespace ngen
@@ -3,6 +3,10 @@
 #include <numeric>
 #include <regex>
 
+#include <boost/algorithm/string/replace.hpp>
+
+#include "thread_pool.hpp"
+
 void check_table_name(const std::string& table)
 {
     if (boost::algorithm::starts_with(table, "sqlite_")) {
@@ -15,10 +19,125 @@ void check_table_name(const std::string& table)
     }
 }
 
+/**
+ * Get a comma-separated, quoted list of all columns in a table
+ * except for its geometry column.
+ */
+std::string attribute_columns(
+    ngen::sqlite::database& db,
+    const std::string& table,
+    const std::string& geom_col
+)
+{
+    std::string columns = "";
+    auto query_get_columns = db.query("SELECT name FROM pragma_table_info(?)", table);
+    query_get_columns.next();
+    while(!query_get_columns.done()) {
+        const std::string name = query_get_columns.get<std::string>(0);
+        query_get_columns.next();
+
+        if (name == geom_col) {
+            continue;
+        }
+
+        if (!columns.empty()) {
+            columns += ", ";
+        }
+
+        // Quote the identifier, escaping any embedded quotes
+        columns += '"' + boost::algorithm::replace_all_copy(name, "\"", "\"\"") + '"';
+    }
+
+    return columns;
+}
+
+//! Number of rows fetched before they are handed off for geometry decoding
+constexpr std::size_t decode_batch_size = 256;
+
+//! A layer row read from SQLite, with its geometry still encoded as GPKG WKB
+struct fetched_row
+{
+    std::string          id;
+    geojson::PropertyMap properties;
+    std::vector<uint8_t> geometry;
+};
+
+/**
+ * Build features from all remaining rows of a layer query.
+ *
+ * Rows are always fetched serially, since the SQLite connection is not
+ * shared across threads. When there is more than one batch of rows, WKB
+ * parsing and reprojection of each batch is done on a thread pool, and
+ * the decoded batches are appended to @p features in row order.
+ */
+void build_features(
+    ngen::sqlite::database::iterator& rows,
+    const std::string& id_col,
+    const std::string& geom_col,
+    std::size_t expected_count,
+    std::vector<geojson::Feature>& features
+)
+{
+    const std::size_t batches  = (expected_count + decode_batch_size - 1) / decode_batch_size;
+    const std::size_t nthreads = std::min(ngen::thread_pool::default_size(), batches);
+
+    if (nthreads <= 1) {
+        while(!rows.done()) {
+            features.push_back(ngen::geopackage::build_feature(rows, id_col, geom_col));
+            rows.next();
+        }
+
+        return;
+    }
+
+    ngen::thread_pool pool{nthreads};
+    std::vector<std::future<std::vector<geojson::Feature>>> decoded;
+    decoded.reserve(batches);
+
+    std::vector<fetched_row> batch;
+    batch.reserve(decode_batch_size);
+    while(!rows.done()) {
+        batch.push_back({
+            rows.get<std::string>(id_col),
+            ngen::geopackage::build_properties(rows, geom_col),
+            rows.get<std::vector<uint8_t>>(geom_col)
+        });
+        rows.next();
+
+        if (batch.size() == decode_batch_size || rows.done()) {
+            decoded.push_back(pool.submit([fetched = std::move(batch)]() mutable {
+                std::vector<geojson::Feature> result;
+                result.reserve(fetched.size());
+                for (auto& row : fetched) {
+                    result.push_back(ngen::geopackage::build_feature(
+                        std::move(row.id),
+                        std::move(row.properties),
+                        row.geometry
+                    ));
+                }
+                return result;
+            }));
+
+            batch = std::vector<fetched_row>{};
+            batch.reserve(decode_batch_size);
+        }
+    }
+
+    for (auto& result : decoded) {
+        auto decoded_features = result.get();
+        features.insert(
+            features.end(),
+            std::make_move_iterator(decoded_features.begin()),
+            std::make_move_iterator(decoded_features.end())
+        );
+    }
+}
+
 std::shared_ptr<geojson::FeatureCollection> ngen::geopackage::read(
     const std::string& gpkg_path,
     const std::string& layer = "",
-    const std::vector<std::string>& ids = {}
+    const std::vector<std::string>& ids = {},
+    bool with_geometry
 )
 {
     // Check for malicious/invalid layer input
@@ -64,28 +183,56 @@ std::shared_ptr<geojson::FeatureCollection> ngen::geopackage::read(
 
     // Layer exists, getting statement for it
     //
-    // this creates a string in the form:
-    //     WHERE id IN (?, ?, ?, ...)
-    // so that it can be bound by SQLite.
-    // This is safer than trying to concatenate
-    // the IDs together.
+    // If a subset of IDs is requested, the IDs are loaded into a
+    // temporary table with a single reused insert statement, and the
+    // layer is filtered against it. This avoids binding an unbounded
+    // number of parameters, and lets SQLite use the temporary table's
+    // index (and an index on the layer's ID column, if one exists).
     std::string joined_ids = "";
+    std::size_t layer_feature_count = ids.size();
     if (!ids.empty()) {
-        joined_ids = " WHERE "+id_column+" IN (?";
-        for (size_t i = 1; i < ids.size(); i++) {
-            joined_ids += ", ?";
-        }
-        joined_ids += ")";
+        db.execute("CREATE TEMP TABLE ngen_subset_ids (id TEXT PRIMARY KEY)");
+        db.execute_many("INSERT OR IGNORE INTO temp.ngen_subset_ids VALUES (?)", ids);
+        joined_ids = " WHERE " + id_column + " IN (SELECT id FROM temp.ngen_subset_ids)";
+    } else {
+        // Get number of features
+        auto query_get_layer_count = db.query("SELECT COUNT(*) FROM " + layer);
+        query_get_layer_count.next();
+        layer_feature_count = query_get_layer_count.get<int>(0);
+    }
+
+    // Get layer feature metadata (geometry column name + type)
+    auto query_get_layer_geom_meta = db.query("SELECT column_name FROM gpkg_geometry_columns WHERE table_name = ?", layer);
+    query_get_layer_geom_meta.next();
+    const std::string layer_geometry_column = query_get_layer_geom_meta.get<std::string>(0);
+
+    // Get layer
+    //
+    // When geometry is not wanted, only the attribute columns are selected,
+    // so SQLite never has to read the (comparatively large) WKB blobs.
+    std::string selected_columns = "*";
+    if (!with_geometry) {
+        selected_columns = attribute_columns(db, layer, layer_geometry_column);
     }
 
-    // Get number of features
-    auto query_get_layer_count = db.query("SELECT COUNT(*) FROM " + layer + joined_ids, ids);
-    query_get_layer_count.next();
-    const int layer_feature_count = query_get_layer_count.get<int>(0);
+    auto query_get_layer = db.query("SELECT " + selected_columns + " FROM " + layer + joined_ids);
+    query_get_layer.next();
+
+    // build features out of layer query
+    std::vector<geojson::Feature> features;
+    features.reserve(layer_feature_count);
+    if (with_geometry) {
+        build_features(query_get_layer, id_column, layer_geometry_column, layer_feature_count, features);
+    } else {
+        while(!query_get_layer.done()) {
+            features.push_back(build_attribute_feature(query_get_layer, id_column));
+            query_get_layer.next();
+        }
+    }
 
     #ifndef NGEN_QUIET
     // output debug info on what is read exactly
-    std::cout << "Reading " << layer_feature_count << " features from layer " << layer << " using ID column `"<< id_column << "`";
+    std::cout << "Read " << features.size() << " features from layer " << layer << " using ID column `"<< id_column << "`";
     if (!ids.empty()) {
         std::cout << " (id subset:";
         for (auto& id : ids) {
@@ -96,27 +243,17 @@ std::shared_ptr<geojson::FeatureCollection> ngen::geopackage::read(
     std::cout << std::endl;
     #endif
 
-    // Get layer feature metadata (geometry column name + type)
-    auto query_get_layer_geom_meta = db.query("SELECT column_name FROM gpkg_geometry_columns WHERE table_name = ?", layer);
-    query_get_layer_geom_meta.next();
-    const std::string layer_geometry_column = query_get_layer_geom_meta.get<std::string>(0);
-
-    // Get layer
-    auto query_get_layer = db.query("SELECT * FROM " + layer + joined_ids, ids);
-    query_get_layer.next();
-
-    // build features out of layer query
-    std::vector<geojson::Feature> features;
-    features.reserve(layer_feature_count);
-    while(!query_get_layer.done()) {
-        geojson::Feature feature = build_feature(
-            query_get_layer,
-            id_column,
-            layer_geometry_column
+    if (!with_geometry) {
+        // Attribute-only features have no bounding box to aggregate
+        auto fc = std::make_shared<geojson::FeatureCollection>(
+            std::move(features),
+            std::vector<double>{}
         );
 
-        features.push_back(feature);
-        query_get_layer.next();
+        fc->store_properties_in_columns();
+        fc->update_ids();
+
+        return fc;
     }
 
     // get layer bounding box from features
@@ -142,6 +279,7 @@ std::shared_ptr<geojson::FeatureCollection> ngen::geopackage::read(
         std::vector<double>({min_x, min_y, max_x, max_y})
     );
 
+    fc->store_properties_in_columns();
     fc->update_ids();
 
     return fc;
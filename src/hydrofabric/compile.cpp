@@ -0,0 +1,267 @@
+#include "hydrofabric.hpp"
+#include "format.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace fmt = ngen::hydrofabric::format;
+
+namespace {
+
+/**
+ * Accumulates the tables of a compiled hydrofabric in memory
+ */
+class compiled_writer
+{
+  public:
+    std::uint32_t intern(const std::string& value)
+    {
+        const auto found = string_index_.find(value);
+        if (found != string_index_.end()) {
+            return found->second;
+        }
+
+        const auto index = checked_index(strings_.size(), "strings");
+        strings_.push_back(value);
+        string_index_.emplace(value, index);
+        return index;
+    }
+
+    /**
+     * Append a contiguous block of property records
+     *
+     * @return fmt::range The location of the block in the property table
+     */
+    fmt::range add_properties(const geojson::PropertyMap& values)
+    {
+        fmt::range block;
+        block.first = checked_index(properties_.size(), "properties");
+        block.count = checked_index(values.size(), "properties");
+
+        // Reserve the whole block first, so nested children land after it
+        properties_.resize(properties_.size() + values.size());
+
+        std::size_t index = block.first;
+        for (const auto& value : values) {
+            fill_property(index++, value.first, value.second);
+        }
+
+        return block;
+    }
+
+    fmt::range add_destinations(const std::vector<std::uint32_t>& destinations)
+    {
+        fmt::range block;
+        block.first = checked_index(links_.size(), "links");
+        block.count = checked_index(destinations.size(), "links");
+        for (const auto destination : destinations) {
+            links_.push_back(destination);
+        }
+        return block;
+    }
+
+    void add_feature(const fmt::feature& record)
+    {
+        features_.push_back(record);
+    }
+
+    void write(const std::string& path, std::uint32_t nexus_count, std::uint32_t catchment_count) const
+    {
+        std::vector<fmt::u64> string_offsets;
+        string_offsets.reserve(strings_.size() + 1);
+        std::uint64_t offset = 0;
+        string_offsets.push_back(offset);
+        for (const auto& value : strings_) {
+            offset += value.size();
+            string_offsets.push_back(offset);
+        }
+
+        fmt::header header;
+        std::memcpy(header.magic, fmt::magic, sizeof(fmt::magic));
+        header.version           = ngen::hydrofabric::compiled_version;
+        header.nexus_count       = nexus_count;
+        header.catchment_count   = catchment_count;
+        header.string_count      = static_cast<std::uint32_t>(strings_.size());
+        header.property_count    = static_cast<std::uint32_t>(properties_.size());
+        header.link_count        = static_cast<std::uint32_t>(links_.size());
+        header.strings_offset    = sizeof(fmt::header);
+        header.features_offset   = header.strings_offset + string_offsets.size() * sizeof(fmt::u64) + offset;
+        header.properties_offset = header.features_offset + features_.size() * sizeof(fmt::feature);
+        header.links_offset      = header.properties_offset + properties_.size() * sizeof(fmt::property);
+        header.file_size         = header.links_offset + links_.size() * sizeof(fmt::u32);
+
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if (!output) {
+            throw std::runtime_error("Unable to open " + path + " for writing");
+        }
+
+        write_block(output, &header, 1);
+        write_block(output, string_offsets.data(), string_offsets.size());
+        for (const auto& value : strings_) {
+            output.write(value.data(), value.size());
+        }
+        write_block(output, features_.data(), features_.size());
+        write_block(output, properties_.data(), properties_.size());
+        write_block(output, links_.data(), links_.size());
+
+        if (!output) {
+            throw std::runtime_error("Failed to write compiled hydrofabric " + path);
+        }
+    }
+
+  private:
+    static std::uint32_t checked_index(std::size_t index, const char* table)
+    {
+        if (index > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error(std::string("Too many ") + table + " for a compiled hydrofabric");
+        }
+        return static_cast<std::uint32_t>(index);
+    }
+
+    template<typename T>
+    static void write_block(std::ofstream& output, const T* records, std::size_t count)
+    {
+        output.write(reinterpret_cast<const char*>(records), count * sizeof(T));
+    }
+
+    void fill_property(std::size_t index, const std::string& key, const geojson::JSONProperty& value)
+    {
+        fmt::property record;
+        record.key            = intern(key);
+        record.value          = 0;
+        record.children.first = 0;
+        record.children.count = 0;
+
+        switch (value.get_type()) {
+            case geojson::PropertyType::Natural: {
+                const std::int64_t natural = value.as_natural_number();
+                record.type  = static_cast<std::uint8_t>(fmt::property_type::natural);
+                record.value = static_cast<std::uint64_t>(natural);
+                break;
+            }
+            case geojson::PropertyType::Real: {
+                const double real = value.as_real_number();
+                std::uint64_t bits;
+                std::memcpy(&bits, &real, sizeof(bits));
+                record.type  = static_cast<std::uint8_t>(fmt::property_type::real);
+                record.value = bits;
+                break;
+            }
+            case geojson::PropertyType::Boolean:
+                record.type  = static_cast<std::uint8_t>(fmt::property_type::boolean);
+                record.value = value.as_boolean() ? 1 : 0;
+                break;
+            case geojson::PropertyType::String:
+                record.type  = static_cast<std::uint8_t>(fmt::property_type::string);
+                record.value = intern(value.as_string());
+                break;
+            case geojson::PropertyType::List: {
+                const auto elements = value.as_list();
+                record.type           = static_cast<std::uint8_t>(fmt::property_type::list);
+                record.children.first = checked_index(properties_.size(), "properties");
+                record.children.count = checked_index(elements.size(), "properties");
+
+                properties_.resize(properties_.size() + elements.size());
+                std::size_t child = record.children.first;
+                for (const auto& element : elements) {
+                    fill_property(child++, key, element);
+                }
+                break;
+            }
+            case geojson::PropertyType::Object:
+                record.type     = static_cast<std::uint8_t>(fmt::property_type::object);
+                record.children = add_properties(value.get_values());
+                break;
+        }
+
+        // Children may have grown the table, so assign by index only at the end
+        properties_[index] = record;
+    }
+
+    std::vector<std::string>                       strings_;
+    std::unordered_map<std::string, std::uint32_t> string_index_;
+    std::vector<fmt::feature>                      features_;
+    std::vector<fmt::property>                     properties_;
+    std::vector<fmt::u32>                          links_;
+};
+
+//! Copy the foreign members of a feature into a PropertyMap
+geojson::PropertyMap foreign_members(const geojson::Feature& feature)
+{
+    geojson::PropertyMap members;
+    for (const auto& key : feature->keys()) {
+        members.emplace(key, feature->get(key));
+    }
+    return members;
+}
+
+//! Copy the properties of a feature into a PropertyMap
+geojson::PropertyMap properties(const geojson::Feature& feature)
+{
+    geojson::PropertyMap values;
+    for (const auto& key : feature->property_keys()) {
+        values.emplace(key, feature->get_property(key));
+    }
+    return values;
+}
+
+} // anonymous namespace
+
+bool ngen::hydrofabric::is_compiled(const std::string& path)
+{
+    return boost::algorithm::ends_with(path, compiled_extension);
+}
+
+void ngen::hydrofabric::compile(const collections& fabric, const std::string& path)
+{
+    // Combine and link the features the same way ngen does at startup
+    std::vector<geojson::Feature> features;
+    features.reserve(fabric.nexuses->get_size() + fabric.catchments->get_size());
+    for (const auto& feature : *fabric.nexuses) {
+        features.push_back(feature);
+    }
+    for (const auto& feature : *fabric.catchments) {
+        features.push_back(feature);
+    }
+
+    geojson::FeatureCollection combined{features, std::vector<double>{}};
+    combined.update_ids("id");
+
+    std::string link_key = "toid";
+    combined.link_features_from_property(nullptr, &link_key);
+
+    std::unordered_map<const geojson::FeatureBase*, std::uint32_t> feature_index;
+    feature_index.reserve(features.size());
+    for (std::size_t i = 0; i < features.size(); i++) {
+        feature_index.emplace(features[i].get(), static_cast<std::uint32_t>(i));
+    }
+
+    compiled_writer writer;
+    for (const auto& feature : features) {
+        std::vector<std::uint32_t> destinations;
+        for (const auto* destination : feature->destination_features()) {
+            const auto found = feature_index.find(destination);
+            if (found != feature_index.end()) {
+                destinations.push_back(found->second);
+            }
+        }
+
+        fmt::feature record;
+        record.id           = writer.intern(feature->get_id());
+        record.properties   = writer.add_properties(properties(feature));
+        record.members      = writer.add_properties(foreign_members(feature));
+        record.destinations = writer.add_destinations(destinations);
+        writer.add_feature(record);
+    }
+
+    writer.write(
+        path,
+        static_cast<std::uint32_t>(fabric.nexuses->get_size()),
+        static_cast<std::uint32_t>(fabric.catchments->get_size())
+    );
+}
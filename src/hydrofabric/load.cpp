@@ -0,0 +1,231 @@
+#include "hydrofabric.hpp"
+#include "format.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "features/CollectionFeature.hpp"
+#include "mapped_file.hpp"
+
+namespace fmt = ngen::hydrofabric::format;
+
+namespace {
+
+/**
+ * Bounds-checked access to the tables of a mapped compiled hydrofabric
+ */
+class compiled_reader
+{
+  public:
+    compiled_reader(const ngen::mapped_file& file, const std::string& path)
+      : base_(file.data())
+    {
+        if (file.size() < sizeof(fmt::header)) {
+            throw std::runtime_error(path + " is not a compiled hydrofabric");
+        }
+
+        header_ = reinterpret_cast<const fmt::header*>(base_);
+        if (std::memcmp(header_->magic, fmt::magic, sizeof(fmt::magic)) != 0) {
+            throw std::runtime_error(path + " is not a compiled hydrofabric");
+        }
+
+        if (header_->version != ngen::hydrofabric::compiled_version) {
+            throw std::runtime_error(
+                path + " is compiled hydrofabric version " + std::to_string(header_->version)
+                + ", but version " + std::to_string(ngen::hydrofabric::compiled_version)
+                + " is required; recompile it with ngen-compile-hydrofabric"
+            );
+        }
+
+        const std::uint64_t feature_count = std::uint64_t{header_->nexus_count} + header_->catchment_count;
+        if (
+            header_->file_size != file.size()
+            || !table_fits(header_->strings_offset, header_->string_count + std::uint64_t{1}, sizeof(fmt::u64), header_->features_offset)
+            || !table_fits(header_->features_offset, feature_count, sizeof(fmt::feature), header_->properties_offset)
+            || !table_fits(header_->properties_offset, header_->property_count, sizeof(fmt::property), header_->links_offset)
+            || !table_fits(header_->links_offset, header_->link_count, sizeof(fmt::u32), header_->file_size)
+        ) {
+            throw std::runtime_error(path + " is truncated or corrupt");
+        }
+
+        string_offsets_ = reinterpret_cast<const fmt::u64*>(base_ + header_->strings_offset);
+        string_data_    = reinterpret_cast<const char*>(string_offsets_ + header_->string_count + 1);
+        features_       = reinterpret_cast<const fmt::feature*>(base_ + header_->features_offset);
+        properties_     = reinterpret_cast<const fmt::property*>(base_ + header_->properties_offset);
+        links_          = reinterpret_cast<const fmt::u32*>(base_ + header_->links_offset);
+
+        const std::uint64_t string_bytes = header_->features_offset - (string_data_ - base_);
+        if (string_offsets_[header_->string_count] != string_bytes) {
+            throw std::runtime_error(path + " is truncated or corrupt");
+        }
+    }
+
+    const fmt::header& header() const noexcept
+    {
+        return *header_;
+    }
+
+    std::size_t feature_count() const noexcept
+    {
+        return std::size_t{header_->nexus_count} + header_->catchment_count;
+    }
+
+    const fmt::feature& feature(std::size_t index) const
+    {
+        return features_[index];
+    }
+
+    std::uint32_t link(std::size_t index) const
+    {
+        check(index < header_->link_count);
+        return links_[index];
+    }
+
+    std::string string(std::uint64_t index) const
+    {
+        check(index < header_->string_count);
+        const std::uint64_t begin = string_offsets_[index];
+        const std::uint64_t end   = string_offsets_[index + 1];
+        check(begin <= end && end <= string_offsets_[header_->string_count]);
+        return std::string(string_data_ + begin, end - begin);
+    }
+
+    geojson::PropertyMap properties(const fmt::range& block) const
+    {
+        check(std::uint64_t{block.first} + block.count <= header_->property_count);
+
+        geojson::PropertyMap values;
+        for (std::uint32_t i = 0; i < block.count; i++) {
+            const fmt::property& record = properties_[block.first + i];
+            std::string key = string(record.key);
+            values.emplace(key, property(key, record));
+        }
+        return values;
+    }
+
+  private:
+    static bool table_fits(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t end)
+    {
+        return offset <= end && count <= (end - offset) / size;
+    }
+
+    static void check(bool condition)
+    {
+        if (!condition) {
+            throw std::runtime_error("compiled hydrofabric is corrupt");
+        }
+    }
+
+    geojson::JSONProperty property(const std::string& key, const fmt::property& record) const
+    {
+        switch (static_cast<fmt::property_type>(static_cast<std::uint8_t>(record.type))) {
+            case fmt::property_type::natural:
+                return geojson::JSONProperty(key, static_cast<long>(static_cast<std::int64_t>(record.value)));
+            case fmt::property_type::real: {
+                const std::uint64_t bits = record.value;
+                double real;
+                std::memcpy(&real, &bits, sizeof(real));
+                return geojson::JSONProperty(key, real);
+            }
+            case fmt::property_type::boolean:
+                return geojson::JSONProperty(key, record.value != 0);
+            case fmt::property_type::string:
+                // Use the const char* constructor; the std::string one re-infers the type
+                return geojson::JSONProperty(key, string(record.value).c_str());
+            case fmt::property_type::list: {
+                check(std::uint64_t{record.children.first} + record.children.count <= header_->property_count);
+                std::vector<geojson::JSONProperty> elements;
+                elements.reserve(record.children.count);
+                for (std::uint32_t i = 0; i < record.children.count; i++) {
+                    elements.push_back(property(key, properties_[record.children.first + i]));
+                }
+                return geojson::JSONProperty(key, std::move(elements));
+            }
+            case fmt::property_type::object: {
+                geojson::PropertyMap values = properties(record.children);
+                return geojson::JSONProperty(key, values);
+            }
+            default:
+                throw std::runtime_error("compiled hydrofabric is corrupt");
+        }
+    }
+
+    const char*          base_;
+    const fmt::header*   header_;
+    const fmt::u64*      string_offsets_;
+    const char*          string_data_;
+    const fmt::feature*  features_;
+    const fmt::property* properties_;
+    const fmt::u32*      links_;
+};
+
+} // anonymous namespace
+
+ngen::hydrofabric::collections ngen::hydrofabric::load(
+    const std::string& path,
+    const std::vector<std::string>& catchment_ids,
+    const std::vector<std::string>& nexus_ids
+)
+{
+    const ngen::mapped_file file{path, "compiled hydrofabric"};
+    const compiled_reader reader{file, path};
+
+    const std::unordered_set<std::string> catchment_subset(catchment_ids.begin(), catchment_ids.end());
+    const std::unordered_set<std::string> nexus_subset(nexus_ids.begin(), nexus_ids.end());
+    const std::size_t nexus_count = reader.header().nexus_count;
+
+    // Build the selected features; unselected ones stay null so links to them are dropped
+    std::vector<geojson::Feature> features(reader.feature_count());
+    std::vector<geojson::Feature> nexuses;
+    std::vector<geojson::Feature> catchments;
+    auto nexus_properties     = std::make_shared<geojson::PropertyTable>();
+    auto catchment_properties = std::make_shared<geojson::PropertyTable>();
+    for (std::size_t i = 0; i < features.size(); i++) {
+        const fmt::feature& record = reader.feature(i);
+        const bool is_nexus = i < nexus_count;
+        const auto& subset  = is_nexus ? nexus_subset : catchment_subset;
+
+        std::string id = reader.string(record.id);
+        if (!subset.empty() && subset.count(id) == 0) {
+            continue;
+        }
+
+        features[i] = std::make_shared<geojson::CollectionFeature>(
+            std::vector<geojson::geometry>{},
+            std::move(id),
+            reader.properties(record.properties),
+            std::vector<double>{},
+            std::vector<geojson::FeatureBase*>{},
+            std::vector<geojson::FeatureBase*>{},
+            reader.properties(record.members)
+        );
+
+        features[i]->move_properties_to(is_nexus ? nexus_properties : catchment_properties);
+        (is_nexus ? nexuses : catchments).push_back(features[i]);
+    }
+
+    for (std::size_t i = 0; i < features.size(); i++) {
+        if (features[i] == nullptr) {
+            continue;
+        }
+
+        const fmt::range& destinations = reader.feature(i).destinations;
+        for (std::uint32_t link = 0; link < destinations.count; link++) {
+            const std::uint32_t target = reader.link(std::size_t{destinations.first} + link);
+            if (target < features.size() && features[target] != nullptr) {
+                features[i]->add_destination_feature(features[target].get());
+            }
+        }
+    }
+
+    collections fabric;
+    fabric.nexuses    = std::make_shared<geojson::FeatureCollection>(std::move(nexuses), std::vector<double>{});
+    fabric.catchments = std::make_shared<geojson::FeatureCollection>(std::move(catchments), std::vector<double>{});
+    fabric.nexuses->store_properties_in_columns(std::move(nexus_properties));
+    fabric.catchments->store_properties_in_columns(std::move(catchment_properties));
+    fabric.nexuses->update_ids();
+    fabric.catchments->update_ids();
+
+    return fabric;
+}
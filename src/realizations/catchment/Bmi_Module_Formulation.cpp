@@ -1,6 +1,10 @@
 #include "Bmi_Module_Formulation.hpp"
 #include "utilities/logging_utils.h"
 #include <UnitsHelper.hpp>
+#include "catchment_profile.hpp"
+
+#include <algorithm>
+#include <cmath>
 
 namespace realization {
         void Bmi_Module_Formulation::create_formulation(boost::property_tree::ptree &config, geojson::PropertyMap *global) {
@@ -623,10 +627,17 @@ namespace realization {
         }
 
         void Bmi_Module_Formulation::set_model_inputs_prior_to_update(const double &model_init_time, time_step_t t_delta) {
+            NGEN_PROFILE_CATCHMENT(profile_row, ngen::profiling::catchment_profile::set_inputs);
             std::vector<std::string> in_var_names = get_bmi_model()->GetInputVarNames();
             time_t model_epoch_time = convert_model_time(model_init_time) + get_bmi_model_start_time_forcing_offset_s();
 
             for (std::string & var_name : in_var_names) {
+                auto direct_it = direct_inputs.find(var_name);
+                if (direct_it != direct_inputs.end()) {
+                    set_direct_input(var_name, direct_it->second);
+                    continue;
+                }
+
                 data_access::GenericDataProvider *provider;
                 std::string var_map_alias = get_config_mapped_variable_name(var_name);
                 if (input_forcing_providers.find(var_map_alias) != input_forcing_providers.end()) {
@@ -680,4 +691,69 @@ namespace realization {
                 get_bmi_model()->SetValue(var_name, value_ptr.get());
             }
         }
+
+        bool Bmi_Module_Formulation::bind_direct_input(const std::string &input_var_name,
+                                                       std::shared_ptr<models::bmi::Bmi_Adapter> source,
+                                                       const std::string &source_var_name) {
+            auto model = get_bmi_model();
+            try {
+                int item_size = model->GetVarItemsize(input_var_name);
+                int source_item_size = source->GetVarItemsize(source_var_name);
+                int num_items = model->GetVarNbytes(input_var_name) / item_size;
+                if (num_items != source->GetVarNbytes(source_var_name) / source_item_size) {
+                    return false;
+                }
+
+                std::string type = model->get_analogous_cxx_type(model->GetVarType(input_var_name), item_size);
+                std::string source_type = source->get_analogous_cxx_type(source->GetVarType(source_var_name),
+                                                                         source_item_size);
+                std::string units = model->GetVarUnits(input_var_name);
+                std::string source_units = source->GetVarUnits(source_var_name);
+
+                // The output must be readable in place
+                if (source->GetValuePtr(source_var_name) == nullptr) {
+                    return false;
+                }
+
+                Direct_Input direct;
+                direct.source = std::move(source);
+                direct.source_var_name = source_var_name;
+                if (units != source_units) {
+                    if (type != "double" || source_type != "double") {
+                        return false;
+                    }
+                    // Take the conversion as linear from two points, and check it against a third
+                    direct.offset = UnitsHelper::get_converted_value(source_units, 0.0, units);
+                    direct.scale = UnitsHelper::get_converted_value(source_units, 1.0, units) - direct.offset;
+                    double check = UnitsHelper::get_converted_value(source_units, 1000.0, units);
+                    if (std::abs(check - (direct.offset + 1000.0 * direct.scale)) > 1e-9 * std::max(1.0, std::abs(check))) {
+                        return false;
+                    }
+                    direct.convert = true;
+                    direct.buffer.resize(num_items);
+                }
+                else if (type != source_type) {
+                    return false;
+                }
+
+                direct_inputs[input_var_name] = std::move(direct);
+                return true;
+            }
+            // E.g., the source doesn't support GetValuePtr, or the units don't convert; the provider handles those
+            catch (const std::exception &e) {
+                return false;
+            }
+        }
+
+        void Bmi_Module_Formulation::set_direct_input(const std::string &input_var_name, Direct_Input &direct) {
+            void *values = direct.source->GetValuePtr(direct.source_var_name);
+            if (direct.convert) {
+                const double *source_values = static_cast<const double *>(values);
+                for (size_t i = 0; i < direct.buffer.size(); ++i) {
+                    direct.buffer[i] = direct.offset + direct.scale * source_values[i];
+                }
+                values = direct.buffer.data();
+            }
+            get_bmi_model()->SetValue(input_var_name, values);
+        }
 }
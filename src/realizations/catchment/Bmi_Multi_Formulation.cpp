@@ -6,6 +6,7 @@
 #include <iostream>
 #include "Bmi_Py_Formulation.hpp"
 #include <WrappedDataProvider.hpp>
+#include "catchment_profile.hpp"
 
 #include "Bmi_Cpp_Formulation.hpp"
 #include "Bmi_C_Formulation.hpp"
@@ -95,6 +96,13 @@ void Bmi_Multi_Formulation::create_multi_formulation(geojson::PropertyMap proper
     // After all nested formulations have been initialized, reconcile deferred providers
     init_deferred_associations();
 
+    #if NGEN_WITH_PROFILING
+    module_profile_columns.clear();
+    for (const nested_module_ptr &module : modules) {
+        module_profile_columns.push_back(ngen::profiling::catchment_profile::instance().column(module->get_model_type_name()));
+    }
+    #endif
+
     // TODO: get synced start_time values for all models
     // TODO: get synced end_time values for all models
 
@@ -156,6 +164,44 @@ void Bmi_Multi_Formulation::create_multi_formulation(geojson::PropertyMap proper
     }
 }
 
+void Bmi_Multi_Formulation::init_direct_couplings() {
+    for (nested_module_ptr &nested : modules) {
+        auto module = std::dynamic_pointer_cast<Bmi_Module_Formulation>(nested);
+        if (module == nullptr) {
+            continue;
+        }
+        module->direct_inputs.clear();
+        for (const std::string &var_name : module->get_bmi_input_variables()) {
+            const std::string &var_map_alias = module->get_config_mapped_variable_name(var_name);
+            auto provider_it = module->input_forcing_providers.find(var_map_alias);
+            if (provider_it == module->input_forcing_providers.end()) {
+                provider_it = module->input_forcing_providers.find(var_name);
+            }
+            if (provider_it == module->input_forcing_providers.end()) {
+                continue;
+            }
+
+            // Only providers that are themselves nested modules are bound
+            std::shared_ptr<Bmi_Module_Formulation> source;
+            for (nested_module_ptr &m : modules) {
+                if (m != nested && static_cast<data_access::GenericDataProvider*>(m.get()) == provider_it->second.get()) {
+                    source = std::dynamic_pointer_cast<Bmi_Module_Formulation>(m);
+                    break;
+                }
+            }
+            if (source == nullptr) {
+                continue;
+            }
+
+            std::string source_var_name;
+            source->get_bmi_output_var_name(provider_it->first, source_var_name);
+            if (!source_var_name.empty()) {
+                module->bind_direct_input(var_name, source->get_bmi_model(), source_var_name);
+            }
+        }
+    }
+}
+
 /**
  * Get whether a model may perform updates beyond its ``end_time``.
  *
@@ -365,9 +411,10 @@ double Bmi_Multi_Formulation::get_response(time_step_t t_index, time_step_t t_de
     }
 
     while (next_time_step_index <= t_index) {
-        for (nested_module_ptr &module : modules) {
+        for (std::size_t i = 0; i < modules.size(); ++i) {
             // By setting up in create function, these will now have their own providers
-            module->get_response(t_index, t_delta);
+            NGEN_PROFILE_CATCHMENT(profile_row, module_profile_columns[i]);
+            modules[i]->get_response(t_index, t_delta);
         }
         next_time_step_index++;
     }
@@ -38,6 +38,7 @@ void Routing_Py_Adapter::route(int number_of_timesteps, int delta_time,
 
 void Routing_Py_Adapter::route(int number_of_timesteps, int delta_time)
 {
+  utils::ngenPy::ConcurrentGilAcquire gil;
 
   std::vector<std::string> arg_vector;
 
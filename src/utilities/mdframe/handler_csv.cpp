@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
 
 #include "mdframe/mdframe.hpp"
@@ -6,92 +9,195 @@
 
 namespace ngen {
 
+namespace {
+
 /**
- * @brief 
- * 
- * @param shape 
- * @param index 
- * @param dimension 
- * @param output 
+ * Steps through every index of a shape in row-major order without allocating.
+ *
+ * Like an odometer, the last dimension turns fastest, and each dimension that
+ * rolls over advances the one before it. A shape with an empty dimension has
+ * no indices; a shape with no dimensions has a single, empty index.
  */
-void cartesian_indices_recurse(
-    boost::span<const std::size_t>         shape,
-    std::size_t                            current_dimension_index,
-    std::vector<std::size_t>&              index_buffer,
-    std::vector<std::vector<std::size_t>>& output
-)
+class index_odometer
 {
-    if (current_dimension_index == shape.size()) {
-        output.push_back(index_buffer);
-        return;
+  public:
+    explicit index_odometer(boost::span<const std::size_t> shape)
+      : shape_(shape)
+      , index_(shape.size(), 0)
+      , done_(false)
+    {
+        for (std::size_t extent : shape) {
+            if (extent == 0)
+                done_ = true;
+        }
     }
 
-    for (std::size_t i = 0; i < shape[current_dimension_index]; i++) {
-        index_buffer[current_dimension_index] = i;
-        cartesian_indices_recurse(shape, current_dimension_index + 1, index_buffer, output);
+    bool done() const noexcept
+    {
+        return done_;
     }
-}
 
-void cartesian_indices(const boost::span<const std::size_t> shape, std::vector<std::vector<std::size_t>>& output)
+    boost::span<const std::size_t> index() const noexcept
+    {
+        return index_;
+    }
+
+    void next() noexcept
+    {
+        for (std::size_t d = shape_.size(); d-- > 0;) {
+            if (++index_[d] < shape_[d])
+                return;
+            index_[d] = 0;
+        }
+        done_ = true;
+    }
+
+  private:
+    boost::span<const std::size_t> shape_;
+    std::vector<std::size_t>       index_;
+    bool                           done_;
+};
+
+/**
+ * Write the decimal digits of @p value ending just before @p end, returning where they start
+ */
+char* write_digits_backward(char* end, unsigned long long value) noexcept
 {
-    std::vector<std::size_t> index_buffer(shape.size());
-    cartesian_indices_recurse(shape, 0, index_buffer, output);
+    do {
+        *--end = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    return end;
 }
 
-void mdframe::to_csv(const std::string& path, bool header) const
+// Values are formatted as std::to_string formats them, which the CSV output has always used
+
+void append_value(std::string& out, int value)
 {
-    std::ofstream output(path);
-    if (!output)
-        throw std::runtime_error("failed to open file " + path);
-    
-    std::string header_line = "";
+    char digits[16];
+    char* const end = digits + sizeof digits;
+    const unsigned long long magnitude = value < 0
+        ? 0ULL - static_cast<unsigned long long>(static_cast<long long>(value))
+        : static_cast<unsigned long long>(value);
+    char* begin = write_digits_backward(end, magnitude);
+    if (value < 0)
+        *--begin = '-';
+    out.append(begin, end);
+}
 
-    std::vector<variable> variable_subset;
-    // will be at most # of vars
-    variable_subset.reserve(this->m_variables.size());
+/**
+ * Append a value as "%f" would, with six decimal places.
+ *
+ * The fraction of a value below 2^53 is exact after taking off its whole part, and scaling it by
+ * 10^6 is off by well under 10^-9, so the last digit is rounded directly unless the scaled fraction
+ * is within 10^-6 of a rounding boundary. Those values, and non-finite or larger ones, are left to
+ * snprintf for exact rounding.
+ */
+void append_value(std::string& out, double value)
+{
+    const double magnitude = std::fabs(value);
+    if (std::isfinite(value) && magnitude < 9007199254740992.0) {
+        const double whole     = std::floor(magnitude);
+        const double scaled    = (magnitude - whole) * 1e6;
+        const double truncated = std::floor(scaled);
+        const double distance  = scaled - truncated - 0.5;
+        if (std::fabs(distance) > 1e-6) {
+            unsigned long long integer  = static_cast<unsigned long long>(whole);
+            unsigned long long fraction = static_cast<unsigned long long>(truncated) + (distance > 0 ? 1 : 0);
+            if (fraction == 1000000) {
+                fraction = 0;
+                integer++;
+            }
 
-    // Get subset of variables that span over the given basis
-    size_type max_rank = 0;
-    for (const auto& pair : this->m_variables) {
-        const auto& dims = pair.second.dimensions();
-        variable_subset.push_back(pair.second);
-
-        size_type rank = pair.second.rank();
-        if (rank > max_rank)
-            max_rank = rank;
-        
-        if (header)
-            header_line += pair.first + ",";
+            char digits[32];
+            char* const end = digits + sizeof digits;
+            // Offset the fraction so it is written with its leading zeros, then replace the offset's 1
+            char* begin = write_digits_backward(end, fraction + 1000000);
+            *begin = '.';
+            begin = write_digits_backward(begin, integer);
+            if (std::signbit(value))
+                *--begin = '-';
+            out.append(begin, end);
+            return;
+        }
     }
 
-    if (variable_subset.empty()) {
-        throw std::runtime_error("cannot output CSV with no output variables");
-    }
+    // Large enough for any double in fixed notation
+    char formatted[400];
+    const int length = std::snprintf(formatted, sizeof formatted, "%f", value);
+    out.append(formatted, static_cast<std::size_t>(length));
+}
 
-    // Calculate total number of rows across all subdimensions (not including header)
-    size_type rows = 1;
-    std::vector<size_type> shape;
-    shape.reserve(this->m_dimensions.size());
-    for (const auto& dim : this->m_dimensions) {
-        rows += dim.size();
-        shape.push_back(dim.size());
+void append_value(std::string& out, float value)
+{
+    append_value(out, static_cast<double>(value));
+}
+
+/**
+ * Appends the value of a variable at an index to a row
+ */
+struct csv_value_writer : public boost::static_visitor<void>
+{
+    csv_value_writer(std::string& out, boost::span<const std::size_t> index)
+      : out(out)
+      , index(index)
+    {}
+
+    template<typename T>
+    void operator()(const mdarray<T>& values) const
+    {
+        append_value(out, values.at(index));
     }
 
-    if (header && header_line != "") {
-        header_line.pop_back();
-        output << header_line << std::endl;
+    std::string&                   out;
+    boost::span<const std::size_t> index;
+};
+
+// Rows are written out whenever this much has been buffered
+constexpr std::size_t write_buffer_size = 1 << 20;
+
+} // namespace
+
+/**
+ * @brief Generate every index of a shape, in row-major order
+ *
+ * @param shape Size of each dimension
+ * @param output Receives one index per element of the shape
+ */
+void cartesian_indices(const boost::span<const std::size_t> shape, std::vector<std::vector<std::size_t>>& output)
+{
+    for (index_odometer odometer{shape}; !odometer.done(); odometer.next()) {
+        output.emplace_back(odometer.index().begin(), odometer.index().end());
     }
+}
 
-    // Create an index between the variable's dimensions, and the dimensions
+void mdframe::to_csv(const std::string& path, bool header) const
+{
+    std::ofstream output(path, std::ios::binary);
+    if (!output)
+        throw std::runtime_error("failed to open file " + path);
+
+    std::vector<const mdarray_variant*> variable_values;
+    variable_values.reserve(this->m_variables.size());
+
+    std::string buffer;
+    buffer.reserve(write_buffer_size + 4096);
+
+    // Create an index between each variable's dimensions, and the dimensions
     // of the mdframe, such that when a variable needs to be passed an index,
     // the dimensions will be ordered correctly.
     //
     // i.e. { value(x, t, y) : {2, 1, 3} }
-    std::unordered_map<std::string, std::vector<size_type>> vd_index;
-    for (const auto& var : variable_subset) {
-        vd_index[var.name()] = std::vector<size_type>{};
-        std::vector<size_type>& variable_index = vd_index[var.name()];
+    std::vector<std::vector<size_type>> variable_dimensions;
+    variable_dimensions.reserve(this->m_variables.size());
 
+    size_type max_rank = 0;
+    for (const auto& pair : this->m_variables) {
+        const auto& var = pair.second;
+        variable_values.push_back(&var.values());
+
+        variable_dimensions.emplace_back();
+        std::vector<size_type>& variable_index = variable_dimensions.back();
         variable_index.reserve(var.rank());
         for (const auto& dim : var.dimensions()) {
             variable_index.push_back(
@@ -103,32 +209,55 @@ void mdframe::to_csv(const std::string& path, bool header) const
                 )
             );
         }
+        max_rank = std::max(max_rank, var.rank());
+
+        if (header) {
+            buffer += pair.first;
+            buffer += ',';
+        }
     }
 
-    detail::visitors::to_string_visitor visitor{};
-    std::string output_line = "";
-    std::vector<std::vector<size_type>> indices;
-    indices.reserve(rows);
+    if (variable_values.empty()) {
+        throw std::runtime_error("cannot output CSV with no output variables");
+    }
+
+    if (header) {
+        buffer.back() = '\n';
+    }
+
+    std::vector<size_type> shape;
+    shape.reserve(this->m_dimensions.size());
+    for (const auto& dim : this->m_dimensions) {
+        shape.push_back(dim.size());
+    }
 
-    ngen::cartesian_indices(shape, indices);
-    
     std::vector<size_type> index_buffer(max_rank);
-    for (const auto& index : indices) {
-        for (auto var : variable_subset) {
-            boost::span<size_type> index_view{ index_buffer.data(), var.rank() };
-            boost::span<size_type> vd_view{vd_index[var.name()]};
-            for (size_type i = 0; i < var.rank(); i++)
-                index_view[i] = index.at(vd_view[i]);
-
-            decltype(auto) value = var.at(index_view);
-            output_line += value.apply_visitor(visitor) + ",";
+    for (index_odometer odometer{shape}; !odometer.done(); odometer.next()) {
+        const boost::span<const size_type> index = odometer.index();
+
+        for (std::size_t v = 0; v < variable_values.size(); v++) {
+            const std::vector<size_type>& dimensions = variable_dimensions[v];
+            for (size_type i = 0; i < dimensions.size(); i++)
+                index_buffer[i] = index[dimensions[i]];
+
+            boost::apply_visitor(
+                csv_value_writer{ buffer, { index_buffer.data(), dimensions.size() } },
+                *variable_values[v]
+            );
+            buffer += ',';
         }
+        buffer.back() = '\n';
 
-        output_line.pop_back();
-        output << output_line << std::endl;
-        output_line.clear();
+        if (buffer.size() >= write_buffer_size) {
+            output.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
     }
+
+    output.write(buffer.data(), buffer.size());
+    output.flush();
+    if (!output)
+        throw std::runtime_error("failed to write file " + path);
 }
 
 } // namespace ngen
-
@@ -53,6 +53,10 @@ protected:
         return (model_data*) adapter->bmi_model->data;
     }
 
+    static const void* friend_get_dyn_lib_handle(Bmi_C_Adapter *adapter) {
+        return adapter->get_dyn_lib_handle();
+    }
+
     std::string config_file_name_0;
     std::string lib_file_name_0;
     std::string bmi_module_type_name_0;
@@ -113,6 +117,26 @@ TEST_F(Bmi_C_Adapter_Test, Initialize_0_a) {
     adapter->Finalize();
 }
 
+/** Test that adapters for the same library share one loaded copy of it, and that it is reloaded once released. */
+TEST_F(Bmi_C_Adapter_Test, SharedLibrary_0_a) {
+    auto other = std::make_unique<Bmi_C_Adapter>(bmi_module_type_name_0, lib_file_name_0, config_file_name_0,
+                                                 true, REGISTRATION_FUNC);
+    ASSERT_NE(friend_get_dyn_lib_handle(adapter.get()), nullptr);
+    ASSERT_EQ(friend_get_dyn_lib_handle(adapter.get()), friend_get_dyn_lib_handle(other.get()));
+
+    // Each adapter still has its own model
+    ASSERT_NE(friend_get_model_data_struct(adapter.get()), friend_get_model_data_struct(other.get()));
+
+    other.reset();
+    adapter.reset();
+    ASSERT_EQ(SharedLibrary::find(lib_file_name_0), nullptr);
+
+    adapter = std::make_unique<Bmi_C_Adapter>(bmi_module_type_name_0, lib_file_name_0, config_file_name_0,
+                                              true, REGISTRATION_FUNC);
+    adapter->Update();
+    ASSERT_NE(SharedLibrary::find(lib_file_name_0), nullptr);
+}
+
 /** Test output variables can be retrieved. */
 TEST_F(Bmi_C_Adapter_Test, GetOutputVarNames_0_a) {
     try {
@@ -0,0 +1,131 @@
+#include <NGenConfig.h>
+
+#include "gtest/gtest.h"
+
+#if NGEN_WITH_NETCDF
+#include "CsvForcingConverter.hpp"
+#include "CsvForcingReader.hpp"
+#include "NetCDFPerFeatureDataProvider.hpp"
+#include "AorcForcing.hpp"
+#include "FileChecker.h"
+#include "StreamHandler.hpp"
+#endif
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+class CsvForcingConverterTest : public ::testing::Test
+{
+  protected:
+    CsvForcingConverterTest()
+        : output_path(testing::TempDir())
+    {
+        if (output_path.back() != '/') {
+            output_path.append("/");
+        }
+        output_path.append("ngen__CsvForcingConverter_Test.nc");
+    }
+
+    ~CsvForcingConverterTest() override
+    {
+        unlink(output_path.c_str());
+    }
+
+    std::string output_path;
+
+    const std::vector<std::string> csv_directories = { "data/forcing", "../data/forcing", "../../data/forcing" };
+};
+
+TEST_F(CsvForcingConverterTest, RoundTrip)
+{
+#if !NGEN_WITH_NETCDF
+    GTEST_SKIP() << "NetCDF is not available";
+#else
+    std::vector<std::string> first_files;
+    for (const auto& directory : csv_directories) {
+        first_files.push_back(directory + "/cat-27_2015-12-01 00_00_00_2015-12-30 23_00_00.csv");
+    }
+    const std::string first_file = utils::FileChecker::find_first_readable(first_files);
+    ASSERT_FALSE(first_file.empty());
+    const std::string csv_directory = first_file.substr(0, first_file.rfind('/'));
+
+    // Three catchments per chunk, so the last chunk of the four catchments is partial
+    data_access::CsvForcingConversion options;
+    options.threads = 2;
+    options.pattern = "{{id}}_2015-12-01 00_00_00_2015-12-30 23_00_00\\.csv";
+    options.double_precision = true;
+    options.chunk_catchments = 3;
+
+    std::stringstream progress;
+    const auto summary = data_access::convert_csv_forcing(csv_directory, output_path, options, progress);
+    ASSERT_EQ(summary.catchments, 4);
+    ASSERT_EQ(summary.steps, 720);
+
+    data_access::NetCDFPerFeatureDataProvider provider(
+        output_path, std::numeric_limits<time_t>::min(), std::numeric_limits<time_t>::max(), utils::getStdErr()
+    );
+    ASSERT_EQ(provider.get_ids(), std::vector<std::string>({ "agg-1", "cat-27", "cat-52", "cat-67" }));
+    ASSERT_EQ(provider.record_duration(), 3600);
+
+    for (const auto& id : provider.get_ids()) {
+        const auto table = data_access::read_csv_forcing(
+            csv_directory + "/" + id + "_2015-12-01 00_00_00_2015-12-30 23_00_00.csv",
+            std::numeric_limits<time_t>::min(),
+            std::numeric_limits<time_t>::max()
+        );
+        ASSERT_EQ(table.times.size(), summary.steps);
+
+        for (std::size_t c = 0; c < table.header.size(); c++) {
+            if (c == table.time_column) {
+                continue;
+            }
+
+            std::string name, units;
+            data_access::parse_csv_forcing_column(table.header[c], name, units);
+            const auto wkf = data_access::WellKnownFields.find(name);
+            if (units.empty() && wkf != data_access::WellKnownFields.end()) {
+                units = std::get<1>(wkf->second);
+            }
+
+            for (std::size_t step : { std::size_t(0), std::size_t(1), summary.steps / 2, summary.steps - 1 }) {
+                CatchmentAggrDataSelector selector(id, name, table.times[step], 3600, units);
+                EXPECT_EQ(provider.get_value(selector, data_access::MEAN), table.columns[c][step]) << id << " " << name << " " << step;
+            }
+        }
+    }
+
+    provider.finalize();
+#endif
+}
+
+TEST_F(CsvForcingConverterTest, MismatchedFileFails)
+{
+#if !NGEN_WITH_NETCDF
+    GTEST_SKIP() << "NetCDF is not available";
+#else
+    std::string directory_template = testing::TempDir();
+    if (directory_template.back() != '/') {
+        directory_template.append("/");
+    }
+    directory_template.append("ngen__CsvForcingConverter_Test_XXXXXX");
+    const std::string csv_directory = mkdtemp(&directory_template[0]);
+
+    std::ofstream(csv_directory + "/cat-1.csv") << "time,T2D\n2015-12-01 00:00:00,280\n2015-12-01 01:00:00,281\n";
+    std::ofstream(csv_directory + "/cat-2.csv") << "time,T2D\n2015-12-01 00:00:00,282\n";
+    std::ofstream(csv_directory + "/cat-3.csv") << "time,T2D\n2015-12-01 00:00:00,283\n2015-12-01 01:00:00,284\n";
+
+    data_access::CsvForcingConversion options;
+    options.threads = 1;
+    std::stringstream progress;
+    EXPECT_THROW(data_access::convert_csv_forcing(csv_directory, output_path, options, progress), std::runtime_error);
+
+    for (const char* name : { "/cat-1.csv", "/cat-2.csv", "/cat-3.csv" }) {
+        unlink((csv_directory + name).c_str());
+    }
+    rmdir(csv_directory.c_str());
+#endif
+}
@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+#include "CsvForcingReader.hpp"
+
+class CsvForcingReader_Test : public ::testing::Test {
+
+    protected:
+
+    void SetUp() override {
+        char path_template[] = "/tmp/ngen_csv_forcing_XXXXXX";
+        const int fd = mkstemp(path_template);
+        ASSERT_NE(fd, -1);
+        close(fd);
+        path = path_template;
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    void write(const std::string& contents) {
+        std::ofstream(path, std::ios::binary) << contents;
+    }
+
+    std::string path;
+
+    // 2015-12-01 00:00:00 UTC
+    const time_t day_start = 1448928000;
+};
+
+TEST_F(CsvForcingReader_Test, ReadsRowsWithinWindow)
+{
+    write(
+        "time,APCP_surface,T2D [K]\n"
+        "2015-12-01 00:00:00,0.5,265.30\n"
+        "2015-12-01 01:00:00,1.25,264.11\n"
+        "2015-12-01 02:00:00,0.0,-1e-3\n"
+        "2015-12-01 03:00:00,2.0,263.0\n"
+    );
+
+    const auto table = data_access::read_csv_forcing(path, day_start + 3600, day_start + 2 * 3600);
+
+    ASSERT_EQ(table.header.size(), 3);
+    EXPECT_EQ(table.header[2], "T2D [K]");
+    EXPECT_EQ(table.time_column, 0);
+
+    ASSERT_EQ(table.times.size(), 2);
+    EXPECT_EQ(table.times[0], day_start + 3600);
+    EXPECT_EQ(table.times[1], day_start + 2 * 3600);
+
+    EXPECT_TRUE(table.columns[0].empty());
+    ASSERT_EQ(table.columns[1].size(), 2);
+    EXPECT_EQ(table.columns[1][0], 1.25);
+    EXPECT_EQ(table.columns[1][1], 0.0);
+    ASSERT_EQ(table.columns[2].size(), 2);
+    EXPECT_EQ(table.columns[2][0], 264.11);
+    EXPECT_EQ(table.columns[2][1], -1e-3);
+
+    // Reading stops at the first row after the window
+    EXPECT_EQ(table.rows_read, 4);
+    EXPECT_EQ(table.first_time, day_start);
+    EXPECT_EQ(table.last_time, day_start + 3 * 3600);
+}
+
+TEST_F(CsvForcingReader_Test, ParsesValuesAsStrtod)
+{
+    const char* values[] = {
+        "0.10000000149011612", "361.20001220703125", "-2.6000001430511475", "97498.0",
+        "0.369072640744103", "1.7976931348623157e308", "5e-324", "123456789012345678901234", "nan"
+    };
+
+    std::string contents = "time,value\n";
+    for (const char* value : values) {
+        contents += "2015-12-01 00:00:00, ";
+        contents += value;
+        contents += " \r\n";
+    }
+    write(contents);
+
+    const auto table = data_access::read_csv_forcing(path, day_start, day_start);
+
+    ASSERT_EQ(table.columns[1].size(), sizeof values / sizeof values[0]);
+    for (std::size_t i = 0; i < table.columns[1].size(); i++) {
+        const double expected = std::strtod(values[i], nullptr);
+        if (expected != expected) {
+            EXPECT_NE(table.columns[1][i], table.columns[1][i]);
+        }
+        else {
+            EXPECT_EQ(table.columns[1][i], expected) << values[i];
+        }
+    }
+}
+
+TEST_F(CsvForcingReader_Test, FindsTimeColumnAndSkipsBlankLines)
+{
+    write(
+        "APCP_surface,Time\r\n"
+        "\r\n"
+        "0.5,2015-12-01 00:00:00\r\n"
+        "\n"
+        "0.75,2015-12-1 1:00:00"
+    );
+
+    const auto table = data_access::read_csv_forcing(path, day_start, day_start + 3600);
+
+    EXPECT_EQ(table.time_column, 1);
+    EXPECT_EQ(table.rows_read, 2);
+    ASSERT_EQ(table.times.size(), 2);
+    EXPECT_EQ(table.times[1], day_start + 3600);
+    ASSERT_EQ(table.columns[0].size(), 2);
+    EXPECT_EQ(table.columns[0][1], 0.75);
+}
+
+TEST_F(CsvForcingReader_Test, RejectsMalformedRows)
+{
+    write(
+        "time,APCP_surface\n"
+        "2015-11-30 23:00:00,not a number\n"
+        "2015-12-01 00:00:00,0.5\n"
+    );
+    EXPECT_THROW(data_access::read_csv_forcing(path, day_start - 3600, day_start), std::runtime_error);
+    // Values of rows before the window are never parsed
+    EXPECT_NO_THROW(data_access::read_csv_forcing(path, day_start, day_start));
+
+    write(
+        "time,APCP_surface\n"
+        "2015-12-01 00:00:00,0.5,0.25\n"
+    );
+    EXPECT_THROW(data_access::read_csv_forcing(path, day_start, day_start), std::runtime_error);
+
+    write("");
+    EXPECT_THROW(data_access::read_csv_forcing(path, day_start, day_start), std::runtime_error);
+
+    EXPECT_THROW(data_access::read_csv_forcing(path + ".missing", day_start, day_start), std::runtime_error);
+}
@@ -222,3 +222,21 @@ TEST_F(CsvPerFeatureForcingProviderTest, TestForcingUnitHeaderParsing)
         
     }
 }
+
+TEST_F(CsvPerFeatureForcingProviderTest, TestBatchValues)
+{
+    time_t begin = Forcing_Object->get_data_start_time();
+    CatchmentAggrDataSelector selector("", CSDMS_STD_NAME_SURFACE_TEMP, begin + (65 * 3600), 7200, "degC");
+
+    auto batch = Forcing_Object->get_batch({"cat-10", "cat-11", "cat-12"});
+    std::vector<double> values(3);
+    Forcing_Object->get_batch_values(batch, selector, values, data_access::MEAN);
+
+    double expected = Forcing_Object->get_value(selector, data_access::MEAN);
+    for (double value : values) {
+        EXPECT_EQ(value, expected);
+    }
+
+    values.resize(2);
+    EXPECT_THROW(Forcing_Object->get_batch_values(batch, selector, values, data_access::MEAN), std::invalid_argument);
+}
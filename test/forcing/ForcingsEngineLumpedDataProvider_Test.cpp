@@ -13,7 +13,10 @@
 #include <forcing/AorcForcing.hpp>
 #include <utilities/python/InterpreterUtil.hpp>
 
+#include <chrono>
+#include <limits>
 #include <string>
+#include <thread>
 
 struct ForcingsEngineLumpedDataProviderTest
   : public testing::Test
@@ -130,3 +133,142 @@ TEST_F(ForcingsEngineLumpedDataProviderTest, VariableAccess)
     ASSERT_GT(result2.size(), 0);
     EXPECT_NEAR(result2[0], 0, 1e-6);
 }
+
+/**
+ * Tests that values of a time step the engine has already passed are
+ * still read, from the snapshot of its outputs shared by the providers
+ * of the engine, rather than from the engine's current state.
+ */
+TEST_F(ForcingsEngineLumpedDataProviderTest, Snapshots)
+{
+    auto other = std::make_unique<data_access::ForcingsEngineLumpedDataProvider>(
+        /*init=*/TestFixture::config_file,
+        /*time_begin_seconds=*/TestFixture::time_start,
+        /*time_end_seconds=*/TestFixture::time_end,
+        /*divide_id=*/"cat-11371"
+    );
+
+    auto selector = CatchmentAggrDataSelector{"cat-11371", "LWDOWN", time_start + 3600, 3600, "seconds"};
+    EXPECT_NO_THROW(other->get_value(selector, data_access::ReSampleMethod::SUM));
+
+    selector = CatchmentAggrDataSelector{"cat-11223", "PSFC", time_start, 3600, "seconds"};
+    auto result = provider_->get_value(selector, data_access::ReSampleMethod::MEAN);
+    EXPECT_NEAR(result, 99580.52, 1e-2);
+}
+
+/**
+ * Tests that values read while the engine is advanced ahead on its own
+ * thread match those kept for the time step, that another provider can
+ * be made meanwhile, and that the look-ahead thread is no longer counted
+ * once looking ahead stops.
+ */
+TEST_F(ForcingsEngineLumpedDataProviderTest, Lookahead)
+{
+    // Start from a new instance, not yet advanced by the other tests
+    data_access::detail::ForcingsEngineStorage::instances.clear();
+
+    auto other = std::make_unique<data_access::ForcingsEngineLumpedDataProvider>(
+        /*init=*/TestFixture::config_file,
+        /*time_begin_seconds=*/TestFixture::time_start,
+        /*time_end_seconds=*/TestFixture::time_end,
+        /*divide_id=*/"cat-11371"
+    );
+    other->lookahead(true);
+
+    auto first = CatchmentAggrDataSelector{"cat-11371", "PSFC", time_start, 3600, "seconds"};
+    EXPECT_GT(other->get_value(first, data_access::ReSampleMethod::SUM), 0);
+    EXPECT_EQ(utils::ngenPy::concurrentPythonThreads().load(), 1);
+
+    // Made while the next time step is advanced to
+    auto late = std::make_unique<data_access::ForcingsEngineLumpedDataProvider>(
+        /*init=*/TestFixture::config_file,
+        /*time_begin_seconds=*/TestFixture::time_start,
+        /*time_end_seconds=*/TestFixture::time_end,
+        /*divide_id=*/"cat-11223"
+    );
+    EXPECT_EQ(late->divide_index(), provider_->divide_index());
+
+    auto second = CatchmentAggrDataSelector{"cat-11371", "PSFC", time_start + 3600, 3600, "seconds"};
+    const double result = other->get_value(second, data_access::ReSampleMethod::SUM);
+
+    other->lookahead(false);
+    EXPECT_EQ(utils::ngenPy::concurrentPythonThreads().load(), 0);
+    EXPECT_TRUE(PyGILState_Check());
+
+    EXPECT_EQ(other->get_value(second, data_access::ReSampleMethod::SUM), result);
+}
+
+/**
+ * Tests that the engine is advanced ahead while the reading thread works
+ * without the GIL, as the time loop does around model updates, and not
+ * while it holds the GIL.
+ */
+TEST_F(ForcingsEngineLumpedDataProviderTest, LookaheadOverlapsCompute)
+{
+    data_access::detail::ForcingsEngineStorage::instances.clear();
+
+    auto other = std::make_unique<data_access::ForcingsEngineLumpedDataProvider>(
+        /*init=*/TestFixture::config_file,
+        /*time_begin_seconds=*/TestFixture::time_start,
+        /*time_end_seconds=*/TestFixture::time_end,
+        /*divide_id=*/"cat-11371"
+    );
+    other->lookahead(true);
+
+    auto first = CatchmentAggrDataSelector{"cat-11371", "PSFC", time_start, 3600, "seconds"};
+    other->get_value(first, data_access::ReSampleMethod::SUM);
+    auto snapshots = data_access::detail::ForcingsEngineStorage::instances.get_snapshots(config_file);
+    ASSERT_NE(snapshots, nullptr);
+
+    // While this thread holds the GIL, the look-ahead thread cannot call the engine
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_FALSE(snapshots->ahead_ready());
+
+    // Stand-in for model updates that do not call into Python
+    bool ready = false;
+    {
+        utils::ngenPy::GilRelease released;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(2);
+        while (!(ready = snapshots->ahead_ready()) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    EXPECT_TRUE(ready);
+
+    auto second = CatchmentAggrDataSelector{"cat-11371", "PSFC", time_start + 3600, 3600, "seconds"};
+    EXPECT_GT(other->get_value(second, data_access::ReSampleMethod::SUM), 0);
+
+    other->lookahead(false);
+}
+
+/**
+ * Tests that the values of a batch of divides are those of each divide's own provider.
+ */
+TEST_F(ForcingsEngineLumpedDataProviderTest, BatchValues)
+{
+    auto other = std::make_unique<data_access::ForcingsEngineLumpedDataProvider>(
+        /*init=*/TestFixture::config_file,
+        /*time_begin_seconds=*/TestFixture::time_start,
+        /*time_end_seconds=*/TestFixture::time_end,
+        /*divide_id=*/"cat-11371"
+    );
+
+    auto batch = provider_->get_batch({"cat-11371", "cat-11223"});
+    ASSERT_EQ(batch.positions.size(), 2);
+    EXPECT_EQ(batch.positions[1], provider_->divide_index());
+
+    std::vector<double> values(2);
+    auto selector = CatchmentAggrDataSelector{"", "PSFC", time_start, 7200, "seconds"};
+    provider_->get_batch_values(batch, selector, values, data_access::ReSampleMethod::MEAN);
+
+    selector.set_id("cat-11371");
+    EXPECT_EQ(values[0], other->get_value(selector, data_access::ReSampleMethod::MEAN));
+    selector.set_id("cat-11223");
+    EXPECT_EQ(values[1], provider_->get_value(selector, data_access::ReSampleMethod::MEAN));
+
+    EXPECT_THROW(provider_->get_batch({"cat-1"}), std::out_of_range);
+
+    const data_access::CatchmentBatch outside{{"cat-1"}, {std::numeric_limits<std::size_t>::max()}};
+    std::vector<double> value(1);
+    EXPECT_THROW(provider_->get_batch_values(outside, selector, value, data_access::ReSampleMethod::MEAN), std::out_of_range);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <set>
+#include <utility>
 
 #include <forcing/DataProvider.hpp>
 #include <forcing/GridDataSelector.hpp>
@@ -197,5 +199,56 @@ TEST(GridDataSelectorTest, PointSelection) {
     EXPECT_EQ(cells[1].y, 5);
 }
 
-// TODO: Add boundary/polygon constructor test
-// TEST(GridDataSelectorTest, PolygonSelection)
+// Tests for boundary-based selection using a polygon that
+// covers some cells in whole and some in part.
+TEST(GridDataSelectorTest, PolygonSelection) {
+    GridSpecification grid_spec {
+        10, // rows
+        20, // cols
+        /*extent=*/box_t{{0, 0}, {10, 5}}
+    };
+
+    TestGridDataProvider provider{grid_spec};
+
+    // A triangle with its right angle at (1, 2), covering parts of columns 2-4 and rows 4-6
+    geojson::polygon_t polygon;
+    boost::geometry::read_wkt("POLYGON((1 2,1 3.5,2.5 2,1 2))", polygon);
+
+    GridDataSelector selector{
+        TestGridDataProvider::default_selector,
+        grid_spec,
+        polygon
+    };
+
+    const auto cells = provider.get_values(selector, data_access::ReSampleMethod::SUM);
+
+    std::set<std::pair<std::uint64_t, std::uint64_t>> selected;
+    for (const auto& cell : cells) {
+        EXPECT_EQ(cell.value, static_cast<double>(cell.x + cell.y));
+        selected.emplace(cell.x, cell.y);
+    }
+    EXPECT_EQ(selected.size(), cells.size());
+
+    // Only cells with some area below the hypotenuse, x + y = 3.5, which runs through their corners
+    const std::set<std::pair<std::uint64_t, std::uint64_t>> expected = {
+        {2, 4}, {3, 4}, {4, 4}, {2, 5}, {3, 5}, {2, 6}
+    };
+    EXPECT_EQ(selected, expected);
+}
+
+// Grid selectors cannot be pointed at a catchment by id, so a grid provider
+// that does not implement batches refuses them rather than guessing.
+TEST(GridDataSelectorTest, BatchValuesUnsupported) {
+    TestGridDataProvider provider{};
+    GridDataSelector selector{
+        TestGridDataProvider::default_selector,
+        {{ make_cell_xy(0, 0) }}
+    };
+
+    const auto batch = provider.get_batch({ "cat-1", "cat-2" });
+    std::vector<Cell> values(2);
+    EXPECT_THROW(
+        provider.get_batch_values(batch, selector, values, data_access::ReSampleMethod::SUM),
+        std::logic_error
+    );
+}
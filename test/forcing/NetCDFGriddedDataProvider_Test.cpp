@@ -0,0 +1,131 @@
+#include <NGenConfig.h>
+
+#include "gtest/gtest.h"
+
+#if NGEN_WITH_NETCDF
+#include <netcdf>
+
+#include "NetCDFGriddedDataProvider.hpp"
+#include "StreamHandler.hpp"
+#endif
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+class NetCDFGriddedDataProviderTest : public ::testing::Test
+{
+  protected:
+    NetCDFGriddedDataProviderTest()
+        : grid_path(testing::TempDir())
+    {
+        if (grid_path.back() != '/') {
+            grid_path.append("/");
+        }
+        geometry_path = grid_path + "ngen__NetCDFGriddedDataProvider_Test.geojson";
+        grid_path.append("ngen__NetCDFGriddedDataProvider_Test.nc");
+    }
+
+    void SetUp() override;
+
+    void TearDown() override;
+
+    std::string grid_path;
+    std::string geometry_path;
+
+    // 2015-12-01 00:00:00 UTC
+    const time_t start_time = 1448928000;
+};
+
+void NetCDFGriddedDataProviderTest::SetUp()
+{
+#if NGEN_WITH_NETCDF
+    // A grid of 4 by 3 unit cells with extent [0, 4] in x and [0, 3] in y, stored from north to south.
+    // Each cell holds 10 * row + column, counting rows from the south, plus 100 in the second hour.
+    netCDF::NcFile file(grid_path, netCDF::NcFile::replace);
+    const auto time = file.addDim("time", 2);
+    const auto lat  = file.addDim("lat", 3);
+    const auto lon  = file.addDim("lon", 4);
+
+    const std::vector<double> times = { 0, 1 };
+    auto time_var = file.addVar("time", netCDF::ncDouble, time);
+    time_var.putAtt("units", "hours since 2015-12-01 00:00:00");
+    time_var.putVar(times.data());
+
+    const std::vector<double> lats = { 2.5, 1.5, 0.5 };
+    file.addVar("lat", netCDF::ncDouble, lat).putVar(lats.data());
+
+    const std::vector<double> lons = { 0.5, 1.5, 2.5, 3.5 };
+    file.addVar("lon", netCDF::ncDouble, lon).putVar(lons.data());
+
+    std::vector<double> values;
+    for (int t = 0; t < 2; t++) {
+        for (int row = 2; row >= 0; row--) {
+            for (int column = 0; column < 4; column++) {
+                values.push_back(100 * t + 10 * row + column);
+            }
+        }
+    }
+    auto t2d = file.addVar("T2D", netCDF::ncDouble, { time, lat, lon });
+    t2d.putAtt("units", "K");
+    t2d.putVar(values.data());
+    file.close();
+
+    std::ofstream geometry(geometry_path);
+    geometry << R"({
+        "type": "FeatureCollection",
+        "features": [
+            {
+                "type": "Feature",
+                "id": "cat-1",
+                "properties": {},
+                "geometry": { "type": "Polygon", "coordinates": [[[0, 0], [2, 0], [2, 1], [0, 1], [0, 0]]] }
+            },
+            {
+                "type": "Feature",
+                "id": "cat-2",
+                "properties": {},
+                "geometry": { "type": "Polygon", "coordinates": [[[1.5, 1], [3, 1], [3, 2.5], [1.5, 2.5], [1.5, 1]]] }
+            }
+        ]
+    })";
+#endif
+}
+
+void NetCDFGriddedDataProviderTest::TearDown()
+{
+#if NGEN_WITH_NETCDF
+    data_access::NetCDFGriddedDataProvider::cleanup_shared_providers();
+#endif
+    unlink(grid_path.c_str());
+    unlink(geometry_path.c_str());
+}
+
+TEST_F(NetCDFGriddedDataProviderTest, AreaWeightedMeans)
+{
+#if !NGEN_WITH_NETCDF
+    GTEST_SKIP() << "NetCDF is not available";
+#else
+    auto provider = data_access::NetCDFGriddedDataProvider::get_shared_provider(
+        grid_path, geometry_path, start_time, start_time + 7200, utils::getStdErr()
+    );
+    ASSERT_EQ(provider->get_ids(), std::vector<std::string>({ "cat-1", "cat-2" }));
+    ASSERT_EQ(provider->record_duration(), 3600);
+
+    // cat-1 covers the two south-western cells whole
+    CatchmentAggrDataSelector selector("cat-1", "T2D", start_time, 3600, "K");
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), 0.5);
+
+    // cat-2 covers half of cell (1, 1), all of (2, 1), a quarter of (1, 2) and half of (2, 2):
+    // (0.5 * 11 + 12 + 0.25 * 21 + 0.5 * 22) / 2.25
+    selector = CatchmentAggrDataSelector("cat-2", "T2D", start_time, 3600, "K");
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), 15.0);
+
+    selector = CatchmentAggrDataSelector("cat-2", "T2D", start_time + 3600, 3600, "K");
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), 115.0);
+
+    selector = CatchmentAggrDataSelector("cat-3", "T2D", start_time, 3600, "K");
+    EXPECT_THROW(provider->get_value(selector, data_access::MEAN), std::out_of_range);
+#endif
+}
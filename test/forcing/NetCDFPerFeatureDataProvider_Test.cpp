@@ -114,4 +114,26 @@ TEST_F(NetCDFPerFeatureDataProviderTest, TestForcingDataRead)
         std::runtime_error);
     
 }
+
+TEST_F(NetCDFPerFeatureDataProviderTest, TestBatchValues)
+{
+    auto start_time = nc_provider->get_data_start_time();
+    auto duration = nc_provider->record_duration();
+    auto ids = nc_provider->get_ids();
+
+    std::vector<std::string> batch_ids(ids.rbegin(), ids.rend());
+    auto batch = nc_provider->get_batch(batch_ids);
+    std::vector<double> values(batch_ids.size());
+
+    // read 2.5 time steps, not aligned with the data
+    CatchmentAggrDataSelector selector("", CSDMS_STD_NAME_SURFACE_TEMP, start_time + duration / 2, duration * 5 / 2, "K");
+    nc_provider->get_batch_values(batch, selector, values, data_access::MEAN);
+
+    for (size_t i = 0; i < batch_ids.size(); ++i) {
+        selector.set_id(batch_ids[i]);
+        EXPECT_EQ(values[i], nc_provider->get_value(selector, data_access::MEAN));
+    }
+
+    EXPECT_THROW(nc_provider->get_batch({"cat-0"}), std::out_of_range);
+}
 #endif
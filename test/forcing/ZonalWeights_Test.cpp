@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <forcing/ZonalWeights.hpp>
+
+namespace {
+
+geojson::multipolygon_t make_zone(const std::string& wkt)
+{
+    geojson::multipolygon_t zone;
+    boost::geometry::read_wkt(wkt, zone);
+    return zone;
+}
+
+//! Weights of one zone, by (column, row)
+std::map<std::pair<std::uint64_t, std::uint64_t>, double> zone_cells(
+    const data_access::ZonalWeights& weights,
+    std::size_t zone,
+    std::uint64_t columns
+)
+{
+    std::map<std::pair<std::uint64_t, std::uint64_t>, double> cells;
+    const auto indices = weights.cells(zone);
+    const auto values  = weights.weights(zone);
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        cells[{ indices[i] % columns, indices[i] / columns }] = values[i];
+    }
+    return cells;
+}
+
+// A 10x10 grid of unit cells with extent [0, 10] in both x and y
+const GridSpecification unit_grid{ 10, 10, box_t{ { 0, 0 }, { 10, 10 } } };
+
+} // namespace
+
+TEST(ZonalWeightsTest, AlignedSquareCoversWholeCells)
+{
+    const auto weights = data_access::compute_zonal_weights(unit_grid, {
+        make_zone("MULTIPOLYGON(((2 2,2 4,4 4,4 2,2 2)))")
+    });
+
+    ASSERT_EQ(weights.zones(), 1);
+    const auto cells = zone_cells(weights, 0, unit_grid.columns);
+    ASSERT_EQ(cells.size(), 4);
+    for (const auto& cell : cells) {
+        EXPECT_GE(cell.first.first, 2);
+        EXPECT_LE(cell.first.first, 3);
+        EXPECT_GE(cell.first.second, 2);
+        EXPECT_LE(cell.first.second, 3);
+        EXPECT_DOUBLE_EQ(cell.second, 1.0);
+    }
+}
+
+TEST(ZonalWeightsTest, PartialCoverage)
+{
+    // Counter-clockwise, as GeoJSON winds outer rings
+    const auto weights = data_access::compute_zonal_weights(unit_grid, {
+        make_zone("MULTIPOLYGON(((0 0,2 0,0 2,0 0)))")
+    });
+
+    const auto cells = zone_cells(weights, 0, unit_grid.columns);
+    ASSERT_EQ(cells.size(), 3);
+    EXPECT_DOUBLE_EQ(cells.at({ 0, 0 }), 1.0);
+    EXPECT_DOUBLE_EQ(cells.at({ 1, 0 }), 0.5);
+    EXPECT_DOUBLE_EQ(cells.at({ 0, 1 }), 0.5);
+}
+
+TEST(ZonalWeightsTest, HolesPartsAndGridEdges)
+{
+    // A grid of 0.5 by 0.25 cells, offset from the origin
+    const GridSpecification grid{ 8, 4, box_t{ { 10, 20 }, { 12, 22 } } };
+
+    const auto weights = data_access::compute_zonal_weights(grid, {
+        // A square with a square hole, and a second part in the corner of the grid
+        make_zone("MULTIPOLYGON(((10 20,10 21,11 21,11 20,10 20),(10.25 20.25,10.75 20.25,10.75 20.75,10.25 20.75,10.25 20.25)),"
+                  "((11.5 21.5,11.5 22,12 22,12 21.5,11.5 21.5)))"),
+        // Half outside the grid
+        make_zone("MULTIPOLYGON(((11 21,11 23,13 23,13 21,11 21)))"),
+        // Entirely outside the grid
+        make_zone("MULTIPOLYGON(((0 0,0 1,1 1,1 0,0 0)))")
+    });
+
+    ASSERT_EQ(weights.zones(), 3);
+
+    const auto covered_area = [&](std::size_t zone) {
+        double total = 0;
+        for (double weight : weights.weights(zone)) {
+            total += weight;
+        }
+        return total * 0.5 * 0.25;
+    };
+
+    EXPECT_NEAR(covered_area(0), (1.0 - 0.25) + 0.25, 1e-12);
+    const auto cells = zone_cells(weights, 0, grid.columns);
+    EXPECT_DOUBLE_EQ(cells.at({ 0, 0 }), 1.0);
+    EXPECT_DOUBLE_EQ(cells.at({ 0, 1 }), 0.5);
+    EXPECT_DOUBLE_EQ(cells.at({ 1, 2 }), 0.5);
+    EXPECT_DOUBLE_EQ(cells.at({ 3, 7 }), 1.0);
+    EXPECT_EQ(cells.count({ 2, 7 }), 0);
+
+    EXPECT_NEAR(covered_area(1), 1.0, 1e-12);
+    EXPECT_EQ(weights.cells(2).size(), 0);
+}
+
+TEST(ZonalWeightsTest, MeansSkipMissingCells)
+{
+    const auto weights = data_access::compute_zonal_weights(unit_grid, {
+        make_zone("MULTIPOLYGON(((0 0,2 0,0 2,0 0)))"),
+        make_zone("MULTIPOLYGON(((5 5,5 6,6 6,6 5,5 5)))"),
+        make_zone("MULTIPOLYGON(((20 20,20 21,21 21,21 20,20 20)))")
+    });
+
+    std::vector<double> grid(unit_grid.rows * unit_grid.columns);
+    for (std::size_t i = 0; i < grid.size(); i++) {
+        grid[i] = static_cast<double>(i);
+    }
+
+    std::vector<double> means(weights.zones());
+    weights.apply(grid, means);
+
+    // Cells 0, 1 and 10, weighted 1, 0.5 and 0.5
+    EXPECT_DOUBLE_EQ(means[0], (0.0 + 0.5 * 1.0 + 0.5 * 10.0) / 2.0);
+    EXPECT_DOUBLE_EQ(means[1], 55.0);
+    EXPECT_TRUE(std::isnan(means[2]));
+
+    grid[10] = NAN;
+    grid[55] = NAN;
+    weights.apply(grid, means);
+    EXPECT_DOUBLE_EQ(means[0], (0.0 + 0.5 * 1.0) / 1.5);
+    EXPECT_TRUE(std::isnan(means[1]));
+}
@@ -332,3 +332,214 @@ TEST_F(FeatureCollection_Test, copy_filter_test) {
 
     ASSERT_EQ(visitor.get(0), "LineStringFeature");
 }
+
+TEST_F(FeatureCollection_Test, stream_matches_ptree_test) {
+    std::string data = "{ "
+        "\"type\": \"FeatureCollection\", "
+        "\"name\": \"catchments\", "
+        "\"features\": [ "
+            "{ "
+                "\"type\": \"Feature\", "
+                "\"properties\": { \"id\": \"cat-1\", \"area\": 12.5, \"order\": 3, \"outlet\": true, \"name\": \"Caf\\u00e9\", \"empty\": \"\", \"list\": [1, 2], \"nested\": { \"a\": \"b\" } }, "
+                "\"geometry\": { "
+                    "\"type\": \"Polygon\", "
+                    "\"coordinates\": [ "
+                        "[ [0.0, 0.0], [10.0, 0.0], [10.0, 10.0], [0.0, 10.0], [0.0, 0.0] ], "
+                        "[ [2.0, 2.0], [2.0, 4.0], [4.0, 4.0], [4.0, 2.0], [2.0, 2.0] ] "
+                    "] "
+                "} "
+            "}, "
+            "{ "
+                "\"type\": \"Feature\", "
+                "\"id\": \"nex-1\", "
+                "\"bbox\": [1, 2, 3, 4], "
+                "\"geometry\": { \"type\": \"MultiPoint\", \"coordinates\": [ [1.0, 2.0, 100.0], [3.0, 4.0] ] } "
+            "}, "
+            "{ "
+                "\"type\": \"Feature\", "
+                "\"id\": \"line-1\", "
+                "\"geometry\": { \"coordinates\": [ [ [0, 0], [1, 1] ], [ [2, 2], [3, 3], [4, 4] ] ], \"type\": \"MultiLineString\" } "
+            "}, "
+            "{ "
+                "\"type\": \"Feature\", "
+                "\"id\": \"poly-1\", "
+                "\"geometry\": { \"type\": \"MultiPolygon\", \"coordinates\": [ [ [ [0, 0], [1, 0], [1, 1], [0, 0] ] ], [ [ [5, 5], [6, 5], [6, 6], [5, 5] ] ] ] } "
+            "} "
+        "] "
+        "}";
+
+    std::stringstream ptree_stream;
+    ptree_stream << data;
+    boost::property_tree::ptree tree;
+    boost::property_tree::json_parser::read_json(ptree_stream, tree);
+    geojson::GeoJSON expected = geojson::build_collection(tree);
+
+    std::stringstream stream;
+    stream << data;
+    geojson::GeoJSON collection = geojson::read(stream);
+
+    ASSERT_EQ(collection->get_size(), expected->get_size());
+    ASSERT_EQ(collection->get_bounding_box(), expected->get_bounding_box());
+
+    for (int i = 0; i < expected->get_size(); i++) {
+        geojson::Feature feature = collection->get_feature(i);
+        geojson::Feature expected_feature = expected->get_feature(i);
+
+        ASSERT_EQ(feature->get_id(), expected_feature->get_id());
+        ASSERT_EQ(feature->get_type(), expected_feature->get_type());
+        ASSERT_EQ(feature->get_bounding_box(), expected_feature->get_bounding_box());
+        ASSERT_EQ(feature->keys(), expected_feature->keys());
+        ASSERT_EQ(feature->property_keys(), expected_feature->property_keys());
+        for (const std::string& key : expected_feature->property_keys()) {
+            const geojson::JSONProperty& property = feature->get_property(key);
+            const geojson::JSONProperty& expected_property = expected_feature->get_property(key);
+            ASSERT_EQ(property.get_type(), expected_property.get_type()) << key;
+            if (property.get_type() == geojson::PropertyType::Object) {
+                ASSERT_EQ(property.get_values().at("a").as_string(), expected_property.get_values().at("a").as_string());
+            }
+            else {
+                ASSERT_EQ(property, expected_property) << key;
+            }
+        }
+        ASSERT_EQ(collection->get_feature(feature->get_id()), feature);
+    }
+
+    ASSERT_TRUE(bg::equals(
+        collection->get_feature(0)->geometry<geojson::polygon_t>(),
+        expected->get_feature(0)->geometry<geojson::polygon_t>()
+    ));
+    ASSERT_EQ(collection->get_feature(0)->geometry<geojson::polygon_t>().inners().size(), 1);
+    ASSERT_EQ(collection->get_feature(0)->get_property("name").as_string(), "Caf\xc3\xa9");
+    ASSERT_TRUE(bg::equals(
+        collection->get_feature(1)->geometry<geojson::multipoint_t>(),
+        expected->get_feature(1)->geometry<geojson::multipoint_t>()
+    ));
+    ASSERT_TRUE(bg::equals(
+        collection->get_feature(2)->geometry<geojson::multilinestring_t>(),
+        expected->get_feature(2)->geometry<geojson::multilinestring_t>()
+    ));
+    ASSERT_EQ(
+        collection->get_feature(3)->geometry<geojson::multipolygon_t>().size(),
+        expected->get_feature(3)->geometry<geojson::multipolygon_t>().size()
+    );
+}
+
+TEST_F(FeatureCollection_Test, stream_subset_without_geometry_test) {
+    // Ids are given both as members and, after the geometry, as properties
+    std::string data = "{ "
+        "\"type\": \"FeatureCollection\", "
+        "\"features\": [ "
+            "{ \"type\": \"Feature\", \"id\": \"First\", \"geometry\": { \"type\": \"Point\", \"coordinates\": [102.0, 0.5] } }, "
+            "{ \"type\": \"Feature\", \"geometry\": { \"type\": \"Point\", \"coordinates\": [103.0, 1.5] }, \"properties\": { \"id\": \"Second\", \"toid\": \"nex-2\" } }, "
+            "{ \"type\": \"Feature\", \"geometry\": null, \"properties\": { \"id\": \"Third\" } } "
+        "] "
+        "}";
+
+    std::stringstream stream;
+    stream << data;
+    std::vector<std::string> subset = {"Second", "Third", "Missing"};
+
+    geojson::GeoJSON collection = geojson::read(stream, subset, false);
+
+    ASSERT_EQ(2, collection->get_size());
+    ASSERT_EQ(collection->get_feature("First"), nullptr);
+
+    geojson::Feature second = collection->get_feature("Second");
+    ASSERT_NE(second, nullptr);
+    ASSERT_EQ(second->get_id(), "Second");
+    ASSERT_EQ(second->get_type(), geojson::FeatureType::GeometryCollection);
+    ASSERT_TRUE(second->get_geometry_collection().empty());
+    ASSERT_EQ(second->get_property("toid").as_string(), "nex-2");
+
+    // A null geometry is read as an empty collection even when geometry is wanted
+    stream.clear();
+    stream.str(data);
+    collection = geojson::read(stream);
+    ASSERT_EQ(3, collection->get_size());
+    ASSERT_EQ(collection->get_feature("Second")->get_type(), geojson::FeatureType::Point);
+    ASSERT_EQ(collection->get_feature("Third")->get_type(), geojson::FeatureType::GeometryCollection);
+}
+
+TEST_F(FeatureCollection_Test, stream_malformed_test) {
+    std::vector<std::string> documents = {
+        "{ \"type\": \"FeatureCollection\", \"features\": [ ",
+        "{ \"type\": \"FeatureCollection\", \"features\": [ { \"id\": \"First\" } ] } trailing",
+        "{ \"type\": \"FeatureCollection\", \"features\": [ { \"id\": First } ] }",
+        "{ \"type\": \"FeatureCollection\" \"features\": [] }"
+    };
+
+    for (const std::string& document : documents) {
+        std::stringstream stream;
+        stream << document;
+        ASSERT_THROW(geojson::read(stream), boost::property_tree::json_parser::json_parser_error) << document;
+    }
+}
+
+TEST_F(FeatureCollection_Test, columnar_properties_test) {
+    // "area" changes type part way through, and "extra" is only present on one feature
+    std::string data = "{ "
+        "\"type\": \"FeatureCollection\", "
+        "\"features\": [ "
+            "{ \"type\": \"Feature\", \"id\": \"First\", \"geometry\": null, "
+                "\"properties\": { \"area\": 1.5, \"layer\": 3, \"outlet\": true, \"toid\": \"nex-1\" } }, "
+            "{ \"type\": \"Feature\", \"id\": \"Second\", \"geometry\": null, "
+                "\"properties\": { \"area\": 2, \"layer\": 4, \"outlet\": false, \"toid\": \"nex-2\", \"extra\": [1, 2] } } "
+        "] "
+        "}";
+
+    std::stringstream stream;
+    stream << data;
+    geojson::GeoJSON collection = geojson::read(stream);
+
+    const geojson::PropertyTable* table = collection->get_property_table();
+    ASSERT_NE(table, nullptr);
+    ASSERT_EQ(table->size(), 2);
+
+    geojson::Feature first = collection->get_feature("First");
+    geojson::Feature second = collection->get_feature("Second");
+    ASSERT_EQ(first->get_property_table(), table);
+    ASSERT_EQ(second->get_property_table(), table);
+
+    ASSERT_EQ(first->property_keys(), std::vector<std::string>({"area", "layer", "outlet", "toid"}));
+    ASSERT_EQ(second->property_keys(), std::vector<std::string>({"area", "extra", "layer", "outlet", "toid"}));
+    ASSERT_TRUE(second->has_property("extra"));
+    ASSERT_FALSE(first->has_property("extra"));
+    ASSERT_THROW(first->get_property("extra"), std::invalid_argument);
+    ASSERT_THROW(first->get_property("missing"), std::invalid_argument);
+
+    ASSERT_EQ(first->get_property("area").get_type(), geojson::PropertyType::Real);
+    ASSERT_EQ(first->get_property("area").as_real_number(), 1.5);
+    ASSERT_EQ(second->get_property("area").get_type(), geojson::PropertyType::Natural);
+    ASSERT_EQ(second->get_property("area").as_natural_number(), 2);
+    ASSERT_EQ(second->get_property("outlet").get_type(), geojson::PropertyType::Boolean);
+    ASSERT_FALSE(second->get_property("outlet").as_boolean());
+    ASSERT_EQ(second->get_property("toid").get_type(), geojson::PropertyType::String);
+    ASSERT_EQ(second->get_property("toid").as_string(), "nex-2");
+    ASSERT_EQ(second->get_property("extra").as_natural_vector(), std::vector<long>({1, 2}));
+
+    // Columns can be scanned directly by row
+    const geojson::PropertyColumn* layer = table->column("layer");
+    ASSERT_NE(layer, nullptr);
+    ASSERT_EQ(layer->get_type(), geojson::PropertyType::Natural);
+    ASSERT_TRUE(layer->is_typed(second->get_property_row()));
+    ASSERT_EQ(layer->natural(second->get_property_row()), 4);
+
+    const geojson::PropertyColumn* area = table->column("area");
+    ASSERT_TRUE(area->is_typed(first->get_property_row()));
+    ASSERT_FALSE(area->is_typed(second->get_property_row()));
+    ASSERT_TRUE(area->has(second->get_property_row()));
+
+    // Reading the full property map through a const feature leaves it in the table
+    const geojson::FeatureBase& const_second = *second;
+    geojson::PropertyMap copied = const_second.get_properties();
+    ASSERT_EQ(second->get_property_table(), table);
+    ASSERT_EQ(copied.size(), 5);
+    ASSERT_EQ(copied.at("layer").as_natural_number(), 4);
+
+    // Asking for the modifiable property map gives the feature its own copy again
+    geojson::PropertyMap& properties = second->get_properties();
+    ASSERT_EQ(second->get_property_table(), nullptr);
+    ASSERT_EQ(properties.size(), 5);
+    ASSERT_EQ(properties.at("toid").as_string(), "nex-2");
+    ASSERT_EQ(second->get_property("layer").as_natural_number(), 4);
+}
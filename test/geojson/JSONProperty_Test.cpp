@@ -383,3 +383,29 @@ TEST_F(JSONProperty_Test, test_as_vector_mixed_list_0a){
     ASSERT_EQ(vec2, test_list_str);
 
 }
+
+TEST_F(JSONProperty_Test, test_move_and_assign){
+    std::vector<geojson::JSONProperty> properties = {geojson::JSONProperty("", 1.5), geojson::JSONProperty("", 2.5)};
+    geojson::JSONProperty list_property("list", properties);
+    geojson::PropertyMap map = {{"a", geojson::JSONProperty("a", 3.0)}};
+    geojson::JSONProperty object_property("object", std::move(map));
+
+    // Nested values must stay reachable once the original is gone
+    geojson::JSONProperty moved_list(std::move(list_property));
+    std::vector<double> vec;
+    moved_list.as_vector(vec);
+    ASSERT_EQ(vec, std::vector<double>({1.5, 2.5}));
+
+    geojson::JSONProperty assigned("assigned", 0);
+    assigned = geojson::JSONProperty("object", std::move(object_property));
+    ASSERT_EQ(assigned.get_type(), geojson::PropertyType::Object);
+    ASSERT_EQ(assigned.at("a").as_real_number(), 3.0);
+
+    {
+        geojson::JSONProperty copied_list("copy", std::vector<geojson::JSONProperty>{geojson::JSONProperty("", 4.5)});
+        assigned = copied_list;
+    }
+    vec.clear();
+    assigned.as_vector(vec);
+    ASSERT_EQ(vec, std::vector<double>({4.5}));
+}
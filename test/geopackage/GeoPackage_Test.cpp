@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 
 #include "geopackage.hpp"
+#include "proj.hpp"
 #include "FileChecker.h"
 
 class GeoPackage_Test : public ::testing::Test
@@ -73,6 +74,12 @@ TEST_F(GeoPackage_Test, geopackage_idsubset_test)
     EXPECT_EQ(point.get<1>(), 0.5);
 
     ASSERT_TRUE(gpkg->get_feature(1) == nullptr);
+
+    // duplicate and missing IDs in the subset are ignored
+    const auto subset = ngen::geopackage::read(this->path, "test", { "Second", "Missing", "Second", "First" });
+    EXPECT_EQ(2, subset->get_size());
+    EXPECT_EQ(subset->get_feature(0)->get_id(), "First");
+    EXPECT_EQ(subset->get_feature(1)->get_id(), "Second");
 }
 
 // this test is essentially the same as the above, however, the coordinates
@@ -100,3 +107,33 @@ TEST_F(GeoPackage_Test, geopackage_projection_test)
 
     ASSERT_TRUE(third == nullptr);
 }
+
+TEST_F(GeoPackage_Test, geopackage_attributes_only_test)
+{
+    const auto gpkg = ngen::geopackage::read(this->path, "test", {}, false);
+    EXPECT_NE(gpkg->find("First"), -1);
+    EXPECT_NE(gpkg->find("Second"), -1);
+    EXPECT_EQ(2, gpkg->get_size());
+    EXPECT_TRUE(gpkg->get_bounding_box().empty());
+
+    const auto& first = gpkg->get_feature(0);
+    EXPECT_EQ(first->get_id(), "First");
+    EXPECT_EQ(first->get_property("id").as_string(), "First");
+    EXPECT_FALSE(first->has_property("geom"));
+    EXPECT_EQ(first->get_type(), geojson::FeatureType::GeometryCollection);
+    EXPECT_TRUE(first->get_geometry_collection().empty());
+    EXPECT_TRUE(first->get_bounding_box().empty());
+
+    const auto subset = ngen::geopackage::read(this->path, "test", { "Second" }, false);
+    EXPECT_EQ(1, subset->get_size());
+    EXPECT_EQ(subset->get_feature(0)->get_id(), "Second");
+}
+
+TEST_F(GeoPackage_Test, geopackage_projection_cache_test)
+{
+    const auto& first  = ngen::srs::epsg::to_wgs84(ngen::srs::epsg::mercator);
+    const auto& second = ngen::srs::epsg::to_wgs84(ngen::srs::epsg::mercator);
+    EXPECT_EQ(&first, &second);
+    EXPECT_NE(&first, &ngen::srs::epsg::to_wgs84(ngen::srs::epsg::conus_albers));
+    EXPECT_THROW(ngen::srs::epsg::to_wgs84(1234), std::runtime_error);
+}
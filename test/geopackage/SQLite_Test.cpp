@@ -112,3 +112,27 @@ TEST_F(SQLite_Test, sqlite_query_test)
     EXPECT_TRUE(iter.done());
     EXPECT_EQ(iter.current_row(), 1);
 }
+
+TEST_F(SQLite_Test, sqlite_execute_many_test)
+{
+    ngen::sqlite::database db {this->path};
+
+    // temporary tables are writable even though the database is opened read-only
+    ASSERT_NO_THROW(db.execute("CREATE TEMP TABLE subset (id TEXT PRIMARY KEY)"));
+
+    const std::vector<std::string> values = { "a", "b", "c", "b" };
+    ASSERT_NO_THROW(db.execute_many("INSERT OR IGNORE INTO temp.subset VALUES (?)", values));
+
+    auto iter = db.query("SELECT COUNT(*) FROM temp.subset");
+    iter.next();
+    EXPECT_EQ(iter.get<int>(0), 3);
+
+    // a failing insert rolls back the whole batch
+    EXPECT_THROW(db.execute_many("INSERT INTO temp.subset VALUES (?)", std::vector<std::string>{ "d", "a" }), ngen::sqlite::sqlite_error);
+
+    auto after = db.query("SELECT COUNT(*) FROM temp.subset");
+    after.next();
+    EXPECT_EQ(after.get<int>(0), 3);
+
+    EXPECT_THROW(db.execute("NOT A STATEMENT"), ngen::sqlite::sqlite_error);
+}
@@ -0,0 +1,124 @@
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "FeatureBuilder.hpp"
+#include "hydrofabric.hpp"
+
+class Hydrofabric_Test : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        std::stringstream nexus_data;
+        nexus_data << "{ \"type\": \"FeatureCollection\", \"features\": [ "
+            "{ \"type\": \"Feature\", \"id\": \"nex-1\", \"properties\": { \"toid\": \"cat-2\" }, \"geometry\": { \"type\": \"Point\", \"coordinates\": [0.0, 0.0] } }, "
+            "{ \"type\": \"Feature\", \"id\": \"nex-2\", \"properties\": { \"toid\": \"\" }, \"geometry\": { \"type\": \"Point\", \"coordinates\": [1.0, 1.0] } } "
+        "] }";
+
+        std::stringstream catchment_data;
+        catchment_data << "{ \"type\": \"FeatureCollection\", \"features\": [ "
+            "{ \"type\": \"Feature\", \"id\": \"cat-1\", \"layer\": 1, "
+                "\"properties\": { \"toid\": \"nex-1\", \"areasqkm\": 12.5, \"order\": -3, \"outlet\": false, \"code\": \"A-007\", "
+                    "\"weights\": [0.25, 0.75], \"params\": { \"b\": 4.05, \"name\": \"soil\" } } }, "
+            "{ \"type\": \"Feature\", \"id\": \"cat-2\", "
+                "\"properties\": { \"toid\": \"nex-2\", \"areasqkm\": 3.0 } } "
+        "] }";
+
+        fabric.nexuses    = geojson::read(nexus_data);
+        fabric.catchments = geojson::read(catchment_data);
+    }
+
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    //! Destination ids of a feature
+    static std::vector<std::string> destinations(const geojson::Feature& feature)
+    {
+        std::vector<std::string> ids;
+        for (const auto* destination : feature->destination_features()) {
+            ids.push_back(destination->get_id());
+        }
+        return ids;
+    }
+
+    const std::string path = "Hydrofabric_Test.ngenfab";
+    ngen::hydrofabric::collections fabric;
+};
+
+TEST_F(Hydrofabric_Test, compile_load_test)
+{
+    ASSERT_TRUE(ngen::hydrofabric::is_compiled(path));
+    ASSERT_FALSE(ngen::hydrofabric::is_compiled("catchment_data.geojson"));
+
+    ngen::hydrofabric::compile(fabric, path);
+    auto loaded = ngen::hydrofabric::load(path);
+
+    ASSERT_EQ(loaded.nexuses->get_size(), 2);
+    ASSERT_EQ(loaded.catchments->get_size(), 2);
+
+    auto cat = loaded.catchments->get_feature("cat-1");
+    ASSERT_NE(cat, nullptr);
+    ASSERT_EQ(cat->get_property("toid").as_string(), "nex-1");
+    ASSERT_EQ(cat->get_property("areasqkm").get_type(), geojson::PropertyType::Real);
+    ASSERT_EQ(cat->get_property("areasqkm").as_real_number(), 12.5);
+    ASSERT_EQ(cat->get_property("order").as_natural_number(), -3);
+    ASSERT_EQ(cat->get_property("outlet").get_type(), geojson::PropertyType::Boolean);
+    ASSERT_FALSE(cat->get_property("outlet").as_boolean());
+    ASSERT_EQ(cat->get_property("code").get_type(), geojson::PropertyType::String);
+    ASSERT_EQ(cat->get_property("code").as_string(), "A-007");
+    ASSERT_EQ(cat->get_property("weights").as_real_vector(), std::vector<double>({0.25, 0.75}));
+    ASSERT_EQ(cat->get_property("params").at("b").as_real_number(), 4.05);
+    ASSERT_EQ(cat->get_property("params").at("name").as_string(), "soil");
+    ASSERT_TRUE(cat->has_key("layer"));
+    ASSERT_EQ(cat->get("layer").as_natural_number(), 1);
+
+    // Topology is restored without re-linking
+    ASSERT_EQ(destinations(cat), std::vector<std::string>({"nex-1"}));
+    ASSERT_EQ(destinations(loaded.nexuses->get_feature("nex-1")), std::vector<std::string>({"cat-2"}));
+    ASSERT_EQ(destinations(loaded.catchments->get_feature("cat-2")), std::vector<std::string>({"nex-2"}));
+    ASSERT_TRUE(destinations(loaded.nexuses->get_feature("nex-2")).empty());
+    ASSERT_EQ(loaded.nexuses->get_feature("nex-1")->origination_features().size(), 1);
+}
+
+TEST_F(Hydrofabric_Test, subset_test)
+{
+    ngen::hydrofabric::compile(fabric, path);
+    auto loaded = ngen::hydrofabric::load(path, {"cat-1"}, {"nex-1", "nex-missing"});
+
+    ASSERT_EQ(loaded.catchments->get_size(), 1);
+    ASSERT_EQ(loaded.nexuses->get_size(), 1);
+    ASSERT_EQ(loaded.catchments->get_feature("cat-2"), nullptr);
+
+    // Links to features outside the subset are dropped
+    ASSERT_EQ(destinations(loaded.catchments->get_feature("cat-1")), std::vector<std::string>({"nex-1"}));
+    ASSERT_TRUE(destinations(loaded.nexuses->get_feature("nex-1")).empty());
+}
+
+TEST_F(Hydrofabric_Test, invalid_file_test)
+{
+    ASSERT_THROW(ngen::hydrofabric::load("does_not_exist.ngenfab"), std::runtime_error);
+
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output << "{ \"type\": \"FeatureCollection\", \"features\": [] }";
+    }
+    ASSERT_THROW(ngen::hydrofabric::load(path), std::runtime_error);
+
+    // A truncated file is rejected before any records are read
+    ngen::hydrofabric::compile(fabric, path);
+    std::string contents;
+    {
+        std::ifstream input(path, std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        output.write(contents.data(), contents.size() - 4);
+    }
+    ASSERT_THROW(ngen::hydrofabric::load(path), std::runtime_error);
+}
@@ -745,6 +745,44 @@ TEST_F(Formulation_Manager_Test, basic_reading_2) {
     ASSERT_EQ(manager.get_output_root(), "./output_dir/");
 }
 
+TEST_F(Formulation_Manager_Test, parallel_reading_1) {
+    // The same formulations are built whether they are constructed serially or on several threads
+    std::map<std::string, std::vector<double>> responses[2];
+    const std::string init_threads[2] = {"1", "4"};
+
+    std::ostream* raw_pointer = &std::cout;
+    std::shared_ptr<std::ostream> s_ptr(raw_pointer, [](void*) {});
+    utils::StreamHandler catchment_output(s_ptr);
+
+    for (int run = 0; run < 2; run++) {
+        std::string config = fix_paths(EXAMPLE_1);
+        config.replace(config.rfind('}'), 1, ", \"init_threads\": " + init_threads[run] + " }");
+
+        std::stringstream stream;
+        stream << config;
+
+        realization::Formulation_Manager manager = realization::Formulation_Manager(stream);
+
+        // cat-27 has no catchment configuration, so it is built from the global one
+        this->fabric = std::make_shared<geojson::FeatureCollection>();
+        this->add_feature("cat-52");
+        this->add_feature("cat-67");
+        this->add_feature("cat-27");
+        manager.read(this->fabric, catchment_output);
+
+        ASSERT_EQ(manager.get_size(), 3);
+
+        for (const auto& formulation : manager) {
+            for (long t = 0; t < 4; t++) {
+                responses[run][formulation.first].push_back(formulation.second->get_response(t, 3600.0));
+            }
+        }
+    }
+
+    ASSERT_EQ(responses[0].size(), 3);
+    ASSERT_EQ(responses[0], responses[1]);
+}
+
 TEST_F(Formulation_Manager_Test, basic_run_1) {
     std::stringstream stream;
     stream << fix_paths(EXAMPLE_1);
@@ -975,3 +1013,162 @@ TEST_F(Formulation_Manager_Test, read_external_attributes) {
     check_formulation_values(manager, "cat-27",    { 3.00000, 18.0 });
     check_formulation_values(manager, "cat-67", { 7.41722, 9231 });
 }
+
+/**
+ * Formulation::link_external as it was before FormulationTemplate, kept as the
+ * reference that the template's parameters are checked against.
+ */
+static void reference_link_external(realization::config::Formulation& formulation, geojson::Feature feature)
+{
+    if (formulation.type == "bmi_multi") {
+        std::vector<geojson::JSONProperty> tmp;
+        for (auto& n : formulation.nested) {
+            if (n.parameters.count("model_params")) {
+                reference_link_external(n, feature);
+            }
+            geojson::PropertyMap map = {};
+            map.emplace("name", geojson::JSONProperty("name", n.type));
+            map.emplace("params", geojson::JSONProperty("", n.parameters));
+            tmp.push_back(geojson::JSONProperty("", map));
+        }
+        formulation.parameters.at("modules") = geojson::JSONProperty("modules", tmp);
+        return;
+    }
+    if (formulation.parameters.count("model_params") < 1) {
+        return;
+    }
+    geojson::PropertyMap attr = formulation.parameters.at("model_params").get_values();
+    for (decltype(auto) param : attr) {
+        if (param.second.get_type() != geojson::PropertyType::Object || !param.second.has_key("source")) {
+            continue;
+        }
+        decltype(auto) param_name = param.second.has_key("from") ? param.second.at("from").as_string() : param.first;
+        if (feature->has_property(param_name)) {
+            auto catchment_attribute = feature->get_property(param_name);
+            switch (catchment_attribute.get_type()) {
+                case geojson::PropertyType::List:
+                case geojson::PropertyType::Object:
+                    break;
+                default:
+                    attr.at(param.first) = geojson::JSONProperty(param.first, catchment_attribute);
+            }
+        }
+    }
+    formulation.parameters.at("model_params") = geojson::JSONProperty("model_params", attr);
+}
+
+/**
+ * Expect two properties to have the same type and value, comparing Objects and Lists
+ * by their contents, since JSONProperty::operator== only matches an Object with itself.
+ */
+static void expect_same_property(const geojson::JSONProperty& actual, const geojson::JSONProperty& expected, const std::string& path)
+{
+    ASSERT_EQ(actual.get_type(), expected.get_type()) << path;
+    switch (expected.get_type()) {
+        case geojson::PropertyType::Object: {
+            ASSERT_EQ(actual.keys().size(), expected.keys().size()) << path;
+            for (const auto& key : expected.keys()) {
+                ASSERT_TRUE(actual.has_key(key)) << path << "." << key;
+                expect_same_property(actual.at(key), expected.at(key), path + "." + key);
+            }
+            break;
+        }
+        case geojson::PropertyType::List: {
+            const auto actual_list = actual.as_list();
+            const auto expected_list = expected.as_list();
+            ASSERT_EQ(actual_list.size(), expected_list.size()) << path;
+            for (std::size_t i = 0; i < expected_list.size(); i++) {
+                expect_same_property(actual_list[i], expected_list[i], path + "[" + std::to_string(i) + "]");
+            }
+            break;
+        }
+        default:
+            EXPECT_EQ(actual, expected) << path;
+    }
+}
+
+static void expect_same_parameters(geojson::PropertyMap actual, geojson::PropertyMap expected, const std::string& name)
+{
+    expect_same_property(geojson::JSONProperty("", actual), geojson::JSONProperty("", expected), name);
+}
+
+TEST_F(Formulation_Manager_Test, formulation_template_matches_link_external) {
+    // Formulations with linked model params, at the top level and nested in a bmi_multi, and
+    // the example bmi_multi, whose model params are all given in the configuration
+    std::vector<std::pair<std::string, boost::property_tree::ptree>> formulations;
+
+    for (const std::string& example : { EXAMPLE_5_a, EXAMPLE_5_b }) {
+        std::stringstream stream;
+        stream << example;
+        boost::property_tree::ptree tree;
+        boost::property_tree::json_parser::read_json(stream, tree);
+
+        for (const auto& formulation : tree.get_child("global.formulations")) {
+            formulations.emplace_back("global", formulation.second);
+        }
+        if (tree.get_child_optional("catchments")) {
+            for (const auto& catchment : tree.get_child("catchments")) {
+                for (const auto& formulation : catchment.second.get_child("formulations")) {
+                    formulations.emplace_back(catchment.first, formulation.second);
+                }
+            }
+        }
+    }
+
+    std::vector<std::string> example_paths;
+    for (const auto& path : path_options) {
+        example_paths.push_back(path + "data/example_bmi_multi_realization_config.json");
+    }
+    const std::string example_path = utils::FileChecker::find_first_readable(example_paths);
+    ASSERT_FALSE(example_path.empty());
+    boost::property_tree::ptree example_tree;
+    boost::property_tree::json_parser::read_json(example_path, example_tree);
+    for (const auto& formulation : example_tree.get_child("global.formulations")) {
+        formulations.emplace_back("example", formulation.second);
+    }
+    ASSERT_EQ(formulations.size(), 5);
+
+    // Every attribute the linked params name, and one they do not
+    const geojson::PropertyMap properties{
+        { "MODEL_VAR_2", geojson::JSONProperty{"MODEL_VAR_2", 10 } },
+        { "pi",          geojson::JSONProperty{"pi",          3.14159 } },
+        { "n",           geojson::JSONProperty{"n",           1.70352 } },
+        { "e",           geojson::JSONProperty{"e",           2.71828 } },
+        { "val",         geojson::JSONProperty{"val",         7.41722 } },
+        { "areasqkm",    geojson::JSONProperty{"areasqkm",    42.0 } }
+    };
+    this->add_feature("cat-67", properties);
+    this->add_feature("cat-27");
+    std::vector<geojson::Feature> features = { this->fabric->get_feature("cat-67"), this->fabric->get_feature("cat-27") };
+
+    for (const auto& entry : formulations) {
+        const realization::config::Formulation formulation(entry.second);
+        const realization::config::FormulationTemplate formulation_template(formulation);
+
+        for (const auto& feature : features) {
+            const std::string name = entry.first + " " + formulation.type + " for " + feature->get_id();
+
+            realization::config::Formulation reference = formulation;
+            reference_link_external(reference, feature);
+
+            realization::config::Formulation linked = formulation;
+            linked.link_external(feature);
+
+            expect_same_parameters(formulation_template.instantiate(feature), reference.parameters, name + " (template)");
+            expect_same_parameters(linked.parameters, reference.parameters, name + " (link_external)");
+            ASSERT_EQ(linked.nested.size(), reference.nested.size());
+            for (std::size_t i = 0; i < reference.nested.size(); i++) {
+                expect_same_parameters(linked.nested[i].parameters, reference.nested[i].parameters, name + " (nested " + std::to_string(i) + ")");
+            }
+        }
+    }
+
+    // The linked values are those of the feature, and the others are left as configured
+    realization::config::Formulation global_a(formulations[0].second);
+    const auto params = realization::config::FormulationTemplate(global_a).instantiate(features[0]).at("model_params");
+    EXPECT_EQ(params.at("MODEL_VAR_1").as_real_number(), 3.14159);
+    EXPECT_EQ(params.at("MODEL_VAR_2").as_natural_number(), 10);
+
+    const auto unlinked = realization::config::FormulationTemplate(global_a).instantiate(features[1]).at("model_params");
+    EXPECT_EQ(unlinked.at("MODEL_VAR_2").get_type(), geojson::PropertyType::Object);
+}
@@ -70,6 +70,16 @@ protected:
         return nested_formulation.get_bmi_model();
     }
 
+    static std::vector<std::string> get_friend_nested_direct_input_names(const Bmi_Multi_Formulation& formulation,
+                                                                          const int mod_index) {
+        std::shared_ptr<Bmi_Module_Formulation> nested = std::static_pointer_cast<Bmi_Module_Formulation>(formulation.modules[mod_index]);
+        std::vector<std::string> names;
+        for (const auto &direct : nested->direct_inputs) {
+            names.push_back(direct.first);
+        }
+        return names;
+    }
+
     static time_t get_friend_bmi_model_start_time_forcing_offset_s(Bmi_Multi_Formulation& formulation) {
         return formulation.get_bmi_model_start_time_forcing_offset_s();
     }
@@ -367,6 +377,18 @@ TEST_F(Bmi_Cpp_Multi_Array_Test, Pass_Bmi_Array_0) {
     ASSERT_EQ(data,  expected);
 }
 
+/** Test to ensure inputs provided by a prior nested module are bound directly to its outputs */
+TEST_F(Bmi_Cpp_Multi_Array_Test, Direct_Inputs_0) {
+    int ex_index = 0;
+
+    Bmi_Multi_Formulation formulation(catchment_ids[ex_index], std::make_unique<CsvPerFeatureForcingProvider>(*forcing_params_examples[ex_index]), utils::StreamHandler());
+    formulation.create_formulation(config_prop_ptree[ex_index]);
+
+    std::vector<std::string> expected = {"INPUT_VAR_1", "INPUT_VAR_3"};
+    ASSERT_TRUE(get_friend_nested_direct_input_names(formulation, 0).empty());
+    ASSERT_EQ(get_friend_nested_direct_input_names(formulation, 1), expected);
+}
+
 /**
  * Simple test of output for example 0.
  */
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FilePatternIndex.hpp"
+
+class FilePatternIndex_Test : public ::testing::Test {
+
+    protected:
+
+    void SetUp() override {
+        char directory_template[] = "/tmp/ngen_file_pattern_XXXXXX";
+        ASSERT_NE(mkdtemp(directory_template), nullptr);
+        directory = std::string(directory_template) + "/";
+
+        for (const std::string& name : files) {
+            std::ofstream(directory + name) << "time,APCP_surface\n";
+        }
+        ASSERT_EQ(mkdir((directory + "forcing_cat-9_2015.csv").c_str(), 0755), 0);
+    }
+
+    void TearDown() override {
+        for (const std::string& name : files) {
+            std::remove((directory + name).c_str());
+        }
+        rmdir((directory + "forcing_cat-9_2015.csv").c_str());
+        rmdir(directory.c_str());
+    }
+
+    std::string directory;
+
+    const std::vector<std::string> files = {
+        "forcing_cat-1_2015.csv",
+        "forcing_cat-10_2015.csv",
+        "forcing_cat-2_extra_2015.csv",
+        "forcing_cat-3_2015.nc",
+        "old_forcing_cat-4_2015.csv",
+        "forcing_cat-5_2015.csv",
+        "forcing_cat-5_2016.csv"
+    };
+
+};
+
+TEST_F(FilePatternIndex_Test, TestFind)
+{
+    utils::FilePatternIndex index(directory, ".*_{{id}}_2015\\.csv");
+
+    // Ids without a file before the first that has one do not change how the rest are found
+    ASSERT_EQ(index.find("cat-3"), "");
+    ASSERT_EQ(index.find("cat-1"), directory + "forcing_cat-1_2015.csv");
+    ASSERT_EQ(index.find("cat-10"), directory + "forcing_cat-10_2015.csv");
+    ASSERT_EQ(index.find("cat-5"), directory + "forcing_cat-5_2015.csv");
+    ASSERT_EQ(index.find("cat-4"), directory + "old_forcing_cat-4_2015.csv");
+
+    // The id must match in full, and directories are not forcing files
+    ASSERT_EQ(index.find("cat-2"), "");
+    ASSERT_EQ(index.find("cat-3"), "");
+    ASSERT_EQ(index.find("cat"), "");
+    ASSERT_EQ(index.find("cat-9"), "");
+}
+
+TEST_F(FilePatternIndex_Test, TestFindWithGroups)
+{
+    // Groups before the placeholder, and one around it
+    utils::FilePatternIndex index(directory, "(old_)?forcing_({{id}})_(2015|2016)\\.csv");
+
+    ASSERT_EQ(index.find("cat-1"), directory + "forcing_cat-1_2015.csv");
+    ASSERT_EQ(index.find("cat-4"), directory + "old_forcing_cat-4_2015.csv");
+    ASSERT_EQ(index.find("cat-2"), "");
+}
+
+TEST_F(FilePatternIndex_Test, TestFindUnanchoredId)
+{
+    // The captured id of each name need not be the one looked up
+    utils::FilePatternIndex index(directory, ".*{{id}}.*\\.csv");
+
+    ASSERT_EQ(index.find("cat-10"), directory + "forcing_cat-10_2015.csv");
+    ASSERT_EQ(index.find("cat-2"), directory + "forcing_cat-2_extra_2015.csv");
+    ASSERT_EQ(index.find("cat-4"), directory + "old_forcing_cat-4_2015.csv");
+    ASSERT_EQ(index.find("cat-3"), "");
+}
+
+TEST_F(FilePatternIndex_Test, TestFindFromThreads)
+{
+    utils::FilePatternIndex index(directory, ".*_{{id}}_2015\\.csv");
+
+    std::vector<std::string> found(8);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < found.size(); t++) {
+        threads.emplace_back([&index, &found, t]() {
+            found[t] = index.find(t % 2 == 0 ? "cat-1" : "cat-4");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (std::size_t t = 0; t < found.size(); t++) {
+        ASSERT_EQ(found[t], directory + (t % 2 == 0 ? "forcing_cat-1_2015.csv" : "old_forcing_cat-4_2015.csv"));
+    }
+}
+
+TEST_F(FilePatternIndex_Test, TestFindWithoutId)
+{
+    utils::FilePatternIndex index(directory, "forcing_cat-10_.*");
+
+    ASSERT_EQ(index.find("cat-1"), directory + "forcing_cat-10_2015.csv");
+    ASSERT_EQ(index.find("cat-2"), directory + "forcing_cat-10_2015.csv");
+}
+
+TEST_F(FilePatternIndex_Test, TestMissingDirectory)
+{
+    ASSERT_THROW(utils::FilePatternIndex(directory + "missing/", "{{id}}.csv"), std::runtime_error);
+}
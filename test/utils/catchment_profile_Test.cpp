@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "catchment_profile.hpp"
+
+using ngen::profiling::catchment_profile;
+
+TEST(catchment_profile_Test, TestColumns)
+{
+    catchment_profile profile;
+
+    ASSERT_EQ(profile.column("response"), std::size_t(catchment_profile::response));
+    ASSERT_EQ(profile.column("set_inputs"), std::size_t(catchment_profile::set_inputs));
+    ASSERT_EQ(profile.column("write_output"), std::size_t(catchment_profile::write_output));
+
+    const std::size_t cfe = profile.column("CFE");
+    ASSERT_EQ(cfe, 3);
+    ASSERT_EQ(profile.column("CFE"), cfe);
+    ASSERT_EQ(profile.column("PET"), 4);
+}
+
+TEST(catchment_profile_Test, TestRows)
+{
+    catchment_profile profile;
+
+    const std::size_t first = profile.row("cat-1");
+    const std::size_t second = profile.row("cat-2");
+    ASSERT_NE(first, second);
+    ASSERT_EQ(profile.row("cat-1"), first);
+
+    // Recording by row is the same as recording by catchment
+    profile.record(first, catchment_profile::response, 100);
+    profile.record("cat-1", catchment_profile::response, 50);
+
+    std::ostringstream out;
+    profile.write_csv(out);
+    ASSERT_NE(out.str().find("cat-1,"), std::string::npos);
+    ASSERT_NE(out.str().find(",2,"), std::string::npos);
+}
+
+TEST(catchment_profile_Test, TestWriteCsv)
+{
+    catchment_profile profile;
+    ASSERT_TRUE(profile.empty());
+
+    profile.record("cat-1", catchment_profile::response, 100);
+    profile.record("cat-1", catchment_profile::response, 50);
+    profile.record("cat-2", catchment_profile::write_output, 10);
+    profile.record("cat-1", profile.column("CFE"), 20);
+    ASSERT_FALSE(profile.empty());
+
+    std::ostringstream out;
+    profile.write_csv(out);
+
+    std::istringstream lines(out.str());
+    std::string header, first, second, end;
+    std::getline(lines, header);
+    std::getline(lines, first);
+    std::getline(lines, second);
+    ASSERT_FALSE(std::getline(lines, end));
+
+    ASSERT_EQ(header, "catchment,response_seconds,response_calls,set_inputs_seconds,set_inputs_calls,"
+                      "write_output_seconds,write_output_calls,CFE_seconds,CFE_calls");
+    // Catchments keep the order they were first recorded in, and unrecorded sections are zero
+    ASSERT_EQ(first.substr(0, first.find(',')), "cat-1");
+    ASSERT_EQ(std::count(first.begin(), first.end(), ','), 8);
+    ASSERT_NE(first.find(",2,0,0,0,0,"), std::string::npos);
+    ASSERT_EQ(second.substr(0, second.find(',')), "cat-2");
+    ASSERT_NE(second.find(",0,0,0,0,"), std::string::npos);
+    ASSERT_EQ(second.substr(second.size() - 4), ",0,0");
+}
+
+TEST(catchment_profile_Test, TestSummarize)
+{
+    catchment_profile profile;
+    for (int i = 1; i <= 5; i++) {
+        profile.record("cat-" + std::to_string(i), catchment_profile::response, i * 1000);
+    }
+
+    std::ostringstream out;
+    profile.summarize(out, 2);
+    const std::string summary = out.str();
+
+    ASSERT_NE(summary.find("(5 catchments)"), std::string::npos);
+    // Only the slowest two are listed, slowest first
+    ASSERT_LT(summary.find("cat-5:"), summary.find("cat-4:"));
+    ASSERT_EQ(summary.find("cat-3:"), std::string::npos);
+    ASSERT_NE(summary.find("(33.3%)"), std::string::npos);
+}
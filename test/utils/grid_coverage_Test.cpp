@@ -0,0 +1,190 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+
+#include "grid_coverage.hpp"
+
+namespace {
+
+using point_t        = boost::geometry::model::d2::point_xy<double>;
+using polygon_t      = boost::geometry::model::polygon<point_t>;
+using multipolygon_t = boost::geometry::model::multi_polygon<polygon_t>;
+using box_t          = boost::geometry::model::box<point_t>;
+
+using coverage_map = std::map<std::pair<std::size_t, std::size_t>, double>;
+
+coverage_map compute(const ngen::coverage_grid& grid, const multipolygon_t& shape)
+{
+    ngen::grid_coverage coverage{grid};
+    coverage.add_multipolygon(shape);
+
+    std::vector<ngen::cell_coverage> cells;
+    coverage.compute(cells);
+
+    coverage_map result;
+    for (const auto& cell : cells) {
+        result[{ cell.column, cell.row }] = cell.fraction;
+    }
+    return result;
+}
+
+//! Coverage found by intersecting the shape with every cell of the grid
+coverage_map brute_force(const ngen::coverage_grid& grid, const multipolygon_t& shape)
+{
+    coverage_map result;
+    multipolygon_t overlap;
+    for (std::size_t row = 0; row < grid.rows; row++) {
+        for (std::size_t col = 0; col < grid.columns; col++) {
+            const box_t cell{
+                { grid.xmin + col * grid.dx, grid.ymin + row * grid.dy },
+                { grid.xmin + (col + 1) * grid.dx, grid.ymin + (row + 1) * grid.dy }
+            };
+            overlap.clear();
+            boost::geometry::intersection(cell, shape, overlap);
+            const double fraction = boost::geometry::area(overlap) / (grid.dx * grid.dy);
+            if (fraction > 1e-9) {
+                result[{ col, row }] = fraction;
+            }
+        }
+    }
+    return result;
+}
+
+void expect_same_coverage(const coverage_map& actual, const coverage_map& expected)
+{
+    for (const auto& cell : expected) {
+        const auto found = actual.find(cell.first);
+        ASSERT_NE(found, actual.end()) << "cell (" << cell.first.first << ", " << cell.first.second << ") missing";
+        EXPECT_NEAR(found->second, cell.second, 1e-9)
+            << "cell (" << cell.first.first << ", " << cell.first.second << ")";
+    }
+    for (const auto& cell : actual) {
+        if (expected.count(cell.first) == 0) {
+            EXPECT_LT(cell.second, 1e-9)
+                << "cell (" << cell.first.first << ", " << cell.first.second << ") not covered";
+        }
+    }
+}
+
+//! A star-shaped ring of random radii around a center, wound clockwise
+polygon_t::ring_type random_ring(std::mt19937& gen, point_t center, double radius, std::size_t vertices)
+{
+    std::uniform_real_distribution<double> scale(0.3, 1.0);
+    polygon_t::ring_type ring;
+    for (std::size_t i = 0; i < vertices; i++) {
+        const double angle = -2 * M_PI * i / vertices;
+        const double r = radius * scale(gen);
+        ring.push_back({ center.x() + r * std::cos(angle), center.y() + r * std::sin(angle) });
+    }
+    ring.push_back(ring.front());
+    return ring;
+}
+
+const ngen::coverage_grid unit_grid{ 0, 0, 1, 1, 10, 10 };
+
+} // namespace
+
+TEST(grid_coverage_Test, TestAlignedSquare)
+{
+    multipolygon_t shape;
+    boost::geometry::read_wkt("MULTIPOLYGON(((2 2,2 5,5 5,5 2,2 2)))", shape);
+
+    const auto cells = compute(unit_grid, shape);
+    ASSERT_EQ(cells.size(), 9);
+    for (const auto& cell : cells) {
+        EXPECT_GE(cell.first.first, 2);
+        EXPECT_LE(cell.first.first, 4);
+        EXPECT_GE(cell.first.second, 2);
+        EXPECT_LE(cell.first.second, 4);
+        EXPECT_DOUBLE_EQ(cell.second, 1.0);
+    }
+}
+
+TEST(grid_coverage_Test, TestWindingAndOpenRings)
+{
+    // Counter-clockwise and left open
+    polygon_t triangle;
+    triangle.outer() = { { 0, 0 }, { 2, 0 }, { 0, 2 } };
+
+    ngen::grid_coverage coverage{unit_grid};
+    coverage.add_polygon(triangle);
+
+    std::vector<ngen::cell_coverage> cells;
+    coverage.compute(cells);
+
+    // Ordered by row, then column
+    ASSERT_EQ(cells.size(), 3);
+    EXPECT_EQ(cells[0].column, 0);
+    EXPECT_EQ(cells[0].row, 0);
+    EXPECT_DOUBLE_EQ(cells[0].fraction, 1.0);
+    EXPECT_EQ(cells[1].column, 1);
+    EXPECT_EQ(cells[1].row, 0);
+    EXPECT_DOUBLE_EQ(cells[1].fraction, 0.5);
+    EXPECT_EQ(cells[2].column, 0);
+    EXPECT_EQ(cells[2].row, 1);
+    EXPECT_DOUBLE_EQ(cells[2].fraction, 0.5);
+
+    // Nothing is left over for the next call
+    coverage.compute(cells);
+    EXPECT_TRUE(cells.empty());
+}
+
+TEST(grid_coverage_Test, TestHolesAndGridEdges)
+{
+    // A grid of 0.5 by 0.25 cells, offset from the origin
+    const ngen::coverage_grid grid{ 10, 20, 0.5, 0.25, 4, 8 };
+
+    multipolygon_t shape;
+    boost::geometry::read_wkt(
+        "MULTIPOLYGON(((9 19,9 21,11 21,11 19,9 19),(10.1 20.1,10.7 20.1,10.7 20.6,10.1 20.6,10.1 20.1)),"
+        "((11.3 21.4,11.3 23,13 23,13 21.4,11.3 21.4)))",
+        shape
+    );
+    boost::geometry::correct(shape);
+
+    expect_same_coverage(compute(grid, shape), brute_force(grid, shape));
+}
+
+TEST(grid_coverage_Test, TestRandomPolygons)
+{
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<double> position(-2.0, 12.0);
+    std::uniform_real_distribution<double> size(0.5, 6.0);
+    std::uniform_int_distribution<std::size_t> vertices(3, 40);
+
+    const ngen::coverage_grid grid{ -0.3, 0.7, 0.8, 0.6, 14, 16 };
+
+    for (int trial = 0; trial < 50; trial++) {
+        multipolygon_t shape;
+        for (int part = 0; part < 2; part++) {
+            const point_t center{ position(gen), position(gen) };
+            const double radius = size(gen);
+
+            polygon_t polygon;
+            polygon.outer() = random_ring(gen, center, radius, vertices(gen));
+
+            // A hole well within the smallest radius of the outer ring
+            if (trial % 2 == 0) {
+                auto hole = random_ring(gen, center, radius * 0.1, vertices(gen));
+                std::reverse(hole.begin(), hole.end());
+                polygon.inners().push_back(std::move(hole));
+            }
+
+            // Keep the parts apart, so that none of the grid is covered twice
+            if (part == 0 || !boost::geometry::intersects(polygon, shape)) {
+                shape.push_back(std::move(polygon));
+            }
+        }
+
+        ASSERT_TRUE(boost::geometry::is_valid(shape)) << "trial " << trial;
+        expect_same_coverage(compute(grid, shape), brute_force(grid, shape));
+    }
+}
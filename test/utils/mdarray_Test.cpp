@@ -2,6 +2,9 @@
 #include <initializer_list>
 #include "mdarray.hpp"
 
+#include <numeric>
+#include <vector>
+
 TEST(mdarray_Test, construction)
 {
     // Horrible workaround for GCC8 not quite getting initializer list stuff right
@@ -103,3 +106,202 @@ TEST(mdarray_Test, layout)
         c.index(index1)
     );
 }
+
+TEST(mdarray_Test, views)
+{
+    ngen::mdarray<int> a{{3, 4}};
+    std::iota(a.data().begin(), a.data().end(), 0);
+
+    const auto view = a.view();
+    ASSERT_EQ(view.rank(), 2);
+    EXPECT_EQ(view.size(), 12);
+    EXPECT_TRUE(view.contiguous());
+    EXPECT_EQ(view.strides()[0], 1);
+    EXPECT_EQ(view.strides()[1], 3);
+
+    for (std::size_t i = 0; i < 3; i++) {
+        for (std::size_t j = 0; j < 4; j++) {
+            const std::size_t idx[] = {i, j};
+            EXPECT_EQ(view.at(idx), a.at(idx));
+        }
+    }
+
+    // Fixing the second dimension leaves contiguous values
+    const auto column = view.slice(1, 2);
+    ASSERT_EQ(column.rank(), 1);
+    EXPECT_EQ(column.shape()[0], 3);
+    EXPECT_TRUE(column.contiguous());
+    for (std::size_t i = 0; i < 3; i++) {
+        const std::size_t idx[] = {i};
+        EXPECT_EQ(column.at(idx), 6 + i);
+    }
+
+    // Fixing the first dimension strides across them
+    const auto across = view.slice(0, 1);
+    ASSERT_EQ(across.rank(), 1);
+    EXPECT_EQ(across.shape()[0], 4);
+    EXPECT_FALSE(across.contiguous());
+    for (std::size_t j = 0; j < 4; j++) {
+        const std::size_t idx[] = {j};
+        EXPECT_EQ(across.at(idx), 1 + 3 * j);
+    }
+
+    // Views share their values with the mdarray
+    const std::size_t first[] = {0};
+    across.at(first) = 100;
+    const std::size_t origin[] = {1, 0};
+    EXPECT_EQ(a.at(origin), 100);
+
+    // Ranges keep the rank
+    const auto range = view.slice(1, 1, 2);
+    ASSERT_EQ(range.rank(), 2);
+    EXPECT_EQ(range.shape()[0], 3);
+    EXPECT_EQ(range.shape()[1], 2);
+    EXPECT_TRUE(range.contiguous());
+    const std::size_t last[] = {2, 1};
+    EXPECT_EQ(range.at(last), 8);
+    EXPECT_FALSE(view.slice(0, 1, 2).contiguous());
+
+    EXPECT_THROW(view.slice(2, 0), std::out_of_range);
+    EXPECT_THROW(view.slice(0, 3), std::out_of_range);
+    EXPECT_THROW(view.slice(1, 3, 2), std::out_of_range);
+    const std::size_t outside[] = {0, 4};
+    EXPECT_THROW(view.at(outside), std::out_of_range);
+
+    // A read-only view of a mutable one
+    const ngen::mdarray_view<const int> read_only = column;
+    const std::size_t second[] = {1};
+    EXPECT_EQ(read_only[second], 7);
+}
+
+TEST(mdarray_Test, view_rows)
+{
+    ngen::mdarray<double> a{{3, 2, 2}};
+    std::iota(a.data().begin(), a.data().end(), 0.0);
+
+    const std::size_t at[] = {1, 1};
+    const boost::span<double> row = a.view().row(at);
+    ASSERT_EQ(row.size(), 3);
+    for (std::size_t i = 0; i < 3; i++) {
+        const std::size_t idx[] = {i, 1, 1};
+        EXPECT_EQ(&row[i], &a.at(idx));
+    }
+
+    // A slice whose first dimension is not contiguous has no rows
+    const std::size_t inner[] = {0};
+    EXPECT_THROW(a.view().slice(0, 0).row(inner), std::logic_error);
+    EXPECT_THROW(a.view().row(inner), std::out_of_range);
+
+    const std::size_t after[] = {2, 0};
+    EXPECT_THROW(a.view().row(after), std::out_of_range);
+}
+
+TEST(mdarray_Test, view_iteration)
+{
+    ngen::mdarray<int> a{{3, 4}};
+    std::iota(a.data().begin(), a.data().end(), 0);
+
+    const auto across = a.view().slice(0, 2);
+    std::vector<int> values(across.begin(), across.end());
+    EXPECT_EQ(values, (std::vector<int>{2, 5, 8, 11}));
+
+    // The indices of a strided view follow the same order as its values
+    const auto range = a.view().slice(0, 1, 2);
+    std::size_t count = 0;
+    std::size_t idx[2];
+    for (auto it = range.begin(); it != range.end(); ++it, count++) {
+        it.mdindex(idx);
+        EXPECT_EQ(*it, range[idx]);
+    }
+    EXPECT_EQ(count, range.size());
+}
+
+TEST(mdarray_Test, bulk_operations)
+{
+    ngen::mdarray<double> x{{3, 4}};
+    ngen::mdarray<double> y{{3, 4}};
+    std::iota(x.data().begin(), x.data().end(), 0.0);
+
+    ngen::fill(y.view(), 1.0);
+    for (double value : y.data())
+        EXPECT_EQ(value, 1.0);
+
+    // y = 2x + 1
+    ngen::axpy(2.0, x.view(), y.view());
+    for (std::size_t i = 0; i < y.size(); i++)
+        EXPECT_EQ(y.data()[i], 2.0 * i + 1.0);
+
+    // Strided operations only touch the values in the view
+    ngen::fill(y.view().slice(0, 0), 0.0);
+    ngen::scale_offset(y.view().slice(0, 1), 10.0, 5.0);
+    for (std::size_t j = 0; j < 4; j++) {
+        const std::size_t first[] = {0, j};
+        const std::size_t second[] = {1, j};
+        const std::size_t third[] = {2, j};
+        EXPECT_EQ(y.at(first), 0.0);
+        EXPECT_EQ(y.at(second), (2.0 * (1 + 3 * j) + 1.0) * 10.0 + 5.0);
+        EXPECT_EQ(y.at(third), 2.0 * (2 + 3 * j) + 1.0);
+    }
+
+    ngen::mdarray<double> z{{3, 4}};
+    ngen::axpy(-1.0, x.view().slice(1, 0), z.view().slice(1, 3));
+    const std::size_t corner[] = {2, 3};
+    EXPECT_EQ(z.at(corner), -2.0);
+
+    EXPECT_THROW(ngen::axpy(1.0, x.view().slice(0, 0), z.view().slice(1, 0)), std::invalid_argument);
+}
+
+TEST(mdarray_Test, reductions)
+{
+    ngen::mdarray<double> x{{3, 4}};
+    std::iota(x.data().begin(), x.data().end(), 0.0);
+
+    EXPECT_EQ(ngen::sum(x.view()), 66.0);
+    EXPECT_EQ(ngen::mean(x.view()), 5.5);
+    EXPECT_EQ(ngen::sum(x.view().slice(0, 1)), 1.0 + 4.0 + 7.0 + 10.0);
+
+    // Over the first dimension: one total per value of the second
+    const ngen::mdarray<double> by_column = ngen::sum(x.view(), 0);
+    ASSERT_EQ(by_column.rank(), 1);
+    ASSERT_EQ(by_column.size(), 4);
+    for (std::size_t j = 0; j < 4; j++) {
+        const std::size_t idx[] = {j};
+        EXPECT_EQ(by_column.at(idx), 9.0 * j + 3.0);
+    }
+
+    // Over the second dimension: one total per value of the first
+    const ngen::mdarray<double> by_row = ngen::mean(x.view(), 1);
+    ASSERT_EQ(by_row.size(), 3);
+    for (std::size_t i = 0; i < 3; i++) {
+        const std::size_t idx[] = {i};
+        EXPECT_EQ(by_row.at(idx), i + 4.5);
+    }
+
+    // Reducing a rank 1 view along its dimension leaves a single value
+    const ngen::mdarray<double> total = ngen::sum(x.view().slice(1, 2), 0);
+    ASSERT_EQ(total.rank(), 0);
+    EXPECT_EQ(total.data()[0], 6.0 + 7.0 + 8.0);
+
+    // Reductions over a strided rank 3 view match summing each value
+    ngen::mdarray<int> cube{{4, 5, 6}};
+    std::iota(cube.data().begin(), cube.data().end(), 0);
+    const auto part = cube.view().slice(1, 1, 3);
+    for (std::size_t d = 0; d < 3; d++) {
+        const ngen::mdarray<int> totals = ngen::sum(part, d);
+        std::vector<int> expected(totals.size(), 0);
+        std::size_t idx[3], reduced[2];
+        for (auto it = part.begin(); it != part.end(); ++it) {
+            it.mdindex(idx);
+            for (std::size_t k = 0, r = 0; k < 3; k++) {
+                if (k != d)
+                    reduced[r++] = idx[k];
+            }
+            expected[totals.index(reduced)] += *it;
+        }
+        EXPECT_EQ(std::vector<int>(totals.data().begin(), totals.data().end()), expected);
+    }
+
+    ngen::mdarray<double> empty{{0, 3}};
+    EXPECT_EQ(ngen::sum(empty.view()), 0.0);
+    EXPECT_THROW(ngen::sum(x.view(), 2), std::out_of_range);
+}
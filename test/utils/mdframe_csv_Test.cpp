@@ -1,6 +1,10 @@
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
 
 #include "mdframe.hpp"
 
@@ -112,3 +116,78 @@ TEST_F(mdframe_csv_Test, io_csv)
     csv.close();
     ASSERT_EQ(buffer.str(), "v,y,x\n1.000000,1,1\n2.000000,1,2\n2.000000,2,1\n4.000000,2,2\n");
 }
+
+/**
+ * Values must be written exactly as std::to_string writes them,
+ * including those close to a rounding boundary, and extremes.
+ */
+TEST_F(mdframe_csv_Test, io_csv_value_formatting)
+{
+    std::vector<double> reals {
+        0.0, -0.0, 1.0, -1.0, 0.5, 0.1, -0.1, 1e-7, -1e-7, 4e-7, 5e-7, 6e-7,
+        0.0000005, 0.0000015, 1.0000005, 2.5e-6, 0.9999995, 0.99999949999, 9.9999999,
+        123456.789012345, -98765.4321, 3.14159265358979, 1e15, 9007199254740991.0,
+        9007199254740993.0, 1e20, -1e300, 1.7976931348623157e308, 4.9e-324,
+        std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()
+    };
+    std::vector<int> integers {
+        0, 1, -1, 9, 10, -10, 123456, std::numeric_limits<int>::max(), std::numeric_limits<int>::min()
+    };
+
+    // Add pseudo-random values of varied magnitude
+    std::mt19937_64 generator{42};
+    std::uniform_real_distribution<double> mantissa{-10.0, 10.0};
+    std::uniform_int_distribution<int> exponent{-8, 12};
+    std::uniform_int_distribution<int> any_int{std::numeric_limits<int>::min(), std::numeric_limits<int>::max()};
+    for (int i = 0; i < 10000; i++) {
+        reals.push_back(mantissa(generator) * std::pow(10.0, exponent(generator)));
+    }
+    while (integers.size() < reals.size()) {
+        integers.push_back(any_int(generator));
+    }
+
+    ngen::mdframe df;
+    df.add_dimension("x", reals.size());
+    df.add_variable<double>("real", { "x" })
+      .add_variable<int>("integer", { "x" });
+    for (size_t i = 0; i < reals.size(); i++) {
+        df["real"].insert({{ i }}, reals[i]);
+        df["integer"].insert({{ i }}, integers[i]);
+    }
+
+    df.to_csv(this->path);
+
+    std::ifstream csv{this->path};
+    ASSERT_TRUE(csv.is_open()) << "failed to open " << this->path;
+
+    std::string line;
+    ASSERT_TRUE(std::getline(csv, line));
+    const bool real_first = line == "real,integer";
+    ASSERT_TRUE(real_first || line == "integer,real") << line;
+
+    for (size_t i = 0; i < reals.size(); i++) {
+        ASSERT_TRUE(std::getline(csv, line)) << "missing row " << i;
+        const std::string expected = real_first
+            ? std::to_string(reals[i]) + "," + std::to_string(integers[i])
+            : std::to_string(integers[i]) + "," + std::to_string(reals[i]);
+        ASSERT_EQ(line, expected) << "row " << i;
+    }
+    EXPECT_FALSE(std::getline(csv, line));
+}
+
+/**
+ * A frame with an empty dimension has a header but no rows.
+ */
+TEST_F(mdframe_csv_Test, io_csv_empty_dimension)
+{
+    ngen::mdframe df;
+    df.add_dimension("x", 0);
+    df.add_variable<int>("v", { "x" });
+
+    df.to_csv(this->path);
+
+    std::ifstream csv{this->path};
+    std::stringstream buffer;
+    buffer << csv.rdbuf();
+    EXPECT_EQ(buffer.str(), "v\n");
+}
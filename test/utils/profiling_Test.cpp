@@ -0,0 +1,81 @@
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+
+#include "profiling.hpp"
+
+namespace {
+
+const ngen::profiling::timer* find_child(const ngen::profiling::timer& parent, const std::string& name)
+{
+    for (const auto* child : parent.children()) {
+        if (child->name() == name) {
+            return child;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(profiling_Test, TestNesting)
+{
+    {
+        ngen::profiling::scoped_timer outer("profiling_Test.nesting");
+        for (int i = 0; i < 3; i++) {
+            ngen::profiling::scoped_timer inner("inner");
+        }
+        ngen::profiling::scoped_timer stopped("stopped");
+        stopped.stop();
+        ngen::profiling::scoped_timer sibling("sibling");
+    }
+
+    const auto* outer = find_child(ngen::profiling::root(), "profiling_Test.nesting");
+    ASSERT_NE(outer, nullptr);
+    ASSERT_EQ(outer->calls(), 1);
+
+    const auto* inner = find_child(*outer, "inner");
+    ASSERT_NE(inner, nullptr);
+    ASSERT_EQ(inner->calls(), 3);
+    ASSERT_LE(inner->seconds(), outer->seconds());
+
+    // A stopped timer is no longer the parent of the timers after it
+    ASSERT_NE(find_child(*outer, "sibling"), nullptr);
+    ASSERT_EQ(find_child(*find_child(*outer, "stopped"), "sibling"), nullptr);
+
+    ASSERT_EQ(&ngen::profiling::current(), &ngen::profiling::root());
+}
+
+TEST(profiling_Test, TestAdoptedScope)
+{
+    {
+        ngen::profiling::scoped_timer outer("profiling_Test.adopted");
+        ngen::profiling::timer& parent = ngen::profiling::current();
+        std::thread worker([&parent]() {
+            ngen::profiling::adopted_scope scope(parent);
+            ngen::profiling::scoped_timer task("task");
+        });
+        worker.join();
+    }
+
+    const auto* outer = find_child(ngen::profiling::root(), "profiling_Test.adopted");
+    ASSERT_NE(outer, nullptr);
+    const auto* task = find_child(*outer, "task");
+    ASSERT_NE(task, nullptr);
+    ASSERT_EQ(task->calls(), 1);
+}
+
+TEST(profiling_Test, TestReport)
+{
+    {
+        ngen::profiling::scoped_timer outer("profiling_Test.report");
+        ngen::profiling::scoped_timer inner("profiling_Test.report.inner");
+    }
+
+    const std::string report = ngen::profiling::report();
+    ASSERT_NE(report.find("\"ranks\": 1"), std::string::npos);
+    ASSERT_NE(report.find("\"name\": \"profiling_Test.report\""), std::string::npos);
+    ASSERT_LT(report.find("\"name\": \"profiling_Test.report\""), report.find("\"name\": \"profiling_Test.report.inner\""));
+    ASSERT_NE(report.find("\"seconds\": { \"min\": "), std::string::npos);
+}
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "trace_recorder.hpp"
+
+TEST(trace_recorder_Test, TestRecordAndWrite)
+{
+    ngen::trace::recorder& trace = ngen::trace::recorder::instance();
+    ASSERT_FALSE(trace.recording());
+    ngen::trace::instant("test", "before_enable");
+
+    trace.enable(4, 2, 4);
+    ASSERT_FALSE(trace.recording());
+    ngen::trace::instant("test", "before_window");
+
+    trace.set_step(2);
+    ASSERT_TRUE(trace.recording());
+    {
+        ngen::trace::scoped_event span("test", "span", 7);
+        for (int i = 0; i < 5; i++) {
+            ngen::trace::instant("test", "instant", i);
+        }
+    }
+
+    trace.set_step(4);
+    ASSERT_FALSE(trace.recording());
+    ngen::trace::instant("test", "after_window");
+
+    char path_template[] = "/tmp/ngen_trace_XXXXXX";
+    const int fd = mkstemp(path_template);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    const std::string path = path_template;
+    ASSERT_TRUE(trace.write(path));
+
+    boost::property_tree::ptree written;
+    boost::property_tree::read_json(path, written);
+    std::remove(path.c_str());
+
+    // The process name, then only the last four of the six events in the window, oldest first
+    std::vector<std::string> names;
+    std::vector<std::string> values;
+    for (const auto& e : written.get_child("traceEvents")) {
+        names.push_back(e.second.get<std::string>("name"));
+        values.push_back(e.second.get<std::string>("args.value", e.second.get<std::string>("args.name", "")));
+    }
+    ASSERT_EQ(names, std::vector<std::string>({ "process_name", "instant", "instant", "instant", "span" }));
+    ASSERT_EQ(values, std::vector<std::string>({ "rank 0", "2", "3", "4", "7" }));
+
+    const auto& span = written.get_child("traceEvents").back().second;
+    ASSERT_EQ(span.get<std::string>("ph"), "X");
+    ASSERT_GE(span.get<double>("dur"), 0.0);
+}
+
+TEST(trace_recorder_Test, TestEnableResizesBuffers)
+{
+    ngen::trace::recorder& trace = ngen::trace::recorder::instance();
+
+    // This thread's buffer is made at the first event, with room for two
+    trace.enable(2);
+    trace.set_step(0);
+    for (int i = 0; i < 3; i++) {
+        ngen::trace::instant("test", "small", i);
+    }
+
+    // Enabling again sizes it to the new capacity and drops what it held
+    trace.enable(8);
+    for (int i = 0; i < 6; i++) {
+        ngen::trace::instant("test", "large", i);
+    }
+
+    char path_template[] = "/tmp/ngen_trace_XXXXXX";
+    const int fd = mkstemp(path_template);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    const std::string path = path_template;
+    ASSERT_TRUE(trace.write(path));
+
+    boost::property_tree::ptree written;
+    boost::property_tree::read_json(path, written);
+    std::remove(path.c_str());
+
+    std::vector<std::string> values;
+    for (const auto& e : written.get_child("traceEvents")) {
+        if (e.second.get<std::string>("name") != "process_name") {
+            ASSERT_EQ(e.second.get<std::string>("name"), "large");
+            values.push_back(e.second.get<std::string>("args.value"));
+        }
+    }
+    ASSERT_EQ(values, std::vector<std::string>({ "0", "1", "2", "3", "4", "5" }));
+}